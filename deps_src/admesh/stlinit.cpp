@@ -26,10 +26,17 @@
 #include <math.h>
 #include <assert.h>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
 #include <boost/predef/other/endian.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
 #include "stl.h"
 #include "libslic3r/Format/STL.hpp"
 
@@ -147,6 +154,76 @@ static FILE *stl_open_count_facets(stl_file *stl, const char *file, unsigned int
   	return fp;
 }
 
+// Binary facets are read in large blocks and decoded in parallel, reading a single facet per fread()
+// dominated loading of meshes with millions of facets.
+static bool stl_read_binary_facets(stl_file *stl, FILE *fp, uint32_t first_facet, bool &first, ImportstlProgressFn stlFn)
+{
+	static constexpr uint32_t facets_per_block = 65536;
+
+	struct BlockStats {
+		stl_vertex min { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		stl_vertex max { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		// Index of the first facet without NaN coordinates.
+		uint32_t   first_valid = std::numeric_limits<uint32_t>::max();
+	};
+
+	uint32_t          facets_num = stl->stats.number_of_facets;
+	uint32_t          unit       = facets_num / LOAD_STL_UNIT_NUM + 1;
+	std::vector<char> buffer(size_t(std::min(facets_num, facets_per_block)) * SIZEOF_STL_FACET);
+	for (uint32_t block_begin = first_facet; block_begin < facets_num; block_begin += facets_per_block) {
+		uint32_t block_end = std::min(facets_num, block_begin + facets_per_block);
+		for (uint32_t i = (block_begin + unit - 1) / unit * unit; i < block_end; i += unit) {
+			bool cb_cancel = false;
+			if (stlFn) {
+				stlFn(i, facets_num, cb_cancel, model_id, country_code);
+				if (cb_cancel)
+					return false;
+			}
+		}
+
+		size_t num_block_facets = block_end - block_begin;
+		if (fread(buffer.data(), SIZEOF_STL_FACET, num_block_facets, fp) != num_block_facets)
+			return false;
+
+		BlockStats block_stats = tbb::parallel_reduce(tbb::blocked_range<uint32_t>(block_begin, block_end), BlockStats{},
+			[stl, &buffer, block_begin](const tbb::blocked_range<uint32_t> &range, BlockStats stats) {
+				for (uint32_t i = range.begin(); i < range.end(); ++ i) {
+					// We assume little-endian architecture!
+					stl_facet facet;
+					memcpy(static_cast<void*>(&facet), buffer.data() + size_t(i - block_begin) * SIZEOF_STL_FACET, SIZEOF_STL_FACET);
+#if BOOST_ENDIAN_BIG_BYTE
+					// Convert the loaded little endian data to big endian.
+					stl_internal_reverse_quads((char*)&facet, 48);
+#endif /* BOOST_ENDIAN_BIG_BYTE */
+					// Write the facet into memory if none of facet vertices is NAN.
+					if (facet.vertex[0].hasNaN() || facet.vertex[1].hasNaN() || facet.vertex[2].hasNaN())
+						continue;
+					stl->facet_start[i] = facet;
+					stats.first_valid = std::min(stats.first_valid, i);
+					for (size_t j = 0; j < 3; ++ j) {
+						stats.min = stats.min.cwiseMin(facet.vertex[j]);
+						stats.max = stats.max.cwiseMax(facet.vertex[j]);
+					}
+				}
+				return stats;
+			},
+			[](BlockStats a, const BlockStats &b) {
+				a.min         = a.min.cwiseMin(b.min);
+				a.max         = a.max.cwiseMax(b.max);
+				a.first_valid = std::min(a.first_valid, b.first_valid);
+				return a;
+			});
+
+		if (block_stats.first_valid != std::numeric_limits<uint32_t>::max()) {
+			// Initializes the shortest edge from the first valid facet, as stl_facet_stats() does.
+			stl_facet_stats(stl, stl->facet_start[block_stats.first_valid], first);
+			stl->stats.min = stl->stats.min.cwiseMin(block_stats.min);
+			stl->stats.max = stl->stats.max.cwiseMax(block_stats.max);
+		}
+	}
+	return true;
+}
+
 /* Reads the contents of the file pointed to by fp into the stl structure,
    starting at facet first_facet.  The second argument says if it's our first
    time running this for the stl and therefore we should reset our max and min stats. */
@@ -195,6 +272,14 @@ static bool stl_read(stl_file *stl, FILE *fp, int first_facet, bool first, Impor
 	}
     	
 
+  	if (stl->stats.type == binary) {
+  		if (! stl_read_binary_facets(stl, fp, first_facet, first, stlFn))
+  			return false;
+  		stl->stats.size = stl->stats.max - stl->stats.min;
+  		stl->stats.bounding_diameter = stl->stats.size.norm();
+  		return true;
+  	}
+
   	char normal_buf[3][32];
 
 	uint32_t facets_num = stl->stats.number_of_facets;
@@ -211,59 +296,45 @@ static bool stl_read(stl_file *stl, FILE *fp, int first_facet, bool first, Impor
 
   	  	stl_facet facet;
 
-    	if (stl->stats.type == binary) {
-  
-
-      		// Read a single facet from a binary .STL file. We assume little-endian architecture!
-      		if (fread(&facet, 1, SIZEOF_STL_FACET, fp) != SIZEOF_STL_FACET)
-      			return false;
-
-
-#if BOOST_ENDIAN_BIG_BYTE
-      		// Convert the loaded little endian data to big endian.
-      		stl_internal_reverse_quads((char*)&facet, 48);
-#endif /* BOOST_ENDIAN_BIG_BYTE */
-    	} else {
-			// Read a single facet from an ASCII .STL file
-			// skip solid/endsolid
-			// (in this order, otherwise it won't work when they are paired in the middle of a file)
-            [[maybe_unused]] auto unused_result = fscanf(fp, " endsolid%*[^\n]\n");
-            unused_result = fscanf(fp, " solid%*[^\n]\n");  // name might contain spaces so %*s doesn't work and it also can be empty (just "solid")
-			// Leading space in the fscanf format skips all leading white spaces including numerous new lines and tabs.
-			int res_normal     = fscanf(fp, " facet normal %31s %31s %31s", normal_buf[0], normal_buf[1], normal_buf[2]);
-			assert(res_normal == 3);
-			int res_outer_loop = fscanf(fp, " outer loop");
-			assert(res_outer_loop == 0);
-			int res_vertex1    = fscanf(fp, " vertex %f %f %f", &facet.vertex[0](0), &facet.vertex[0](1), &facet.vertex[0](2));
-			assert(res_vertex1 == 3);
-			int res_vertex2    = fscanf(fp, " vertex %f %f %f", &facet.vertex[1](0), &facet.vertex[1](1), &facet.vertex[1](2));
-			assert(res_vertex2 == 3);
-			// Trailing whitespace is there to eat all whitespaces and empty lines up to the next non-whitespace.
-			int res_vertex3    = fscanf(fp, " vertex %f %f %f ", &facet.vertex[2](0), &facet.vertex[2](1), &facet.vertex[2](2));
-			assert(res_vertex3 == 3);
-			// Some G-code generators tend to produce text after "endloop" and "endfacet". Just ignore it.
-			char buf[2048];
-            [[maybe_unused]] auto unused_result2 = fgets(buf, 2047, fp);
-			bool endloop_ok = strncmp(buf, "endloop", 7) == 0 && (buf[7] == '\r' || buf[7] == '\n' || buf[7] == ' ' || buf[7] == '\t');
-			assert(endloop_ok);
-			// Skip the trailing whitespaces and empty lines.
-            unused_result = fscanf(fp, " ");
-            unused_result2 = fgets(buf, 2047, fp);
-			bool endfacet_ok = strncmp(buf, "endfacet", 8) == 0 && (buf[8] == '\r' || buf[8] == '\n' || buf[8] == ' ' || buf[8] == '\t');
-			assert(endfacet_ok);
-			if (res_normal != 3 || res_outer_loop != 0 || res_vertex1 != 3 || res_vertex2 != 3 || res_vertex3 != 3 || ! endloop_ok || ! endfacet_ok) {
-				BOOST_LOG_TRIVIAL(error) << "Something is syntactically very wrong with this ASCII STL! ";
-				return false;
-			}
+		// Read a single facet from an ASCII .STL file
+		// skip solid/endsolid
+		// (in this order, otherwise it won't work when they are paired in the middle of a file)
+		[[maybe_unused]] auto unused_result = fscanf(fp, " endsolid%*[^\n]\n");
+		unused_result = fscanf(fp, " solid%*[^\n]\n");  // name might contain spaces so %*s doesn't work and it also can be empty (just "solid")
+		// Leading space in the fscanf format skips all leading white spaces including numerous new lines and tabs.
+		int res_normal     = fscanf(fp, " facet normal %31s %31s %31s", normal_buf[0], normal_buf[1], normal_buf[2]);
+		assert(res_normal == 3);
+		int res_outer_loop = fscanf(fp, " outer loop");
+		assert(res_outer_loop == 0);
+		int res_vertex1    = fscanf(fp, " vertex %f %f %f", &facet.vertex[0](0), &facet.vertex[0](1), &facet.vertex[0](2));
+		assert(res_vertex1 == 3);
+		int res_vertex2    = fscanf(fp, " vertex %f %f %f", &facet.vertex[1](0), &facet.vertex[1](1), &facet.vertex[1](2));
+		assert(res_vertex2 == 3);
+		// Trailing whitespace is there to eat all whitespaces and empty lines up to the next non-whitespace.
+		int res_vertex3    = fscanf(fp, " vertex %f %f %f ", &facet.vertex[2](0), &facet.vertex[2](1), &facet.vertex[2](2));
+		assert(res_vertex3 == 3);
+		// Some G-code generators tend to produce text after "endloop" and "endfacet". Just ignore it.
+		char buf[2048];
+		[[maybe_unused]] auto unused_result2 = fgets(buf, 2047, fp);
+		bool endloop_ok = strncmp(buf, "endloop", 7) == 0 && (buf[7] == '\r' || buf[7] == '\n' || buf[7] == ' ' || buf[7] == '\t');
+		assert(endloop_ok);
+		// Skip the trailing whitespaces and empty lines.
+		unused_result = fscanf(fp, " ");
+		unused_result2 = fgets(buf, 2047, fp);
+		bool endfacet_ok = strncmp(buf, "endfacet", 8) == 0 && (buf[8] == '\r' || buf[8] == '\n' || buf[8] == ' ' || buf[8] == '\t');
+		assert(endfacet_ok);
+		if (res_normal != 3 || res_outer_loop != 0 || res_vertex1 != 3 || res_vertex2 != 3 || res_vertex3 != 3 || ! endloop_ok || ! endfacet_ok) {
+			BOOST_LOG_TRIVIAL(error) << "Something is syntactically very wrong with this ASCII STL! ";
+			return false;
+		}
 
-			// The facet normal has been parsed as a single string as to workaround for not a numbers in the normal definition.
-			if (sscanf(normal_buf[0], "%f", &facet.normal(0)) != 1 ||
-			    sscanf(normal_buf[1], "%f", &facet.normal(1)) != 1 ||
-			    sscanf(normal_buf[2], "%f", &facet.normal(2)) != 1) {
-			    // Normal was mangled. Maybe denormals or "not a number" were stored?
-			  	// Just reset the normal and silently ignore it.
-			  	memset(&facet.normal, 0, sizeof(facet.normal));
-			}
+		// The facet normal has been parsed as a single string as to workaround for not a numbers in the normal definition.
+		if (sscanf(normal_buf[0], "%f", &facet.normal(0)) != 1 ||
+		    sscanf(normal_buf[1], "%f", &facet.normal(1)) != 1 ||
+		    sscanf(normal_buf[2], "%f", &facet.normal(2)) != 1) {
+		    // Normal was mangled. Maybe denormals or "not a number" were stored?
+		  	// Just reset the normal and silently ignore it.
+		  	memset(&facet.normal, 0, sizeof(facet.normal));
 		}
 
 #if 0
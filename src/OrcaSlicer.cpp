@@ -20,8 +20,13 @@
 #include <cstdio>
 #include <string>
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <math.h>
+#include <memory>
+#include <mutex>
+
+#include <tbb/task_group.h>
 
 #if defined(__linux__) || defined(__LINUX__)
 #include <condition_variable>
@@ -1237,6 +1242,10 @@ int CLI::run(int argc, char **argv)
     float old_max_radius = 0.f, old_height_to_rod = 0.f, old_height_to_lid = 0.f;
     std::vector<double> old_max_layer_height, old_min_layer_height;
     std::string outfile_dir              =  m_config.opt_string("outputdir", true);
+    std::string slice_cache_dir          =  m_config.opt_string("slice_cache_dir", true);
+    // The G-code export relies on process wide state (GCodeWriter::full_gcode_comment, GCodeProcessor::s_IsBBLPrinter),
+    // thus at most one plate is exported in the background.
+    bool parallel_plate_exports          =  m_config.option<ConfigOptionBool>("parallel_plate_exports", true)->value;
     const std::vector<std::string>              &load_configs               = m_config.option<ConfigOptionStrings>("load_settings", true)->values;
     const std::vector<std::string>              &uptodate_configs          = m_config.option<ConfigOptionStrings>("uptodate_settings", true)->values;
     const std::vector<std::string>              &uptodate_filaments          = m_config.option<ConfigOptionStrings>("uptodate_filaments", true)->values;
@@ -5559,6 +5568,150 @@ int CLI::run(int argc, char **argv)
                 //Print       fff_print;
                 std::vector<size_t> plate_triangle_counts(partplate_list.get_plate_count(), 0);
 
+                //BBS: check the warnings reported while slicing or exporting a plate
+                auto check_slicing_warnings = [&](std::vector<PrintBase::SlicingStatus> &warnings, int index, sliced_plate_info_t &sliced_plate_info) -> int {
+                    for (unsigned int i = 0; i < warnings.size(); i++)
+                    {
+                        PrintBase::SlicingStatus& status = warnings[i];
+                        if ((status.warning_step != -1) && (status.message_type != PrintStateBase::SlicingDefaultNotification))
+                        {
+                            sliced_plate_info.warning_message = status.text;
+
+                            if (status.warning_level == PrintStateBase::WarningLevel::NON_CRITICAL) {
+                                BOOST_LOG_TRIVIAL(warning) << "plate "<< index+1<< ": found NON_CRITICAL slicing warnings: "<<status.text <<std::endl;
+                            }
+                            else {
+                                BOOST_LOG_TRIVIAL(warning) << boost::format("plate %1%: found slicing warnings: %2%, no_check=%3%")%(index+1) %status.text %no_check;
+                                if (!no_check) {
+                                    //only following message will be reported under import mode
+                                    if (status.message_type == PrintStateBase::SlicingEmptyGcodeLayers
+                                        || status.message_type == PrintStateBase::SlicingGcodeOverlap)
+                                    {
+                                        sliced_info.sliced_plates.push_back(sliced_plate_info);
+                                        record_exit_reson(outfile_dir, CLI_SLICING_ERROR, index+1, cli_errors[CLI_SLICING_ERROR], sliced_info);
+                                        return CLI_SLICING_ERROR;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    warnings.clear();
+                    return 0;
+                };
+
+                //BBS: a plate whose G-code is exported, either right after slicing it or in the background
+                // while the next plates are being sliced (parallel_plate_exports).
+                struct PlateExport
+                {
+                    int                                   index { 0 };
+                    sliced_plate_info_t                   sliced_plate_info;
+                    PrintBase                            *print { nullptr };
+                    Print                                *print_fff { nullptr };
+                    Slic3r::GUI::GCodeResult             *gcode_result { nullptr };
+                    Slic3r::GUI::PartPlate               *part_plate { nullptr };
+                    std::string                           outfile;
+                    long long                             start_time { 0 };
+                    long long                             time_using_cache { 0 };
+                    // Only used by the exports running in the background.
+                    bool                                  in_background { false };
+                    long long                             end_time { 0 };
+                    tbb::task_group                       task;
+                    std::mutex                            warnings_mutex;
+                    std::vector<PrintBase::SlicingStatus> warnings;
+                    std::string                           error;
+                    // Status callback of the print to be restored once the export finished,
+                    // the callback collecting the warnings of the export refers to this PlateExport.
+                    PrintBase::status_callback_type       status_callback;
+
+                    void join() {
+                        task.wait();
+                        if (status_callback) {
+                            print->set_status_callback(std::move(status_callback));
+                            status_callback = nullptr;
+                        }
+                    }
+                    // Never leave an export running when returning early on error.
+                    ~PlateExport() { this->join(); }
+                };
+                std::deque<std::unique_ptr<PlateExport>> plate_exports;
+                // Early exits wait for the exports running in the background first: flush_and_exit() stops the CLI callback manager
+                // and removes the backup paths of the models, which are still being used by the exports.
+                auto join_plate_exports = [&plate_exports]() {
+                    for (std::unique_ptr<PlateExport> &plate : plate_exports)
+                        plate->join();
+                    plate_exports.clear();
+                };
+#define join_plate_exports_and_exit(ret) { join_plate_exports(); flush_and_exit(ret); }
+
+                //BBS: the part of slicing a plate which follows the G-code export
+                auto finish_plate_export = [&](PlateExport &plate) -> int {
+                    int index = plate.index;
+                    sliced_plate_info_t &sliced_plate_info = plate.sliced_plate_info;
+                    if (plate.in_background) {
+                        plate.join();
+                        if (!plate.error.empty()) {
+                            BOOST_LOG_TRIVIAL(error) << "found slicing or export error for partplate "<<index+1 << std::endl;
+                            boost::nowide::cerr << plate.error << std::endl;
+                            record_exit_reson(outfile_dir, CLI_SLICING_ERROR, index+1, cli_errors[CLI_SLICING_ERROR], sliced_info);
+                            return CLI_SLICING_ERROR;
+                        }
+                        if (int ret = check_slicing_warnings(plate.warnings, index, sliced_plate_info))
+                            return ret;
+                    }
+                    if (plate.gcode_result && plate.gcode_result->gcode_check_result.error_code) {
+                        //found gcode error
+                        if ((plate.gcode_result->gcode_check_result.error_code & 0b11100)>0)
+                            BOOST_LOG_TRIVIAL(error) << "plate " << index + 1 << ": found gcode in unprintable area of the printers! gcode_result->gcode_check_result.error_code = "
+                                << plate.gcode_result->gcode_check_result.error_code << std::endl;
+                        else
+                            BOOST_LOG_TRIVIAL(error) << "plate " << index + 1 << ": found gcode in unprintable area of multi extruder printers! gcode_result->gcode_check_result.error_code = "
+                                << plate.gcode_result->gcode_check_result.error_code << std::endl;
+                        record_exit_reson(outfile_dir, CLI_GCODE_PATH_IN_UNPRINTABLE_AREA, index + 1, cli_errors[CLI_GCODE_PATH_IN_UNPRINTABLE_AREA], sliced_info);
+                        return CLI_GCODE_PATH_IN_UNPRINTABLE_AREA;
+                    }
+
+                    BOOST_LOG_TRIVIAL(info) << "Slicing result exported to " << plate.outfile << std::endl;
+                    plate.part_plate->update_slice_result_valid_state(true);
+#if defined(__linux__) || defined(__LINUX__)
+                    // The progress of the plates exported in the background is finished once all of them are done.
+                    if (g_cli_callback_mgr.is_started() && !plate.in_background) {
+                        PrintBase::SlicingStatus slicing_status{100, "Slicing finished"};
+                        cli_status_callback(slicing_status);
+                    }
+#endif
+                    if (export_slicedata) {
+                        BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ":will export Slicing data to " << export_slice_data_dir;
+                        std::string plate_dir = export_slice_data_dir+"/"+std::to_string(index+1);
+                        bool with_space = (get_logging_level() >= 4)?true:false;
+                        int ret = plate.print->export_cached_data(plate_dir, with_space);
+                        if (ret) {
+                            BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": export Slicing data error, ret=" << ret;
+                            export_slicedata_error = true;
+                            if (fs::exists(plate_dir))
+                                fs::remove_all(plate_dir);
+                            record_exit_reson(outfile_dir, ret, index+1, cli_errors[ret], sliced_info);
+                            return ret;
+                        }
+                    }
+                    // The time a plate exported in the background waited for the plates sliced after it is not accounted.
+                    long long end_time = plate.in_background ? plate.end_time : (long long)Slic3r::Utils::get_current_time_utc();
+                    sliced_plate_info.sliced_time = end_time - plate.start_time;
+                    sliced_plate_info.sliced_time_with_cache = plate.time_using_cache;
+
+                    if (max_slicing_time_per_plate != 0) {
+                        long long time_cost = end_time - plate.start_time;
+                        if (time_cost > max_slicing_time_per_plate) {
+                            sliced_plate_info.warning_message = (boost::format("plate %1%'s slice time %2% exceeds the limit %3%, return error.")%(index+1) %time_cost %max_slicing_time_per_plate).str();
+                            BOOST_LOG_TRIVIAL(error) << sliced_plate_info.warning_message;
+                            sliced_info.sliced_plates.push_back(sliced_plate_info);
+                            record_exit_reson(outfile_dir, CLI_SLICING_TIME_EXCEEDS_LIMIT, index+1, cli_errors[CLI_SLICING_TIME_EXCEEDS_LIMIT], sliced_info);
+                            return CLI_SLICING_TIME_EXCEEDS_LIMIT;
+                        }
+                    }
+                    sliced_info.sliced_plates.push_back(sliced_plate_info);
+                    return 0;
+                };
+
                 while(!finished)
                 {
                     //BBS: slice every partplate one by one
@@ -5578,7 +5731,7 @@ int CLI::run(int argc, char **argv)
 
                         model.curr_plate_index = index;
                         BOOST_LOG_TRIVIAL(info) << boost::format("Plate %1%: pre_check %2%, start")%(index+1)%pre_check;
-                        long long start_time = 0, end_time = 0, temp_time = 0, time_using_cache = 0;
+                        long long start_time = 0, temp_time = 0, time_using_cache = 0;
                         start_time = (long long)Slic3r::Utils::get_current_time_utc();
                         //get the current partplate
                         Slic3r::GUI::PartPlate* part_plate = partplate_list.get_plate(index);
@@ -5610,7 +5763,7 @@ int CLI::run(int argc, char **argv)
                         if (count == 0) {
                             BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": Nothing to be sliced, Either the print is empty or no object is fully inside the print volume before apply." << std::endl;
                             record_exit_reson(outfile_dir, CLI_NO_SUITABLE_OBJECTS, index+1, cli_errors[CLI_NO_SUITABLE_OBJECTS], sliced_info);
-                            flush_and_exit(CLI_NO_SUITABLE_OBJECTS);
+                            join_plate_exports_and_exit(CLI_NO_SUITABLE_OBJECTS);
                         }
                         else if ((plate_to_slice != 0) || pre_check) {
                             long long triangle_count = 0;
@@ -5656,7 +5809,7 @@ int CLI::run(int argc, char **argv)
                                     {
                                         BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": Found Object " << model_object->name <<" partly inside, can not be sliced." << std::endl;
                                         record_exit_reson(outfile_dir, CLI_OBJECTS_PARTLY_INSIDE, index+1, cli_errors[CLI_OBJECTS_PARTLY_INSIDE], sliced_info);
-                                        flush_and_exit(CLI_OBJECTS_PARTLY_INSIDE);
+                                        join_plate_exports_and_exit(CLI_OBJECTS_PARTLY_INSIDE);
                                     }
                                     else if (i->print_volume_state == ModelInstancePVS_Inside)
                                     {
@@ -5678,7 +5831,7 @@ int CLI::run(int argc, char **argv)
                                                 {
                                                     BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": triangle count " << triangle_count <<" exceeds the limit:" << max_triangle_count_per_plate;
                                                     record_exit_reson(outfile_dir, CLI_TRIANGLE_COUNT_EXCEEDS_LIMIT, index+1, cli_errors[CLI_TRIANGLE_COUNT_EXCEEDS_LIMIT], sliced_info);
-                                                    flush_and_exit(CLI_TRIANGLE_COUNT_EXCEEDS_LIMIT);
+                                                    join_plate_exports_and_exit(CLI_TRIANGLE_COUNT_EXCEEDS_LIMIT);
                                                 }
 
                                                 if (new_extruder_count > 1) {
@@ -5709,7 +5862,7 @@ int CLI::run(int argc, char **argv)
                             if (printable_instances == 0) {
                                 BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": Nothing to be sliced, after skipping "<<skipped_count<<" objects."<< std::endl;
                                 record_exit_reson(outfile_dir, CLI_NO_SUITABLE_OBJECTS_AFTER_SKIP, index+1, cli_errors[CLI_NO_SUITABLE_OBJECTS_AFTER_SKIP], sliced_info);
-                                flush_and_exit(CLI_NO_SUITABLE_OBJECTS_AFTER_SKIP);
+                                join_plate_exports_and_exit(CLI_NO_SUITABLE_OBJECTS_AFTER_SKIP);
                             }
 
                             std::vector<int> plate_filaments = part_plate->get_extruders_under_cli(true, m_print_config);
@@ -5727,7 +5880,7 @@ int CLI::run(int argc, char **argv)
                             if (!tpu_valid) {
                                 BOOST_LOG_TRIVIAL(error) << boost::format("plate %1% : Found 2 or more tpu filaments on plate ") % (index + 1);
                                 record_exit_reson(outfile_dir, CLI_ONLY_ONE_TPU_SUPPORTED, index + 1, cli_errors[CLI_ONLY_ONE_TPU_SUPPORTED], sliced_info);
-                                flush_and_exit(CLI_ONLY_ONE_TPU_SUPPORTED);
+                                join_plate_exports_and_exit(CLI_ONLY_ONE_TPU_SUPPORTED);
                             }
 
                             if (new_extruder_count > 1) {
@@ -5770,7 +5923,7 @@ int CLI::run(int argc, char **argv)
                                     {
                                         BOOST_LOG_TRIVIAL(error) << boost::format("plate %1% : some filaments can not be mapped under auto mode for multi extruder printer ")% (index + 1);
                                         record_exit_reson(outfile_dir, CLI_FILAMENT_CAN_NOT_MAP, index + 1, cli_errors[CLI_FILAMENT_CAN_NOT_MAP], sliced_info);
-                                        flush_and_exit(CLI_FILAMENT_CAN_NOT_MAP);
+                                        join_plate_exports_and_exit(CLI_FILAMENT_CAN_NOT_MAP);
                                     }
                                 }
                                 else {
@@ -5789,7 +5942,7 @@ int CLI::run(int argc, char **argv)
                                         {
                                             BOOST_LOG_TRIVIAL(error) << boost::format("plate %1% : some filaments can not be mapped under manual mode for multi extruder printer ") % (index + 1);
                                             record_exit_reson(outfile_dir, CLI_FILAMENT_CAN_NOT_MAP, index + 1, cli_errors[CLI_FILAMENT_CAN_NOT_MAP], sliced_info);
-                                            flush_and_exit(CLI_FILAMENT_CAN_NOT_MAP);
+                                            join_plate_exports_and_exit(CLI_FILAMENT_CAN_NOT_MAP);
                                         }
                                     }
 
@@ -5809,7 +5962,7 @@ int CLI::run(int argc, char **argv)
                                                                    (index + 1) % filament_type % filament_extruder;
                                                         record_exit_reson(outfile_dir, CLI_FILAMENTS_NOT_SUPPORTED_BY_EXTRUDER, index + 1,
                                                                           cli_errors[CLI_FILAMENTS_NOT_SUPPORTED_BY_EXTRUDER], sliced_info);
-                                                        flush_and_exit(CLI_FILAMENTS_NOT_SUPPORTED_BY_EXTRUDER);
+                                                        join_plate_exports_and_exit(CLI_FILAMENTS_NOT_SUPPORTED_BY_EXTRUDER);
                                                     }
                                                 }
                                             }
@@ -5936,7 +6089,7 @@ int CLI::run(int argc, char **argv)
                                     record_exit_reson(outfile_dir, validate_error, index+1, err.string, sliced_info);
                                 else
                                     record_exit_reson(outfile_dir, validate_error, index+1, cli_errors[validate_error], sliced_info);
-                                flush_and_exit(validate_error);
+                                join_plate_exports_and_exit(validate_error);
                             }
                         }
                         else if (!warning.string.empty()) {
@@ -5946,7 +6099,7 @@ int CLI::run(int argc, char **argv)
                         if (print->empty()) {
                             BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": Nothing to be sliced, Either the print is empty or no object is fully inside the print volume after apply." << std::endl;
                             record_exit_reson(outfile_dir, CLI_NO_SUITABLE_OBJECTS, index+1, cli_errors[CLI_NO_SUITABLE_OBJECTS], sliced_info);
-                            flush_and_exit(CLI_NO_SUITABLE_OBJECTS);
+                            join_plate_exports_and_exit(CLI_NO_SUITABLE_OBJECTS);
                         }
                         else {
                             if (pre_check && (partplate_list.get_plate_count() > 1)) //continue to next plate directly
@@ -6002,48 +6155,39 @@ int CLI::run(int argc, char **argv)
                                         BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ": finished print::process.";
                                     }
                                 }
+                                else if (!slice_cache_dir.empty() && print->load_step_cache(slice_cache_dir) == 0) {
+                                    BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ": sliced objects restored from " << slice_cache_dir;
+                                    print->process(nullptr, true);
+                                    BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ": finished print::process.";
+                                }
                                 else {
                                     print->process(&time_using_cache);
                                     BOOST_LOG_TRIVIAL(info) << "print::process: first time_using_cache is " << time_using_cache << " secs.";
+                                    if (!slice_cache_dir.empty()) {
+                                        int ret = print->export_step_cache(slice_cache_dir);
+                                        if (ret)
+                                            BOOST_LOG_TRIVIAL(warning) << "plate "<< index+1<< ": failed to store the sliced objects to " << slice_cache_dir << ", ret=" << ret;
+                                    }
                                 }
+                                auto plate_export = std::make_unique<PlateExport>();
+                                plate_export->index            = index;
+                                plate_export->print            = print;
+                                plate_export->print_fff        = print_fff;
+                                plate_export->gcode_result     = gcode_result;
+                                plate_export->part_plate       = part_plate;
+                                plate_export->start_time       = start_time;
+                                plate_export->time_using_cache = time_using_cache;
                                 if (printer_technology == ptFFF) {
                                     std::string conflict_result = print_fff->get_conflict_string();
                                     if (!conflict_result.empty()) {
                                        BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": found slicing result conflict!"<< std::endl;
                                        record_exit_reson(outfile_dir, CLI_GCODE_PATH_CONFLICTS, index+1, cli_errors[CLI_GCODE_PATH_CONFLICTS], sliced_info);
-                                       flush_and_exit(CLI_GCODE_PATH_CONFLICTS);
+                                       join_plate_exports_and_exit(CLI_GCODE_PATH_CONFLICTS);
                                     }
 
                                     //check the warnings
-                                    if (!g_slicing_warnings.empty())
-                                    {
-                                        for (unsigned int i = 0; i < g_slicing_warnings.size(); i++)
-                                        {
-                                            PrintBase::SlicingStatus& status = g_slicing_warnings[i];
-                                            if ((status.warning_step != -1) && (status.message_type != PrintStateBase::SlicingDefaultNotification))
-                                            {
-                                                sliced_plate_info.warning_message = status.text;
-
-                                                if (status.warning_level == PrintStateBase::WarningLevel::NON_CRITICAL) {
-                                                    BOOST_LOG_TRIVIAL(warning) << "plate "<< index+1<< ": found NON_CRITICAL slicing warnings: "<<status.text <<std::endl;
-                                                }
-                                                else {
-                                                    BOOST_LOG_TRIVIAL(warning) << boost::format("plate %1%: found slicing warnings: %2%, no_check=%3%")%(index+1) %status.text %no_check;
-                                                    if (!no_check) {
-                                                        //only following message will be reported under import mode
-                                                        if (status.message_type == PrintStateBase::SlicingEmptyGcodeLayers
-                                                            || status.message_type == PrintStateBase::SlicingGcodeOverlap)
-                                                        {
-                                                            sliced_info.sliced_plates.push_back(sliced_plate_info);
-                                                            record_exit_reson(outfile_dir, CLI_SLICING_ERROR, index+1, cli_errors[CLI_SLICING_ERROR], sliced_info);
-                                                            flush_and_exit(CLI_SLICING_ERROR);
-                                                        }
-                                                    }
-                                                }
-                                            }
-                                        }
-                                        g_slicing_warnings.clear();
-                                    }
+                                    if (int ret = check_slicing_warnings(g_slicing_warnings, index, sliced_plate_info))
+                                        join_plate_exports_and_exit(ret);
                                     sliced_plate_info.triangle_count = plate_triangle_counts[index];
 
                                     // The outfile is processed by a PlaceholderParser.
@@ -6056,22 +6200,44 @@ int CLI::run(int argc, char **argv)
                                         part_plate->set_tmp_gcode_path(outfile);
                                     }
                                     BOOST_LOG_TRIVIAL(info) << "process finished, will export gcode temporily to " << outfile << std::endl;
-                                    temp_time = (long long)Slic3r::Utils::get_current_time_utc();
-                                    outfile = print_fff->export_gcode(outfile, gcode_result, nullptr);
-                                    time_using_cache = time_using_cache + ((long long)Slic3r::Utils::get_current_time_utc() - temp_time);
-                                    BOOST_LOG_TRIVIAL(info) << "export_gcode finished: time_using_cache update to " << time_using_cache << " secs.";
-                                    if (gcode_result && gcode_result->gcode_check_result.error_code) {
-                                        //found gcode error
-                                        if ((gcode_result->gcode_check_result.error_code & 0b11100)>0)
-                                            BOOST_LOG_TRIVIAL(error) << "plate " << index + 1 << ": found gcode in unprintable area of the printers! gcode_result->gcode_check_result.error_code = "
-                                                << gcode_result->gcode_check_result.error_code << std::endl;
+                                    if (parallel_plate_exports) {
+                                        // Export in the background, sharing the TBB workers with slicing of the next plates.
+                                        // The warnings of this plate are collected separately from the ones of the plates sliced meanwhile.
+                                        plate_export->in_background = true;
+                                        plate_export->outfile       = outfile;
+#if defined(__linux__) || defined(__LINUX__)
+                                        if (g_cli_callback_mgr.is_started())
+                                            plate_export->status_callback = cli_status_callback;
                                         else
-                                            BOOST_LOG_TRIVIAL(error) << "plate " << index + 1 << ": found gcode in unprintable area of multi extruder printers! gcode_result->gcode_check_result.error_code = "
-                                                << gcode_result->gcode_check_result.error_code << std::endl;
-                                        record_exit_reson(outfile_dir, CLI_GCODE_PATH_IN_UNPRINTABLE_AREA, index + 1, cli_errors[CLI_GCODE_PATH_IN_UNPRINTABLE_AREA], sliced_info);
-                                        flush_and_exit(CLI_GCODE_PATH_IN_UNPRINTABLE_AREA);
+#endif
+                                            plate_export->status_callback = default_status_callback;
+                                        print->set_status_callback([plate = plate_export.get()](const PrintBase::SlicingStatus& slicing_status) {
+                                            if (slicing_status.warning_step != -1) {
+                                                std::lock_guard<std::mutex> lock(plate->warnings_mutex);
+                                                plate->warnings.push_back(slicing_status);
+                                            }
+                                        });
+                                        plate_export->task.run([plate = plate_export.get()]() {
+                                            try {
+                                                long long export_start = (long long)Slic3r::Utils::get_current_time_utc();
+                                                plate->outfile = plate->print_fff->export_gcode(plate->outfile, plate->gcode_result, nullptr);
+                                                plate->end_time = (long long)Slic3r::Utils::get_current_time_utc();
+                                                plate->time_using_cache += plate->end_time - export_start;
+                                                BOOST_LOG_TRIVIAL(info) << "plate " << plate->index + 1 << ": export_gcode finished in the background: time_using_cache update to " << plate->time_using_cache << " secs.";
+                                            } catch (const std::exception &ex) {
+                                                plate->error = ex.what();
+                                            } catch (...) {
+                                                plate->error = "unknown error while exporting G-code";
+                                            }
+                                        });
+                                    }
+                                    else {
+                                        temp_time = (long long)Slic3r::Utils::get_current_time_utc();
+                                        outfile = print_fff->export_gcode(outfile, gcode_result, nullptr);
+                                        time_using_cache = time_using_cache + ((long long)Slic3r::Utils::get_current_time_utc() - temp_time);
+                                        BOOST_LOG_TRIVIAL(info) << "export_gcode finished: time_using_cache update to " << time_using_cache << " secs.";
+                                        plate_export->outfile = outfile;
                                     }
-
 
                                     //outfile_final = (dynamic_cast<Print*>(print))->print_statistics().finalize_output_path(outfile);
                                     //m_fff_print->export_gcode(m_temp_output_path, m_gcode_result, [this](const ThumbnailsParams& params) { return this->render_thumbnails(params); });
@@ -6091,57 +6257,46 @@ int CLI::run(int argc, char **argv)
                                 }*/
                                 // Run the post-processing scripts if defined.
                                 //run_post_process_scripts(outfile, print->full_print_config());
-                                BOOST_LOG_TRIVIAL(info) << "Slicing result exported to " << outfile << std::endl;
-                                part_plate->update_slice_result_valid_state(true);
-#if defined(__linux__) || defined(__LINUX__)
-                                if (g_cli_callback_mgr.is_started()) {
-                                    PrintBase::SlicingStatus slicing_status{100, "Slicing finished"};
-                                    cli_status_callback(slicing_status);
+                                plate_export->sliced_plate_info = sliced_plate_info;
+                                if (!plate_export->in_background)
+                                    plate_export->time_using_cache = time_using_cache;
+                                plate_exports.emplace_back(std::move(plate_export));
+                                // Bound the number of plates held by the exports running in the background.
+                                while (plate_exports.size() > (parallel_plate_exports ? 1u : 0u)) {
+                                    int ret = finish_plate_export(*plate_exports.front());
+                                    plate_exports.pop_front();
+                                    if (ret)
+                                        join_plate_exports_and_exit(ret);
                                 }
-#endif
-                                if (export_slicedata) {
-                                    BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ":will export Slicing data to " << export_slice_data_dir;
-                                    std::string plate_dir = export_slice_data_dir+"/"+std::to_string(index+1);
-                                    bool with_space = (get_logging_level() >= 4)?true:false;
-                                    int ret = print->export_cached_data(plate_dir, with_space);
-                                    if (ret) {
-                                        BOOST_LOG_TRIVIAL(error) << "plate "<< index+1<< ": export Slicing data error, ret=" << ret;
-                                        export_slicedata_error = true;
-                                        if (fs::exists(plate_dir))
-                                            fs::remove_all(plate_dir);
-                                        record_exit_reson(outfile_dir, ret, index+1, cli_errors[ret], sliced_info);
-                                        flush_and_exit(ret);
-                                    }
-                                }
-                                end_time = (long long)Slic3r::Utils::get_current_time_utc();
-                                sliced_plate_info.sliced_time = end_time - start_time;
-                                sliced_plate_info.sliced_time_with_cache = time_using_cache;
-
-                                if (max_slicing_time_per_plate != 0) {
-                                    long long time_cost = end_time - start_time;
-                                    if (time_cost > max_slicing_time_per_plate) {
-                                        sliced_plate_info.warning_message = (boost::format("plate %1%'s slice time %2% exceeds the limit %3%, return error.")%(index+1) %time_cost %max_slicing_time_per_plate).str();
-                                        BOOST_LOG_TRIVIAL(error) << sliced_plate_info.warning_message;
-                                        sliced_info.sliced_plates.push_back(sliced_plate_info);
-                                        record_exit_reson(outfile_dir, CLI_SLICING_TIME_EXCEEDS_LIMIT, index+1, cli_errors[CLI_SLICING_TIME_EXCEEDS_LIMIT], sliced_info);
-                                        flush_and_exit(CLI_SLICING_TIME_EXCEEDS_LIMIT);
-                                    }
-                                }
-                                sliced_info.sliced_plates.push_back(sliced_plate_info);
                             } catch (const std::exception &ex) {
                                 BOOST_LOG_TRIVIAL(error) << "found slicing or export error for partplate "<<index+1 << std::endl;
                                 boost::nowide::cerr << ex.what() << std::endl;
                                 //continue;
                                 record_exit_reson(outfile_dir, CLI_SLICING_ERROR, index+1, cli_errors[CLI_SLICING_ERROR], sliced_info);
-                                flush_and_exit(CLI_SLICING_ERROR);
+                                join_plate_exports_and_exit(CLI_SLICING_ERROR);
                             }
                         }
                     }
+                    bool exported_in_background = false;
+                    while (!plate_exports.empty()) {
+                        exported_in_background |= plate_exports.front()->in_background;
+                        int ret = finish_plate_export(*plate_exports.front());
+                        plate_exports.pop_front();
+                        if (ret)
+                            join_plate_exports_and_exit(ret);
+                    }
+#if defined(__linux__) || defined(__LINUX__)
+                    if (g_cli_callback_mgr.is_started() && exported_in_background) {
+                        PrintBase::SlicingStatus slicing_status{100, "Slicing finished"};
+                        cli_status_callback(slicing_status);
+                    }
+#endif
                     if (pre_check&& (partplate_list.get_plate_count() > 1))
                         pre_check = false;
                     else
                         finished = true;
                 }//end for partplate
+#undef join_plate_exports_and_exit
 
 #if defined(__linux__) || defined(__LINUX__)
                 if (g_cli_callback_mgr.is_started()) {
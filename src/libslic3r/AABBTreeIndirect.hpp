@@ -7,6 +7,7 @@
 #define slic3r_AABBTreeIndirect_hpp_
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -365,19 +366,22 @@ namespace detail {
 	template<typename V, typename W>
     std::enable_if_t<std::is_same<typename V::Scalar, double>::value && !std::is_same<typename W::Scalar, double>::value, bool>
 	intersect_triangle(const V &origin, const V &dir, const W &v0, const W &v1, const W &v2, double &t, double &u, double &v, double eps) {
-        return intersect_triangle(origin, dir, v0.template cast<double>(), v1.template cast<double>(), v2.template cast<double>(), t, u, v, eps);
+        using Vec = Eigen::Matrix<double, 3, 1, Eigen::DontAlign>;
+        return intersect_triangle(origin, dir, Vec(v0.template cast<double>()), Vec(v1.template cast<double>()), Vec(v2.template cast<double>()), t, u, v, eps);
 	}
 
 	template<typename V, typename W>
     std::enable_if_t<! std::is_same<typename V::Scalar, double>::value && std::is_same<typename W::Scalar, double>::value, bool>
 	intersect_triangle(const V &origin, const V &dir, const W &v0, const W &v1, const W &v2, double &t, double &u, double &v, double eps) {
-        return intersect_triangle(origin.template cast<double>(), dir.template cast<double>(), v0, v1, v2, t, u, v, eps);
+        using Vec = Eigen::Matrix<double, 3, 1, Eigen::DontAlign>;
+        return intersect_triangle(Vec(origin.template cast<double>()), Vec(dir.template cast<double>()), v0, v1, v2, t, u, v, eps);
 	}
 
 	template<typename V, typename W>
     std::enable_if_t<! std::is_same<typename V::Scalar, double>::value && ! std::is_same<typename W::Scalar, double>::value, bool>
 	intersect_triangle(const V &origin, const V &dir, const W &v0, const W &v1, const W &v2, double &t, double &u, double &v, double eps) {
-	    return intersect_triangle(origin.template cast<double>(), dir.template cast<double>(), v0.template cast<double>(), v1.template cast<double>(), v2.template cast<double>(), t, u, v, eps);
+        using Vec = Eigen::Matrix<double, 3, 1, Eigen::DontAlign>;
+	    return intersect_triangle(Vec(origin.template cast<double>()), Vec(dir.template cast<double>()), Vec(v0.template cast<double>()), Vec(v1.template cast<double>()), Vec(v2.template cast<double>()), t, u, v, eps);
 	}
 
 	template<typename Tree>
@@ -470,6 +474,125 @@ namespace detail {
 		}
 	}
 
+	// Rays traversing the AABB tree together, see intersect_rays_first_hit() and intersect_rays_all_hits().
+	// The ray / bounding box test runs over a structure of arrays for all rays of the packet at once,
+	// so that the compiler may vectorize it with the SIMD instructions available (SSE, AVX, NEON).
+	static constexpr size_t RayPacketSize = 8;
+	// Minimum number of the active rays of a packet to test a bounding box with all the rays at once.
+	static constexpr size_t RayPacketMinActive = 3;
+
+	template<typename VectorType>
+	struct RayPacket {
+		using Scalar = typename VectorType::Scalar;
+
+		// Source rays, used for the ray / triangle intersections.
+		const VectorType *origins[RayPacketSize];
+		const VectorType *dirs[RayPacketSize];
+		// Structure of arrays for the ray / bounding box tests.
+		alignas(32) Scalar origin[3][RayPacketSize];
+		alignas(32) Scalar invdir[3][RayPacketSize];
+		// Upper bound of the ray parameter, the closest hit found so far for the first hit queries.
+		alignas(32) Scalar max_t[RayPacketSize];
+		// Number of the valid rays, the remaining lanes repeat the first ray.
+		size_t 			   size;
+
+		RayPacket(const VectorType *ray_origins, const VectorType *ray_dirs, size_t num_rays) : size(num_rays) {
+			assert(num_rays > 0 && num_rays <= RayPacketSize);
+			for (size_t i = 0; i < RayPacketSize; ++ i) {
+				size_t j = i < num_rays ? i : 0;
+				origins[i] = &ray_origins[j];
+				dirs[i]    = &ray_dirs[j];
+				VectorType invdir_j = ray_dirs[j].cwiseInverse();
+				for (int axis = 0; axis < 3; ++ axis) {
+					origin[axis][i] = ray_origins[j](axis);
+					invdir[axis][i] = invdir_j(axis);
+				}
+				max_t[i] = std::numeric_limits<Scalar>::infinity();
+			}
+		}
+
+		uint32_t all_mask() const { return uint32_t((uint64_t(1) << size) - 1); }
+	};
+
+	// Bit mask of the active rays of a packet intersecting a bounding box within <0, max_t).
+	// For each ray, the same comparisons are made as by ray_box_intersect_invdir(), thus the results are the same,
+	// including the rays parallel to a box face.
+	template<typename VectorType, typename BoxType>
+	inline uint32_t ray_packet_box_intersect(const RayPacket<VectorType> &packet, const BoxType &bbox, uint32_t active_mask)
+	{
+		using Scalar = typename VectorType::Scalar;
+		size_t num_active = 0;
+		for (uint32_t m = active_mask; m != 0; m &= m - 1)
+			++ num_active;
+		if (num_active < RayPacketMinActive) {
+			// Deeper in the tree, where the rays diverged, the rays left are tested one by one.
+			const Eigen::AlignedBox<Scalar, 3> box = bbox.template cast<Scalar>();
+			uint32_t mask = 0;
+			for (size_t i = 0; active_mask != 0; ++ i, active_mask >>= 1)
+				if ((active_mask & 1) &&
+					ray_box_intersect_invdir(Eigen::Matrix<Scalar, 3, 1>(packet.origin[0][i], packet.origin[1][i], packet.origin[2][i]),
+											 Eigen::Matrix<Scalar, 3, 1>(packet.invdir[0][i], packet.invdir[1][i], packet.invdir[2][i]),
+											 box, Scalar(0), packet.max_t[i]))
+					mask |= uint32_t(1) << i;
+			return mask;
+		}
+		const Scalar min_x = Scalar(bbox.min().x()), min_y = Scalar(bbox.min().y()), min_z = Scalar(bbox.min().z());
+		const Scalar max_x = Scalar(bbox.max().x()), max_y = Scalar(bbox.max().y()), max_z = Scalar(bbox.max().z());
+		// Without branches and short circuit evaluation, so that the loop is vectorized.
+		// The slabs are selected by two complementary conditions instead of a single one, otherwise GCC turns the selection into branches.
+		uint32_t hit[RayPacketSize];
+		for (size_t i = 0; i < RayPacketSize; ++ i) {
+			Scalar ox = packet.origin[0][i], oy = packet.origin[1][i], oz = packet.origin[2][i];
+			Scalar ix = packet.invdir[0][i], iy = packet.invdir[1][i], iz = packet.invdir[2][i];
+			Scalar tx0 = (min_x - ox) * ix, tx1 = (max_x - ox) * ix;
+			Scalar ty0 = (min_y - oy) * iy, ty1 = (max_y - oy) * iy;
+			Scalar tz0 = (min_z - oz) * iz, tz1 = (max_z - oz) * iz;
+			Scalar tmin  = ix <  Scalar(0) ? tx1 : tx0;
+			Scalar tmax  = ix >= Scalar(0) ? tx1 : tx0;
+			Scalar tymin = iy <  Scalar(0) ? ty1 : ty0;
+			Scalar tymax = iy >= Scalar(0) ? ty1 : ty0;
+			uint32_t ok  = uint32_t(! (tmin > tymax)) & uint32_t(! (tymin > tmax));
+			tmin = tymin > tmin ? tymin : tmin;
+			tmax = tymax < tmax ? tymax : tmax;
+			Scalar tzmin = iz <  Scalar(0) ? tz1 : tz0;
+			Scalar tzmax = iz >= Scalar(0) ? tz1 : tz0;
+			ok  &= uint32_t(! (tzmin > tmax)) & uint32_t(! (tmin > tzmax));
+			tmin = tzmin > tmin ? tzmin : tmin;
+			tmax = tzmax < tmax ? tzmax : tmax;
+			hit[i] = ok & uint32_t(tmin < packet.max_t[i]) & uint32_t(tmax > Scalar(0));
+		}
+		uint32_t mask = 0;
+		for (size_t i = 0; i < RayPacketSize; ++ i)
+			mask |= uint32_t(hit[i]) << i;
+		return mask & active_mask;
+	}
+
+	// Depth first traversal of the AABB tree by a packet of rays, left child first, as the recursive single ray traversals do.
+	// A ray enters a node only if it entered its parent, thus each ray visits the same nodes in the same order
+	// as if it was traced alone. leaf_fn(face_idx, mask) is called for the rays in mask hitting the bounding box of a leaf.
+	template<typename TreeType, typename VectorType, typename LeafFn>
+	inline void traverse_ray_packet(const TreeType &tree, const RayPacket<VectorType> &packet, LeafFn &&leaf_fn)
+	{
+		// The depth of the balanced tree is limited by the number of bits of its size.
+		std::pair<size_t, uint32_t> stack[2 * sizeof(size_t) * 8];
+		size_t 						stack_size = 0;
+		stack[stack_size ++] = { 0, packet.all_mask() };
+		while (stack_size > 0) {
+			auto [node_idx, parent_mask] = stack[-- stack_size];
+			const auto &node = tree.node(node_idx);
+			assert(node.is_valid());
+			uint32_t mask = ray_packet_box_intersect(packet, node.bbox, parent_mask);
+			if (mask == 0)
+				continue;
+			if (node.is_leaf())
+				leaf_fn(node.idx, mask);
+			else {
+				stack[stack_size ++] = { TreeType::right_child_idx(node_idx), mask };
+				stack[stack_size ++] = { TreeType::left_child_idx(node_idx), mask };
+			}
+		}
+	}
+
     // Real-time collision detection, Ericson, Chapter 5
     template<typename Vector>
     static inline Vector closest_point_to_triangle(const Vector &p, const Vector &a, const Vector &b, const Vector &c)
@@ -787,6 +910,106 @@ inline bool intersect_ray_all_hits(
 	return ! hits.empty();
 }
 
+// Find the first intersections of a bundle of rays with indexed triangle set.
+// The rays are traced through the AABB tree in packets, visiting a node once for all rays of a packet.
+// This is faster than calling intersect_ray_first_hit() for each ray if the rays are coherent, for example
+// if they share an origin, while the hits are the same. The rays and the intersection tests are calculated
+// with the accuracy of VectorType::Scalar, float and double rays are supported.
+// hits[i].id is -1 if the i-th ray does not hit any triangle. Returns the number of rays hitting a triangle.
+template<typename VertexType, typename IndexedFaceType, typename TreeType, typename VectorType>
+inline size_t intersect_rays_first_hit(
+	// Indexed triangle set - 3D vertices.
+	const std::vector<VertexType> 		&vertices,
+	// Indexed triangle set - triangular faces, references to vertices.
+	const std::vector<IndexedFaceType> 	&faces,
+	// AABBTreeIndirect::Tree over vertices & faces, bounding boxes built with the accuracy of vertices.
+	const TreeType 						&tree,
+	// Origins of the rays.
+	const std::vector<VectorType>		&origins,
+	// Directions of the rays.
+	const std::vector<VectorType> 		&dirs,
+	// First intersections of the rays with the indexed triangle set.
+	std::vector<igl::Hit> 				&hits,
+	// Epsilon for the ray-triangle intersection, it should be proportional to an average triangle edge length.
+	const double 						 eps = 0.000001)
+{
+	using Scalar = typename VectorType::Scalar;
+	assert(origins.size() == dirs.size());
+	hits.assign(dirs.size(), igl::Hit { -1, -1, 0.f, 0.f, std::numeric_limits<float>::infinity() });
+	if (tree.empty())
+		return 0;
+	size_t num_hits = 0;
+	for (size_t first = 0; first < dirs.size(); first += detail::RayPacketSize) {
+		detail::RayPacket<VectorType> packet(origins.data() + first, dirs.data() + first, std::min(detail::RayPacketSize, dirs.size() - first));
+		detail::traverse_ray_packet(tree, packet, [&vertices, &faces, &packet, &hits, first, eps](size_t face_idx, uint32_t mask) {
+			const auto face = faces[face_idx];
+			for (size_t i = 0; mask != 0; ++ i, mask >>= 1)
+				if (mask & 1) {
+					double t, u, v;
+					// Only a hit closer than the current closest hit is accepted, as intersect_ray_recursive_first_hit() does.
+					if (detail::intersect_triangle(*packet.origins[i], *packet.dirs[i], vertices[face(0)], vertices[face(1)], vertices[face(2)], t, u, v, eps) &&
+						t > 0. && Scalar(float(t)) < packet.max_t[i]) {
+						hits[first + i] = igl::Hit { int(face_idx), -1, float(u), float(v), float(t) };
+						packet.max_t[i] = Scalar(float(t));
+					}
+				}
+		});
+		for (size_t i = first; i < first + packet.size; ++ i)
+			if (hits[i].id != -1)
+				++ num_hits;
+	}
+	return num_hits;
+}
+
+// Find all intersections of a bundle of rays with indexed triangle set, tracing the rays through the AABB tree in packets.
+// The output hits of each ray are sorted by the ray parameter and they are the same as returned by intersect_ray_all_hits().
+// Returns the number of rays hitting a triangle.
+template<typename VertexType, typename IndexedFaceType, typename TreeType, typename VectorType>
+inline size_t intersect_rays_all_hits(
+	// Indexed triangle set - 3D vertices.
+	const std::vector<VertexType> 		&vertices,
+	// Indexed triangle set - triangular faces, references to vertices.
+	const std::vector<IndexedFaceType> 	&faces,
+	// AABBTreeIndirect::Tree over vertices & faces, bounding boxes built with the accuracy of vertices.
+	const TreeType 						&tree,
+	// Origins of the rays.
+	const std::vector<VectorType>		&origins,
+	// Directions of the rays.
+	const std::vector<VectorType> 		&dirs,
+	// All intersections of the rays with the indexed triangle set, sorted by parameter t.
+	// Memory of the vectors already allocated is reused.
+	std::vector<std::vector<igl::Hit>> 	&hits,
+	// Epsilon for the ray-triangle intersection, it should be proportional to an average triangle edge length.
+	const double 						 eps = 0.000001)
+{
+	assert(origins.size() == dirs.size());
+	hits.resize(dirs.size());
+	for (std::vector<igl::Hit> &ray_hits : hits)
+		ray_hits.clear();
+	if (tree.empty())
+		return 0;
+	size_t num_hits = 0;
+	for (size_t first = 0; first < dirs.size(); first += detail::RayPacketSize) {
+		detail::RayPacket<VectorType> packet(origins.data() + first, dirs.data() + first, std::min(detail::RayPacketSize, dirs.size() - first));
+		detail::traverse_ray_packet(tree, packet, [&vertices, &faces, &packet, &hits, first, eps](size_t face_idx, uint32_t mask) {
+			const auto face = faces[face_idx];
+			for (size_t i = 0; mask != 0; ++ i, mask >>= 1)
+				if (mask & 1) {
+					double t, u, v;
+					if (detail::intersect_triangle(*packet.origins[i], *packet.dirs[i], vertices[face(0)], vertices[face(1)], vertices[face(2)], t, u, v, eps) &&
+						t > 0.)
+						hits[first + i].emplace_back(igl::Hit{ int(face_idx), -1, float(u), float(v), float(t) });
+				}
+		});
+		for (size_t i = first; i < first + packet.size; ++ i)
+			if (! hits[i].empty()) {
+				std::sort(hits[i].begin(), hits[i].end(), [](const auto &l, const auto &r) { return l.t < r.t; });
+				++ num_hits;
+			}
+	}
+	return num_hits;
+}
+
 // Finding a closest triangle, its closest point and squared distance to the closest point
 // on a 3D indexed triangle set using a pre-built AABBTreeIndirect::Tree.
 // Closest point to triangle test will be performed with the accuracy of VectorType::Scalar
@@ -18,6 +18,8 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 //#define ARACHNE_STITCH_PATCH_DEBUG
 
 namespace Slic3r::Arachne
@@ -468,6 +470,40 @@ void removeColinearEdges(Polygons &thiss, const double max_deviation_angle = 0.0
     }
 }
 
+// Group the contours and holes of a union into islands, each hole with the smallest contour containing it.
+// The polygons are not modified, thus the walls of an island are the same as if generated for all islands together.
+static std::vector<Polygons> split_into_islands(const Polygons &polygons)
+{
+    std::vector<size_t>      contour_ids;
+    std::vector<BoundingBox> contour_bboxes;
+    std::vector<double>      contour_areas;
+    for (size_t i = 0; i < polygons.size(); ++ i)
+        if (double a = polygons[i].area(); a > 0.) {
+            contour_ids.emplace_back(i);
+            contour_bboxes.emplace_back(get_extents(polygons[i]));
+            contour_areas.emplace_back(a);
+        }
+    if (contour_ids.size() < 2)
+        return {};
+
+    std::vector<Polygons> islands(contour_ids.size());
+    for (size_t i = 0; i < contour_ids.size(); ++ i)
+        islands[i].emplace_back(polygons[contour_ids[i]]);
+    for (const Polygon &hole : polygons)
+        if (hole.area() < 0.) {
+            size_t island_idx = std::numeric_limits<size_t>::max();
+            for (size_t i = 0; i < contour_ids.size(); ++ i)
+                if (contour_bboxes[i].contains(hole.points.front()) && polygons[contour_ids[i]].contains(hole.points.front()) &&
+                    (island_idx == std::numeric_limits<size_t>::max() || contour_areas[i] < contour_areas[island_idx]))
+                    island_idx = i;
+            if (island_idx == std::numeric_limits<size_t>::max())
+                // Should not happen for a union, don't split the outline then.
+                return {};
+            islands[island_idx].emplace_back(hole);
+        }
+    return islands;
+}
+
 const std::vector<VariableWidthLines> &WallToolPaths::generate()
 {
     if (this->inset_count < 1)
@@ -529,17 +565,38 @@ const std::vector<VariableWidthLines> &WallToolPaths::generate()
         );
     const coord_t transition_filter_dist   = scaled<coord_t>(100.f);
     const coord_t allowed_filter_deviation = wall_transition_filter_deviation;
-    SkeletalTrapezoidation wall_maker
-    (
-        prepared_outline,
-        *beading_strat,
-        beading_strat->getTransitioningAngle(),
-        discretization_step_size,
-        transition_filter_dist,
-        allowed_filter_deviation,
-        wall_transition_length
-    );
-    wall_maker.generateToolpaths(toolpaths);
+    auto generate_island_toolpaths = [&](const Polygons &island_outline, std::vector<VariableWidthLines> &island_toolpaths) {
+        SkeletalTrapezoidation wall_maker
+        (
+            island_outline,
+            *beading_strat,
+            beading_strat->getTransitioningAngle(),
+            discretization_step_size,
+            transition_filter_dist,
+            allowed_filter_deviation,
+            wall_transition_length
+        );
+        wall_maker.generateToolpaths(island_toolpaths);
+    };
+
+    // The islands of the outline do not interact: inside an island, the Voronoi diagram only depends on the boundary
+    // of the island itself. Thus each island gets its own, smaller Voronoi diagram and skeletal graph, in parallel.
+    std::vector<Polygons> islands = m_params.split_islands ? split_into_islands(prepared_outline) : std::vector<Polygons>();
+    if (islands.size() > 1) {
+        std::vector<std::vector<VariableWidthLines>> island_toolpaths(islands.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, islands.size(), 1), [&islands, &island_toolpaths, &generate_island_toolpaths](const tbb::blocked_range<size_t> &range) {
+            for (size_t island_idx = range.begin(); island_idx < range.end(); ++ island_idx)
+                generate_island_toolpaths(islands[island_idx], island_toolpaths[island_idx]);
+        });
+        // Merge in the order of the islands, so that the result does not depend on scheduling.
+        for (std::vector<VariableWidthLines> &paths : island_toolpaths) {
+            if (toolpaths.size() < paths.size())
+                toolpaths.resize(paths.size());
+            for (size_t inset_idx = 0; inset_idx < paths.size(); ++ inset_idx)
+                append(toolpaths[inset_idx], std::move(paths[inset_idx]));
+        }
+    } else
+        generate_island_toolpaths(prepared_outline, toolpaths);
 
     stitchToolPaths(toolpaths, this->bead_width_x);
 
@@ -31,6 +31,9 @@ public:
     float   wall_transition_filter_deviation;
     int     wall_distribution_count;
     bool    is_top_or_bottom_layer;
+    // Generate each island of the outline with its own skeletal graph, the islands in parallel.
+    // Otherwise all islands are generated with a single graph, the tests compare the two.
+    bool    split_islands { true };
 };
 
 WallToolPathsParams make_paths_params(const int layer_id, const PrintObjectConfig &print_object_config, const PrintConfig &print_config);
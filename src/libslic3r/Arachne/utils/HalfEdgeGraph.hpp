@@ -12,6 +12,7 @@
 
 #include "HalfEdge.hpp"
 #include "HalfEdgeNode.hpp"
+#include "libslic3r/NodeArena.hpp"
 
 namespace Slic3r::Arachne
 {
@@ -21,8 +22,22 @@ class HalfEdgeGraph
 public:
     using edge_t = derived_edge_t;
     using node_t = derived_node_t;
-    using Edges = std::list<edge_t>;
-    using Nodes = std::list<node_t>;
+    // The graph has hundreds of thousands of nodes and edges for complex layers, which are all released together
+    // with the graph. They are allocated from an arena owned by the graph, which reuses the memory of the nodes
+    // and edges erased while the graph is built and releases all of it in bulk.
+    using Edges = std::list<edge_t, ArenaAllocator<edge_t>>;
+    using Nodes = std::list<node_t, ArenaAllocator<node_t>>;
+
+    HalfEdgeGraph() : edges(ArenaAllocator<edge_t>(&m_arena)), nodes(ArenaAllocator<node_t>(&m_arena)) {}
+    // The nodes and edges point to each other and to the arena, the graph may not be copied or moved.
+    HalfEdgeGraph(const HalfEdgeGraph &) = delete;
+    HalfEdgeGraph& operator=(const HalfEdgeGraph &) = delete;
+
+private:
+    // Constructed before and destroyed after the lists allocating from it.
+    NodeArena m_arena;
+
+public:
     Edges edges;
     Nodes nodes;
 };
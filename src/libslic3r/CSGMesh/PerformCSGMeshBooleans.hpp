@@ -10,6 +10,8 @@
 //#include "libslic3r/Execution/ExecutionSeq.hpp"
 #include "libslic3r/MeshBoolean.hpp"
 
+#include <boost/log/trivial.hpp>
+
 namespace Slic3r { namespace csg {
     enum class BooleanFailReason { OK, MeshEmpty, NotBoundAVolume, SelfIntersect, NoIntersection};
 
@@ -93,6 +95,38 @@ inline void perform_csg(CSGType op, CGALMeshPtr &dst, CGALMeshPtr &src)
     }
 }
 
+// Merge a batch of meshes to be added to or subtracted from the accumulator into their union
+// by a parallel reduction tree, so that the accumulator is corefined with the merged mesh only once.
+// Returns nullptr if the batch can not be merged, the meshes are then applied one by one.
+inline CGALMeshPtr perform_csg_batch(CSGType op, std::vector<CGALMeshPtr> &meshes)
+{
+    if (op == CSGType::Intersection)
+        return {};
+
+    try {
+        // The first level unites copies, so that the meshes of the batch stay intact if a union fails.
+        // MeshBoolean::cgal::plus() corefines its second argument, which does not change its shape.
+        std::vector<CGALMeshPtr> level((meshes.size() + 1) / 2);
+        execution::for_each(ex_tbb, size_t(0), level.size(), [&meshes, &level](size_t i) {
+            level[i] = MeshBoolean::cgal::clone(*meshes[2 * i]);
+            if (2 * i + 1 < meshes.size())
+                MeshBoolean::cgal::plus(*level[i], *meshes[2 * i + 1]);
+        });
+        while (level.size() > 1) {
+            std::vector<CGALMeshPtr> next((level.size() + 1) / 2);
+            execution::for_each(ex_tbb, size_t(0), next.size(), [&level, &next](size_t i) {
+                next[i] = std::move(level[2 * i]);
+                if (2 * i + 1 < level.size())
+                    MeshBoolean::cgal::plus(*next[i], *level[2 * i + 1]);
+            });
+            level = std::move(next);
+        }
+        return std::move(level.front());
+    } catch (...) {
+        return {};
+    }
+}
+
 template<class Ex, class It>
 std::vector<CGALMeshPtr> get_cgalptrs(Ex policy, const Range<It> &csgrange)
 {
@@ -137,6 +171,15 @@ namespace detail_mcut {
         }
     }
 
+    // The parts are not batched for mcut. MeshBoolean::mcut::do_boolean() splits the accumulator into its connected
+    // components before each operation, because mcut refuses to cut a source mesh of multiple components.
+    // A negative part may split the accumulator, thus merging the negative parts into a single cut mesh would
+    // pass such an accumulator to mcut for the following parts.
+    inline McutMeshPtr perform_csg_batch(CSGType /* op */, std::vector<McutMeshPtr>& /* meshes */)
+    {
+        return {};
+    }
+
     template<class Ex, class It>
     std::vector<McutMeshPtr> get_mcutptrs(Ex policy, const Range<It>& csgrange)
     {
@@ -154,54 +197,100 @@ namespace detail_mcut {
 
 } // namespace mcut_detail
 
-// Process the sequence of CSG parts with CGAL.
-template<class It>
-void perform_csgmesh_booleans_cgal(MeshBoolean::cgal::CGALMeshPtr &cgalm,
-                              const Range<It>                &csgrange)
+namespace detail_booleans {
+
+// Process the sequence of CSG parts on meshes converted to the native representation of a boolean backend.
+// The accumulator stays in that representation for the whole sequence. Consecutive parts with the same
+// operation are collected and handed over to perform_csg_batch(), which may merge them into a single mesh,
+// e.g. all the negative volumes are merged first and subtracted from the accumulator once.
+template<class MeshPtr, class It, class MakeEmptyFn, class PerformFn, class PerformBatchFn>
+void perform_csgmesh_booleans(MeshPtr                 &dst,
+                              const Range<It>         &csgrange,
+                              std::vector<MeshPtr>    &meshes,
+                              MakeEmptyFn            &&make_empty,
+                              PerformFn              &&perform_csg,
+                              PerformBatchFn         &&perform_csg_batch)
 {
-    using MeshBoolean::cgal::CGALMesh;
-    using MeshBoolean::cgal::CGALMeshPtr;
-    using namespace detail_cgal;
-
     struct Frame {
-        CSGType op; CGALMeshPtr cgalptr;
-        explicit Frame(CSGType csgop = CSGType::Union)
+        CSGType op; MeshPtr meshptr;
+        // Meshes waiting to be applied to meshptr with batch_op.
+        CSGType batch_op = CSGType::Union; std::vector<MeshPtr> batch;
+        explicit Frame(MeshPtr &&mesh, CSGType csgop = CSGType::Union)
             : op{ csgop }
-            , cgalptr{ MeshBoolean::cgal::triangle_mesh_to_cgal(indexed_triangle_set{}) }
+            , meshptr{ std::move(mesh) }
         {}
     };
 
-    std::stack opstack{ std::vector<Frame>{} };
+    auto flush = [&perform_csg, &perform_csg_batch](Frame &frame) {
+        if (frame.batch.size() > 1)
+            if (MeshPtr merged = perform_csg_batch(frame.batch_op, frame.batch); merged) {
+                frame.batch.clear();
+                frame.batch.emplace_back(std::move(merged));
+            }
+        for (MeshPtr &src : frame.batch)
+            perform_csg(frame.batch_op, frame.meshptr, src);
+        frame.batch.clear();
+    };
+
+    auto enqueue = [&flush](Frame &frame, CSGType op, MeshPtr &src) {
+        // perform_csg() ignores missing meshes.
+        if (!src)
+            return;
+        if (op != frame.batch_op)
+            flush(frame);
+        frame.batch_op = op;
+        frame.batch.emplace_back(std::move(src));
+    };
 
-    opstack.push(Frame{});
+    std::stack opstack{ std::vector<Frame>{} };
 
-    std::vector<CGALMeshPtr> cgalmeshes = get_cgalptrs(ex_tbb, csgrange);
+    opstack.push(Frame{ make_empty() });
 
     size_t csgidx = 0;
     for (auto& csgpart : csgrange) {
 
         auto op = get_operation(csgpart);
-        CGALMeshPtr& cgalptr = cgalmeshes[csgidx++];
+        MeshPtr& meshptr = meshes[csgidx++];
 
-        if (get_stack_operation(csgpart) == CSGStackOp::Push) {
-            opstack.push(Frame{ op });
-            op = CSGType::Union;
-        }
+        if (get_stack_operation(csgpart) == CSGStackOp::Push)
+            opstack.push(Frame{ make_empty(), op });
 
         Frame* top = &opstack.top();
 
-        perform_csg(get_operation(csgpart), top->cgalptr, cgalptr);
+        enqueue(*top, op, meshptr);
 
         if (get_stack_operation(csgpart) == CSGStackOp::Pop) {
-            CGALMeshPtr src = std::move(top->cgalptr);
+            flush(*top);
+            MeshPtr src = std::move(top->meshptr);
             auto popop = opstack.top().op;
             opstack.pop();
-            CGALMeshPtr& dst = opstack.top().cgalptr;
-            perform_csg(popop, dst, src);
+            enqueue(opstack.top(), popop, src);
         }
     }
 
-    cgalm = std::move(opstack.top().cgalptr);
+    flush(opstack.top());
+    dst = std::move(opstack.top().meshptr);
+}
+
+} // namespace detail_booleans
+
+// Process the sequence of CSG parts with CGAL.
+// cgalmeshes are the parts converted by get_cgalptrs() or check_csgmesh_booleans(), they are consumed.
+template<class It>
+void perform_csgmesh_booleans_cgal(MeshBoolean::cgal::CGALMeshPtr &cgalm,
+                                   const Range<It>                &csgrange,
+                                   std::vector<MeshBoolean::cgal::CGALMeshPtr> &&cgalmeshes)
+{
+    detail_booleans::perform_csgmesh_booleans(cgalm, csgrange, cgalmeshes, [] {
+        return MeshBoolean::cgal::triangle_mesh_to_cgal(indexed_triangle_set{});
+    }, detail_cgal::perform_csg, detail_cgal::perform_csg_batch);
+}
+
+template<class It>
+void perform_csgmesh_booleans_cgal(MeshBoolean::cgal::CGALMeshPtr &cgalm,
+                              const Range<It>                &csgrange)
+{
+    perform_csgmesh_booleans_cgal(cgalm, csgrange, detail_cgal::get_cgalptrs(ex_tbb, csgrange));
 }
 
 // Process the sequence of CSG parts with mcut.
@@ -209,60 +298,27 @@ template<class It>
 void perform_csgmesh_booleans_mcut(MeshBoolean::mcut::McutMeshPtr& mcutm,
     const Range<It>& csgrange)
 {
-    using MeshBoolean::mcut::McutMesh;
-    using MeshBoolean::mcut::McutMeshPtr;
     using namespace detail_mcut;
 
-    struct Frame {
-        CSGType op; McutMeshPtr mcutptr;
-        explicit Frame(CSGType csgop = CSGType::Union)
-            : op{ csgop }
-            , mcutptr{ MeshBoolean::mcut::triangle_mesh_to_mcut(indexed_triangle_set{}) }
-        {}
-    };
-
-    std::stack opstack{ std::vector<Frame>{} };
-
-    opstack.push(Frame{});
-
     std::vector<McutMeshPtr> McutMeshes = get_mcutptrs(ex_tbb, csgrange);
 
-    size_t csgidx = 0;
-    for (auto& csgpart : csgrange) {
-
-        auto op = get_operation(csgpart);
-        McutMeshPtr& mcutptr = McutMeshes[csgidx++];
-
-        if (get_stack_operation(csgpart) == CSGStackOp::Push) {
-            opstack.push(Frame{ op });
-            op = CSGType::Union;
-        }
-
-        Frame* top = &opstack.top();
-
-        perform_csg(get_operation(csgpart), top->mcutptr, mcutptr);
-
-        if (get_stack_operation(csgpart) == CSGStackOp::Pop) {
-            McutMeshPtr src = std::move(top->mcutptr);
-            auto popop = opstack.top().op;
-            opstack.pop();
-            McutMeshPtr& dst = opstack.top().mcutptr;
-            perform_csg(popop, dst, src);
-        }
-    }
-
-    mcutm = std::move(opstack.top().mcutptr);
-    
+    detail_booleans::perform_csgmesh_booleans(mcutm, csgrange, McutMeshes, [] {
+        return MeshBoolean::mcut::triangle_mesh_to_mcut(indexed_triangle_set{});
+    }, detail_mcut::perform_csg, detail_mcut::perform_csg_batch);
 }
 
 
+// Check the parts for booleans with CGAL. The converted parts are returned in cgalmeshes to be passed
+// to perform_csgmesh_booleans() if the check passes, so that the parts are not converted twice.
 template<class It, class Visitor>
-std::tuple<BooleanFailReason,std::string, It> check_csgmesh_booleans(const Range<It> &csgrange, Visitor &&vfn)
+std::tuple<BooleanFailReason,std::string, It> check_csgmesh_booleans(const Range<It> &csgrange, Visitor &&vfn,
+                                                                    std::vector<MeshBoolean::cgal::CGALMeshPtr> &cgalmeshes)
 {
     using namespace detail_cgal;
     BooleanFailReason fail_reason = BooleanFailReason::OK;
     std::string fail_part_name;
-    std::vector<CGALMeshPtr> cgalmeshes(csgrange.size());
+    cgalmeshes.clear();
+    cgalmeshes.resize(csgrange.size());
     auto check_part = [&csgrange, &cgalmeshes,&fail_reason,&fail_part_name](size_t i)
     {
         auto it = csgrange.begin();
@@ -319,6 +375,13 @@ std::tuple<BooleanFailReason,std::string, It> check_csgmesh_booleans(const Range
     return { fail_reason,fail_part_name, ret};
 }
 
+template<class It, class Visitor>
+std::tuple<BooleanFailReason,std::string, It> check_csgmesh_booleans(const Range<It> &csgrange, Visitor &&vfn)
+{
+    std::vector<MeshBoolean::cgal::CGALMeshPtr> cgalmeshes;
+    return check_csgmesh_booleans(csgrange, std::forward<Visitor>(vfn), cgalmeshes);
+}
+
 template<class It>
 std::tuple<BooleanFailReason, std::string, It> check_csgmesh_booleans(const Range<It> &csgrange, bool use_mcut=false)
 {
@@ -367,6 +430,15 @@ MeshBoolean::cgal::CGALMeshPtr perform_csgmesh_booleans(const Range<It> &csgpart
     return ret;
 }
 
+// Perform the booleans on the parts already converted by check_csgmesh_booleans().
+template<class It>
+MeshBoolean::cgal::CGALMeshPtr perform_csgmesh_booleans(const Range<It> &csgparts, std::vector<MeshBoolean::cgal::CGALMeshPtr> &&cgalmeshes)
+{
+    MeshBoolean::cgal::CGALMeshPtr ret;
+    perform_csgmesh_booleans_cgal(ret, csgparts, std::move(cgalmeshes));
+    return ret;
+}
+
 template<class It>
 MeshBoolean::mcut::McutMeshPtr  perform_csgmesh_booleans_mcut(const Range<It>& csgparts)
 {
@@ -814,6 +814,64 @@ Slic3r::ExPolygons union_ex(const Slic3r::ExPolygons& poly1, const Slic3r::ExPol
     return union_ex(expolys);
 }
 
+ClipperChain::ClipperChain(const Slic3r::Polygons &polygons)
+{
+    m_paths.reserve(polygons.size());
+    for (const Polygon &polygon : polygons)
+        m_paths.emplace_back(polygon.points);
+}
+
+ClipperChain::ClipperChain(const Slic3r::ExPolygons &expolygons)
+{
+    m_paths.reserve(number_polygons(expolygons));
+    for (const ExPolygon &expolygon : expolygons) {
+        m_paths.emplace_back(expolygon.contour.points);
+        for (const Polygon &hole : expolygon.holes)
+            m_paths.emplace_back(hole.points);
+    }
+}
+
+ClipperChain ClipperChain::offset(const Slic3r::ExPolygons &expolygons, const float delta, ClipperLib::JoinType joinType, double miterLimit)
+    { return ClipperChain(expolygons_offset(expolygons, delta, joinType, miterLimit)); }
+
+ClipperChain& ClipperChain::offset(const float delta, ClipperLib::JoinType joinType, double miterLimit)
+{
+    m_paths = offset_paths<ClipperLib::Paths>(m_paths, delta, joinType, miterLimit);
+    return *this;
+}
+
+ClipperChain& ClipperChain::diff(const ClipperChain &clip, ApplySafetyOffset do_safety_offset)
+{
+    m_paths = clipper_do<ClipperLib::Paths>(ClipperLib::ctDifference, m_paths, clip.m_paths, ClipperLib::pftNonZero, do_safety_offset);
+    return *this;
+}
+
+ClipperChain& ClipperChain::intersection(const ClipperChain &clip, ApplySafetyOffset do_safety_offset)
+{
+    m_paths = clipper_do<ClipperLib::Paths>(ClipperLib::ctIntersection, m_paths, clip.m_paths, ClipperLib::pftNonZero, do_safety_offset);
+    return *this;
+}
+
+ClipperChain& ClipperChain::union_(const ClipperChain &other)
+{
+    m_paths = clipper_do<ClipperLib::Paths>(ClipperLib::ctUnion, m_paths, other.m_paths, ClipperLib::pftNonZero);
+    return *this;
+}
+
+Slic3r::ExPolygons ClipperChain::offset_ex(const float delta, ClipperLib::JoinType joinType, double miterLimit) const
+    { return PolyTreeToExPolygons(offset_paths<ClipperLib::PolyTree>(m_paths, delta, joinType, miterLimit)); }
+Slic3r::ExPolygons ClipperChain::diff_ex(const ClipperChain &clip, ApplySafetyOffset do_safety_offset) const
+    { return _clipper_ex(ClipperLib::ctDifference, m_paths, clip.m_paths, do_safety_offset); }
+Slic3r::ExPolygons ClipperChain::intersection_ex(const ClipperChain &clip, ApplySafetyOffset do_safety_offset) const
+    { return _clipper_ex(ClipperLib::ctIntersection, m_paths, clip.m_paths, do_safety_offset); }
+Slic3r::ExPolygons ClipperChain::union_ex() const
+    { return _clipper_ex(ClipperLib::ctUnion, m_paths, ClipperUtils::EmptyPathsProvider(), ApplySafetyOffset::No); }
+
+Slic3r::Polygons ClipperChain::polygons() const &
+    { return to_polygons(m_paths); }
+Slic3r::Polygons ClipperChain::polygons() &&
+    { return to_polygons(std::move(m_paths)); }
+
 Slic3r::ExPolygons xor_ex(const Slic3r::ExPolygons &subject, const Slic3r::ExPolygon &clip, ApplySafetyOffset do_safety_offset) {
     return _clipper_ex(ClipperLib::ctXor, ClipperUtils::ExPolygonsProvider(subject), ClipperUtils::ExPolygonProvider(clip), do_safety_offset);
 }
@@ -395,6 +395,44 @@ Slic3r::ExPolygons offset2_ex(const Slic3r::Surfaces &surfaces, const float delt
 Slic3r::ExPolygons _clipper_ex(ClipperLib::ClipType clipType,
     const Slic3r::Polygons &subject, const Slic3r::Polygons &clip, bool safety_offset_ = false);
 
+// Chain of offsets and boolean operations keeping the intermediate results in the ClipperLib representation.
+// Slic3r geometry is converted to ClipperLib paths once at the start of the chain and the result of the chain
+// is converted back once at its end.
+// The operations follow the semantics of the free functions of the same names, e.g.
+//      ClipperChain::offset(expolygons, delta1).offset_ex(delta2) == offset2_ex(expolygons, delta1, delta2).
+// Input polygons for negative offset shall be "normalized": There must be no overlap / intersections between the input polygons.
+class ClipperChain
+{
+public:
+    ClipperChain() = default;
+    explicit ClipperChain(ClipperLib::Paths &&paths) : m_paths(std::move(paths)) {}
+    explicit ClipperChain(const Slic3r::Polygons &polygons);
+    explicit ClipperChain(const Slic3r::ExPolygons &expolygons);
+
+    // Offset the ExPolygons one by one, see offset(const ExPolygons&, ...).
+    static ClipperChain offset(const Slic3r::ExPolygons &expolygons, const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit);
+
+    // Offset the paths of the chain in place, see offset(const Polygons&, ...).
+    ClipperChain&      offset(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit);
+    ClipperChain&      diff(const ClipperChain &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperChain&      intersection(const ClipperChain &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No);
+    ClipperChain&      union_(const ClipperChain &other);
+
+    // Final operations of a chain producing ExPolygons directly from the ClipperLib::PolyTree, sparing an additional union.
+    Slic3r::ExPolygons offset_ex(const float delta, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit) const;
+    Slic3r::ExPolygons diff_ex(const ClipperChain &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No) const;
+    Slic3r::ExPolygons intersection_ex(const ClipperChain &clip, ApplySafetyOffset do_safety_offset = ApplySafetyOffset::No) const;
+    Slic3r::ExPolygons union_ex() const;
+
+    bool                     empty() const { return m_paths.empty(); }
+    const ClipperLib::Paths& paths() const { return m_paths; }
+    Slic3r::Polygons         polygons() const &;
+    Slic3r::Polygons         polygons() &&;
+
+private:
+    ClipperLib::Paths m_paths;
+};
+
 
 // Offset outside, then inside produces morphological closing. All deltas should be positive.
 Slic3r::Polygons          closing(const Slic3r::Polygons &polygons, const float delta1, const float delta2, ClipperLib::JoinType joinType = DefaultJoinType, double miterLimit = DefaultMiterLimit);
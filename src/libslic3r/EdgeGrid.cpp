@@ -140,6 +140,7 @@ void EdgeGrid::Grid::create(const ExPolygons &expolygons, coord_t resolution)
 void EdgeGrid::Grid::create_from_m_contours(coord_t resolution)
 {
 	assert(resolution > 0);
+	m_cell_segments.clear();
 	// 1) Measure the bounding box.
 	for (const Contour &contour : m_contours) {
 		assert(contour.num_segments() > 0);
@@ -1278,6 +1279,160 @@ bool EdgeGrid::Grid::signed_distance(const Point &pt, coord_t search_radius, coo
 	return true;
 }
 
+void EdgeGrid::Grid::create_batch_query_data()
+{
+	m_cell_segments.clear();
+	const size_t num_cell_data = m_cell_data.size();
+	for (std::vector<double> *v : { &m_cell_segments.ax, &m_cell_segments.ay, &m_cell_segments.vx, &m_cell_segments.vy, &m_cell_segments.inv_l2 })
+		v->resize(num_cell_data);
+	for (size_t i = 0; i < num_cell_data; ++ i) {
+		std::pair<const Slic3r::Point&, const Slic3r::Point&> segment = this->segment(m_cell_data[i]);
+		m_cell_segments.ax[i] = double(segment.first.x());
+		m_cell_segments.ay[i] = double(segment.first.y());
+		m_cell_segments.vx[i] = double(segment.second.x() - segment.first.x());
+		m_cell_segments.vy[i] = double(segment.second.y() - segment.first.y());
+		const double l2 = sqr(m_cell_segments.vx[i]) + sqr(m_cell_segments.vy[i]);
+		m_cell_segments.inv_l2[i] = l2 > 0. ? 1. / l2 : 0.;
+	}
+}
+
+std::vector<EdgeGrid::Grid::ClosestPointResult> EdgeGrid::Grid::closest_points_signed_distance(const Points &pts, coord_t search_radius) const
+{
+	std::vector<ClosestPointResult> out;
+	out.reserve(pts.size());
+	if (m_cell_segments.empty()) {
+		for (const Point &pt : pts)
+			out.emplace_back(this->closest_point_signed_distance(pt, search_radius));
+		return out;
+	}
+
+	const double *ax = m_cell_segments.ax.data();
+	const double *ay = m_cell_segments.ay.data();
+	const double *vx = m_cell_segments.vx.data();
+	const double *vy = m_cell_segments.vy.data();
+	const double *inv_l2 = m_cell_segments.inv_l2.data();
+	// Squared distances of the point to the edges of the cells in search_radius.
+	std::vector<double> edge_d2;
+
+	for (const Point &pt : pts) {
+		ClosestPointResult &result = out.emplace_back();
+		// Cells in search_radius, the same as closest_point_signed_distance() traverses.
+		BoundingBox bbox;
+		bbox.min = bbox.max = Point(pt(0) - m_bbox.min(0), pt(1) - m_bbox.min(1));
+		bbox.max(0) += search_radius;
+		bbox.max(1) += search_radius;
+		if (bbox.max(0) < 0 || bbox.max(1) < 0)
+			continue;
+		bbox.max(0) = std::min<coord_t>(bbox.max(0) / m_resolution, m_cols - 1);
+		bbox.max(1) = std::min<coord_t>(bbox.max(1) / m_resolution, m_rows - 1);
+		bbox.min(0) = std::max<coord_t>(bbox.min(0) - search_radius, 0) / m_resolution;
+		bbox.min(1) = std::max<coord_t>(bbox.min(1) - search_radius, 0) / m_resolution;
+		if (bbox.min(0) > bbox.max(0) || bbox.min(1) > bbox.max(1))
+			continue;
+
+		// 1) Distances to the edges as segments, which are lower bounds of the distances to the edges or to their
+		// start points as evaluated by closest_point_signed_distance(). Vectorized: the parameter of the foot point
+		// is clamped to <0, 1> by abs() and not by comparisons, which would not be if-converted with trapping math.
+		const double ptx = double(pt.x());
+		const double pty = double(pt.y());
+		edge_d2.clear();
+		for (coord_t r = bbox.min(1); r <= bbox.max(1); ++ r)
+			for (coord_t c = bbox.min(0); c <= bbox.max(0); ++ c) {
+				const Cell &cell = m_cells[r * m_cols + c];
+				const size_t offset = edge_d2.size();
+				edge_d2.resize(offset + cell.end - cell.begin);
+				double *d2 = edge_d2.data() + offset;
+				for (size_t i = cell.begin; i < cell.end; ++ i) {
+					const double v_pt_x = ptx - ax[i];
+					const double v_pt_y = pty - ay[i];
+					double       t      = (vx[i] * v_pt_x + vy[i] * v_pt_y) * inv_l2[i];
+					t = 0.5 * (t + std::abs(t));
+					t = 0.5 * (t + 1. - std::abs(t - 1.));
+					const double dx = v_pt_x - t * vx[i];
+					const double dy = v_pt_y - t * vy[i];
+					d2[i - cell.begin] = dx * dx + dy * dy;
+				}
+			}
+		double d2_lower_bound = std::numeric_limits<double>::max();
+		for (double d2 : edge_d2)
+			d2_lower_bound = std::min(d2_lower_bound, d2);
+
+		// 2) Evaluate exactly the edges not farther than d_limit in the order of closest_point_signed_distance(),
+		// which resolves the ties the same way. The edges farther than the closest one do not change the result.
+		// A few units of slack cover the rounding errors of the lower bounds.
+		double d_min;
+		int    sign_min;
+		double l2_seg_min;
+		auto   evaluate = [this, &pt, &edge_d2, &bbox, &result, &d_min, &sign_min, &l2_seg_min](const double d_limit) {
+			result     = ClosestPointResult();
+			d_min      = d_limit;
+			sign_min   = 0;
+			l2_seg_min = 1.;
+			const double *d2 = edge_d2.data();
+			for (coord_t r = bbox.min(1); r <= bbox.max(1); ++ r)
+				for (coord_t c = bbox.min(0); c <= bbox.max(0); ++ c) {
+					const Cell &cell = m_cells[r * m_cols + c];
+					for (size_t i = cell.begin; i < cell.end; ++ i, ++ d2)
+						if (*d2 <= (d_min + 2.) * (d_min + 2.)) {
+							const size_t         contour_idx = m_cell_data[i].first;
+							const size_t         ipt         = m_cell_data[i].second;
+							const Contour       &contour     = m_contours[contour_idx];
+							const Slic3r::Point &p1          = contour.segment_start(ipt);
+							const Slic3r::Point  v_seg       = contour.segment_end(ipt) - p1;
+							const Slic3r::Point  v_pt        = pt - p1;
+							const int64_t        t_pt        = int64_t(v_seg(0)) * int64_t(v_pt(0)) + int64_t(v_seg(1)) * int64_t(v_pt(1));
+							const int64_t        l2_seg      = int64_t(v_seg(0)) * int64_t(v_seg(0)) + int64_t(v_seg(1)) * int64_t(v_seg(1));
+							if (t_pt < 0) {
+								// Closest to p1.
+								double dabs = sqrt(int64_t(v_pt(0)) * int64_t(v_pt(0)) + int64_t(v_pt(1)) * int64_t(v_pt(1)));
+								if (dabs < d_min) {
+									const Slic3r::Point v_seg_prev = p1 - contour.segment_prev(ipt);
+									if (int64_t(v_seg_prev(0)) * int64_t(v_pt(0)) + int64_t(v_seg_prev(1)) * int64_t(v_pt(1)) > 0) {
+										// Inside the wedge between the previous and the next segment.
+										d_min                  = dabs;
+										sign_min               = int64_t(v_seg_prev(0)) * int64_t(v_seg(1)) - int64_t(v_seg_prev(1)) * int64_t(v_seg(0)) > 0 ? 1 : -1;
+										result.contour_idx     = contour_idx;
+										result.start_point_idx = ipt;
+										result.t               = 0.;
+									}
+								}
+							} else if (t_pt <= l2_seg) {
+								// Closest to the segment. If closest to p2, then p2 is the starting point of another segment.
+								int64_t d_seg = int64_t(v_seg(1)) * int64_t(v_pt(0)) - int64_t(v_seg(0)) * int64_t(v_pt(1));
+								double  dabs  = std::abs(double(d_seg) / sqrt(double(l2_seg)));
+								if (dabs < d_min) {
+									d_min                  = dabs;
+									sign_min               = (d_seg < 0) ? -1 : ((d_seg == 0) ? 0 : 1);
+									l2_seg_min             = l2_seg;
+									result.contour_idx     = contour_idx;
+									result.start_point_idx = ipt;
+									result.t               = t_pt;
+								}
+							}
+						}
+				}
+		};
+		if (d2_lower_bound > (double(search_radius) + 2.) * (double(search_radius) + 2.))
+			// No edge in search_radius.
+			continue;
+		if (const double d_closest = std::sqrt(d2_lower_bound) + 2.; d_closest < double(search_radius)) {
+			evaluate(d_closest + 2.);
+			if (result.contour_idx == size_t(-1) || d_min > d_closest)
+				// The closest edge was rejected, for example the point is outside the wedge of its closest vertex.
+				// The closest accepted edge may be farther than d_limit, evaluate the edges up to search_radius.
+				evaluate(double(search_radius));
+		} else
+			evaluate(double(search_radius));
+		if (result.contour_idx != size_t(-1) && d_min <= double(search_radius)) {
+			result.distance = d_min * sign_min;
+			result.t /= l2_seg_min;
+			assert(result.t >= 0. && result.t <= 1.);
+		} else
+			result = ClosestPointResult();
+	}
+	return out;
+}
+
 Polygons EdgeGrid::Grid::contours_simplified(coord_t offset, bool fill_holes) const
 {
 	assert(std::abs(2 * offset) < m_resolution);
@@ -156,6 +156,17 @@ public:
 	// Only call this function for closed contours!
 	bool signed_distance(const Point &pt, coord_t search_radius, coordf_t &result_min_dist) const;
 
+	// Batch query over many points. Once create_batch_query_data() was called, it culls the edges of each
+	// visited cell over a structure of arrays copy of the cell contents, in loops written without branches,
+	// so that they vectorize (SSE2, AVX2 or NEON, depending on the target). Only the edges passing the
+	// conservative culling are evaluated exactly, thus the results are the same as of the single point
+	// query, which is used if there is no batch query data. create() drops the batch query data.
+	void create_batch_query_data();
+	bool has_batch_query_data() const { return ! m_cell_segments.empty(); }
+
+	// Batch closest_point_signed_distance(). Only call this function for closed contours!
+	std::vector<ClosestPointResult> closest_points_signed_distance(const Points &pts, coord_t search_radius) const;
+
 	const BoundingBox& 	bbox() const { return m_bbox; }
 	const coord_t 		resolution() const { return m_resolution; }
 	const size_t		rows() const { return m_rows; }
@@ -400,6 +411,19 @@ protected:
 	// Distance field derived from the edge grid, seed filled by the Danielsson chamfer metric.
 	// May be empty.
 	std::vector<float>							m_signed_distance_field;
+
+	// Structure of arrays copy of the edges referenced by m_cell_data, in the same order, for the batch query.
+	// Stored as doubles, which vectorize on all targets, unlike 64bit integer multiplication. May be empty.
+	struct CellSegments {
+		// Start points of the edges and the vectors from the start to the end points.
+		std::vector<double> ax, ay, vx, vy;
+		// Inverse squared lengths of the edges, zero for zero length edges.
+		std::vector<double> inv_l2;
+
+		bool empty() const { return ax.empty(); }
+		void clear() { ax.clear(); ay.clear(); vx.clear(); vy.clear(); inv_l2.clear(); }
+	};
+	CellSegments								m_cell_segments;
 };
 
 // Debugging utility. Save the signed distance field.
@@ -85,6 +85,11 @@ void ExtrusionEntityCollection::remove(size_t i)
 }
 
 ExtrusionEntityCollection ExtrusionEntityCollection::chained_path_from(const ExtrusionEntitiesPtr& extrusion_entities, const Point &start_near, ExtrusionRole role)
+{
+	return chained_path_from(extrusion_entities, start_near, role, ChainingParams());
+}
+
+ExtrusionEntityCollection ExtrusionEntityCollection::chained_path_from(const ExtrusionEntitiesPtr& extrusion_entities, const Point &start_near, ExtrusionRole role, const ChainingParams &params)
 {
 	// Return a filtered copy of the collection.
     ExtrusionEntityCollection out;
@@ -92,7 +97,7 @@ ExtrusionEntityCollection ExtrusionEntityCollection::chained_path_from(const Ext
 	// Clone the extrusion entities.
 	for (auto &ptr : out.entities)
 		ptr = ptr->clone();
-	chain_and_reorder_extrusion_entities(out.entities, &start_near);
+	chain_and_reorder_extrusion_entities(out.entities, &start_near, params);
     return out;
 }
 
@@ -7,6 +7,8 @@
 
 namespace Slic3r {
 
+struct ChainingParams;
+
 // Remove those items from extrusion_entities, that do not match role.
 // Do nothing if role is mixed.
 // Removed elements are NOT being deleted.
@@ -115,8 +117,11 @@ public:
     void replace(size_t i, const ExtrusionEntity &entity);
     void remove(size_t i);
     static ExtrusionEntityCollection chained_path_from(const ExtrusionEntitiesPtr &extrusion_entities, const Point &start_near, ExtrusionRole role = erMixed);
+    static ExtrusionEntityCollection chained_path_from(const ExtrusionEntitiesPtr &extrusion_entities, const Point &start_near, ExtrusionRole role, const ChainingParams &params);
     ExtrusionEntityCollection chained_path_from(const Point &start_near, ExtrusionRole role = erMixed) const 
     	{ return this->no_sort ? *this : chained_path_from(this->entities, start_near, role); }
+    ExtrusionEntityCollection chained_path_from(const Point &start_near, ExtrusionRole role, const ChainingParams &params) const
+    	{ return this->no_sort ? *this : chained_path_from(this->entities, start_near, role, params); }
     void reverse() override;
     const Point& first_point() const override { return this->entities.front()->first_point(); }
     const Point& last_point() const override { return this->entities.back()->last_point(); }
@@ -1439,15 +1439,20 @@ BoundaryInfillGraph create_boundary_infill_graph(const Polylines &infill_ordered
             EdgeGrid::Grid grid;
             grid.set_bbox(bbox.inflated(SCALED_EPSILON));
             grid.create(boundary_src, coord_t(scale_(10.)));
+            grid.create_batch_query_data();
+            Points end_points;
+            end_points.reserve(infill_ordered.size() * 2);
+            for (const Polyline &pl : infill_ordered) {
+                end_points.emplace_back(pl.points.front());
+                end_points.emplace_back(pl.points.back());
+            }
+            std::vector<EdgeGrid::Grid::ClosestPointResult> closest_points = grid.closest_points_signed_distance(end_points, coord_t(SCALED_EPSILON));
             intersection_points.reserve(infill_ordered.size() * 2);
-            for (const Polyline &pl : infill_ordered)
-                for (const Point *pt : { &pl.points.front(), &pl.points.back() }) {
-                    EdgeGrid::Grid::ClosestPointResult cp = grid.closest_point_signed_distance(*pt, coord_t(SCALED_EPSILON));
-                    if (cp.valid()) {
-                        // The infill end point shall lie on the contour.
-                        assert(cp.distance <= 3.);
-                        intersection_points.emplace_back(cp, (&pl - infill_ordered.data()) * 2 + (pt == &pl.points.front() ? 0 : 1));
-                    }
+            for (size_t end_point_idx = 0; end_point_idx < closest_points.size(); ++ end_point_idx)
+                if (const EdgeGrid::Grid::ClosestPointResult &cp = closest_points[end_point_idx]; cp.valid()) {
+                    // The infill end point shall lie on the contour.
+                    assert(cp.distance <= 3.);
+                    intersection_points.emplace_back(cp, end_point_idx);
                 }
             std::sort(intersection_points.begin(), intersection_points.end(), [](const std::pair<EdgeGrid::Grid::ClosestPointResult, size_t> &cp1, const std::pair<EdgeGrid::Grid::ClosestPointResult, size_t> &cp2) {
                 return   cp1.first.contour_idx < cp2.first.contour_idx ||
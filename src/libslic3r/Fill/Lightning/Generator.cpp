@@ -2,6 +2,7 @@
 //CuraEngine is released under the terms of the AGPLv3 or higher.
 
 #include "Generator.hpp"
+#include "DistanceField.hpp"
 #include "TreeNode.hpp"
 
 #include "../../ClipperUtils.hpp"
@@ -10,6 +11,8 @@
 
 #include "ExPolygon.hpp"
 
+#include <tbb/parallel_for.h>
+
 /* Possible future tasks/optimizations,etc.:
  * - Improve connecting heuristic to favor connecting to shorter trees
  * - Change which node of a tree is the root when that would be better in reconnectRoots.
@@ -95,8 +98,9 @@ Generator::Generator(const PrintObject &print_object, const std::function<void()
     m_prune_length                                    = coord_t(layer_thickness * std::tan(lightning_infill_prune_angle));
     m_straightening_max_distance                      = coord_t(layer_thickness * std::tan(lightning_infill_straightening_angle));
 
-    generateInitialInternalOverhangs(print_object, throw_on_cancel_callback);
-    generateTrees(print_object, throw_on_cancel_callback);
+    const std::vector<Polygons> infill_outlines = collectInfillOutlines(print_object, throw_on_cancel_callback);
+    generateInitialInternalOverhangs(infill_outlines, throw_on_cancel_callback);
+    generateTrees(infill_outlines, throw_on_cancel_callback);
 }
 
 Generator::Generator(PrintObject* m_object, std::vector<Polygons>& contours, std::vector<Polygons>& overhangs, const std::function<void()> &throw_on_cancel_callback, float density)
@@ -137,7 +141,7 @@ Generator::Generator(PrintObject* m_object, std::vector<Polygons>& contours, std
 
     m_overhang_per_layer = overhangs;
 
-    generateTreesforSupport(contours, throw_on_cancel_callback);
+    generateTrees(contours, throw_on_cancel_callback);
 
     //for (size_t i = 0; i < overhangs.size(); i++)
     //{
@@ -147,26 +151,37 @@ Generator::Generator(PrintObject* m_object, std::vector<Polygons>& contours, std
     //}
 }
 
-void Generator::generateInitialInternalOverhangs(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
+std::vector<Polygons> Generator::collectInfillOutlines(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
 {
-    m_overhang_per_layer.resize(print_object.layers().size());
-
-    Polygons infill_area_above;
-    //Iterate from top to bottom, to subtract the overhang areas above from the overhang areas on the layer below, to get only overhang in the top layer where it is overhanging.
-    for (int layer_nr = int(print_object.layers().size()) - 1; layer_nr >= 0; --layer_nr) {
-        throw_on_cancel_callback();
-        Polygons infill_area_here;
-        for (const LayerRegion* layerm : print_object.get_layer(layer_nr)->regions())
-            for (const Surface& surface : layerm->fill_surfaces.surfaces)
-                if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
-                    append(infill_area_here, to_polygons(surface.expolygon));
-
-        //Remove the part of the infill area that is already supported by the walls.
-        Polygons overhang = diff(offset(infill_area_here, -float(m_wall_supporting_radius)), infill_area_above);
+    std::vector<Polygons> infill_outlines(print_object.layers().size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, print_object.layers().size()), [&print_object, &infill_outlines, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+        for (size_t layer_id = range.begin(); layer_id < range.end(); ++layer_id) {
+            throw_on_cancel_callback();
+            for (const LayerRegion *layerm : print_object.get_layer(int(layer_id))->regions())
+                for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                    if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
+                        append(infill_outlines[layer_id], to_polygons(surface.expolygon));
+        }
+    });
+    return infill_outlines;
+}
 
-        m_overhang_per_layer[layer_nr] = overhang;
-        infill_area_above = std::move(infill_area_here);
-    }
+void Generator::generateInitialInternalOverhangs(const std::vector<Polygons> &infill_outlines, const std::function<void()> &throw_on_cancel_callback)
+{
+    m_overhang_per_layer.assign(infill_outlines.size(), Polygons());
+
+    // Subtract the infill area above from the overhang areas on the layer below, to get only overhang in the top layer where it is overhanging.
+    // The overhang of a layer only depends on the infill areas of that layer and of the layer above, thus the layers are processed in parallel.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, infill_outlines.size()), [this, &infill_outlines, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+        for (size_t layer_nr = range.begin(); layer_nr < range.end(); ++layer_nr) {
+            throw_on_cancel_callback();
+            //Remove the part of the infill area that is already supported by the walls.
+            Polygons overhang = offset(infill_outlines[layer_nr], -float(m_wall_supporting_radius));
+            if (layer_nr + 1 < infill_outlines.size())
+                overhang = diff(overhang, infill_outlines[layer_nr + 1]);
+            m_overhang_per_layer[layer_nr] = std::move(overhang);
+        }
+    });
 }
 
 const Layer& Generator::getTreesForLayer(const size_t& layer_id) const
@@ -175,40 +190,159 @@ const Layer& Generator::getTreesForLayer(const size_t& layer_id) const
     return m_lightning_layers[layer_id];
 }
 
-void Generator::generateTrees(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback)
+// An island of the infill area of a layer. Islands are disjoint, thus the trees of an island never ground
+// on the trees of another island and the islands of a layer grow their new trees independently.
+struct LayerIsland
 {
-    const auto _locator_cell_size = locator_cell_size();
-    m_lightning_layers.resize(print_object.layers().size());
-    bboxs.resize(print_object.layers().size());
-    std::vector<Polygons> infill_outlines(print_object.layers().size(), Polygons());
+    ExPolygon   area;
+    BoundingBox bbox;
+    Polygons    outlines;
+    // Only allocated if the island has an overhang to support.
+    std::unique_ptr<DistanceField> distance_field;
+};
+
+// Index of the island containing the point or, if there is none, of the island with the closest boundary.
+static size_t closest_island(const std::vector<LayerIsland> &islands, const Point &pt)
+{
+    size_t closest_idx = std::numeric_limits<size_t>::max();
+    double closest_d2  = std::numeric_limits<double>::max();
+    for (size_t island_idx = 0; island_idx < islands.size(); ++island_idx) {
+        const LayerIsland &island = islands[island_idx];
+        if (island.bbox.contains(pt) && island.area.contains(pt))
+            return island_idx;
+        for (size_t icontour = 0; icontour <= island.area.holes.size(); ++icontour) {
+            const Polygon &contour = icontour == 0 ? island.area.contour : island.area.holes[icontour - 1];
+            if (contour.size() > 2) {
+                Point prev = contour.points.back();
+                for (const Point &p2 : contour.points) {
+                    if (double d2 = Line::distance_to_squared(pt, prev, p2); d2 < closest_d2) {
+                        closest_d2  = d2;
+                        closest_idx = island_idx;
+                    }
+                    prev = p2;
+                }
+            }
+        }
+    }
+    return closest_idx;
+}
 
-    // For-each layer from top to bottom:
-    for (int layer_id = int(print_object.layers().size()) - 1; layer_id >= 0; layer_id--) {
-        throw_on_cancel_callback();
-        for (const LayerRegion *layerm : print_object.get_layer(layer_id)->regions())
-            for (const Surface &surface : layerm->fill_surfaces.surfaces)
-                if (surface.surface_type == stInternal || surface.surface_type == stInternalVoid)
-                    append(infill_outlines[layer_id], to_polygons(surface.expolygon));
+// Split the infill area of a layer into islands and sample the overhang of each island into its own distance field.
+// This only depends on the outlines and the overhang of the layer itself, not on the trees propagated from the layer above.
+static std::vector<LayerIsland> make_layer_islands(const Polygons &outlines, const Polygons &overhang, const coord_t supporting_radius)
+{
+    std::vector<LayerIsland> islands;
+    if (overhang.empty())
+        // Nothing to support, no new trees will be grown on this layer.
+        return islands;
+
+    ExPolygons areas = union_ex(outlines);
+    islands.reserve(areas.size());
+    for (ExPolygon &area : areas) {
+        LayerIsland &island = islands.emplace_back();
+        island.bbox         = get_extents(area.contour);
+        island.area         = std::move(area);
     }
 
+    std::vector<Polygons> island_overhangs(islands.size());
+    for (ExPolygon &overhang_area : union_ex(overhang))
+        if (size_t island_idx = closest_island(islands, overhang_area.contour.points.front()); island_idx != std::numeric_limits<size_t>::max())
+            append(island_overhangs[island_idx], to_polygons(std::move(overhang_area)));
+
+    for (size_t island_idx = 0; island_idx < islands.size(); ++island_idx)
+        if (! island_overhangs[island_idx].empty()) {
+            LayerIsland &island = islands[island_idx];
+            island.outlines     = to_polygons(island.area);
+            BoundingBox bbox    = island.bbox;
+            bbox.merge(get_extents(island_overhangs[island_idx]));
+            island.distance_field = std::make_unique<DistanceField>(supporting_radius, island.outlines, bbox, island_overhangs[island_idx]);
+        }
+
+    return islands;
+}
+
+// Grow the new trees of a layer, the islands in parallel.
+static void generate_new_trees(
+    Layer                       &current_lightning_layer,
+    std::vector<LayerIsland>    &islands,
+    const BoundingBox           &current_outlines_bbox,
+    const EdgeGrid::Grid        &outlines_locator,
+    const coord_t                supporting_radius,
+    const coord_t                wall_supporting_radius,
+    const std::function<void()> &throw_on_cancel_callback)
+{
+    if (islands.empty())
+        return;
+
+    // Hand each tree propagated from the layer above over to the island it is rooted in, so that every tree
+    // is only ever extended by a single island.
+    std::vector<Layer>    island_layers(islands.size());
+    std::vector<NodeSPtr> unassigned_tree_roots;
+    for (NodeSPtr &root : current_lightning_layer.tree_roots)
+        if (size_t island_idx = closest_island(islands, root->getLocation()); island_idx != std::numeric_limits<size_t>::max())
+            island_layers[island_idx].tree_roots.emplace_back(std::move(root));
+        else
+            unassigned_tree_roots.emplace_back(std::move(root));
+    current_lightning_layer.tree_roots = std::move(unassigned_tree_roots);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, islands.size(), 1), [&islands, &island_layers, &current_outlines_bbox, &outlines_locator, supporting_radius, wall_supporting_radius, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+        for (size_t island_idx = range.begin(); island_idx < range.end(); ++island_idx)
+            if (LayerIsland &island = islands[island_idx]; island.distance_field) {
+                island_layers[island_idx].generateNewTrees(*island.distance_field, island.outlines, current_outlines_bbox, outlines_locator, supporting_radius, wall_supporting_radius, throw_on_cancel_callback);
+                // Not needed anymore, release the memory early.
+                island.distance_field.reset();
+            }
+    });
+
+    for (Layer &island_layer : island_layers)
+        append(current_lightning_layer.tree_roots, std::move(island_layer.tree_roots));
+}
+
+void Generator::generateTrees(const std::vector<Polygons> &infill_outlines, const std::function<void()> &throw_on_cancel_callback)
+{
+    if (infill_outlines.empty())
+        return;
+
+    const auto _locator_cell_size = locator_cell_size();
+    m_lightning_layers.resize(infill_outlines.size());
+    bboxs.resize(infill_outlines.size());
+
     // For various operations its beneficial to quickly locate nearby features on the polygon:
-    const size_t top_layer_id = print_object.layers().size() - 1;
+    const size_t top_layer_id = infill_outlines.size() - 1;
     EdgeGrid::Grid outlines_locator(get_extents(infill_outlines[top_layer_id]).inflated(SCALED_EPSILON));
     outlines_locator.create(infill_outlines[top_layer_id], _locator_cell_size);
 
+    // The islands and their distance fields do not depend on the trees of the layer above. They are prepared in parallel
+    // for a batch of layers at a time, which bounds the memory held by the distance fields of the layers not grown yet.
+    const size_t                          prepare_batch_size = std::max<size_t>(8, 2 * tbb::this_task_arena::max_concurrency());
+    std::vector<std::vector<LayerIsland>> islands_per_layer(infill_outlines.size());
+    size_t                                first_prepared_layer_id = infill_outlines.size();
+
     // For-each layer from top to bottom:
     for (int layer_id = int(top_layer_id); layer_id >= 0; layer_id--) {
         throw_on_cancel_callback();
+        if (size_t(layer_id) < first_prepared_layer_id) {
+            const size_t batch_begin = first_prepared_layer_id - std::min(first_prepared_layer_id, prepare_batch_size);
+            tbb::parallel_for(tbb::blocked_range<size_t>(batch_begin, first_prepared_layer_id, 1), [this, &infill_outlines, &islands_per_layer, &throw_on_cancel_callback](const tbb::blocked_range<size_t> &range) {
+                for (size_t prepared_layer_id = range.begin(); prepared_layer_id < range.end(); ++prepared_layer_id) {
+                    throw_on_cancel_callback();
+                    islands_per_layer[prepared_layer_id] = make_layer_islands(infill_outlines[prepared_layer_id], m_overhang_per_layer[prepared_layer_id], m_supporting_radius);
+                }
+            });
+            first_prepared_layer_id = batch_begin;
+        }
+
         Layer             &current_lightning_layer = m_lightning_layers[layer_id];
         const Polygons    &current_outlines        = infill_outlines[layer_id];
         const BoundingBox &current_outlines_bbox   = get_extents(current_outlines);
 
-        bboxs[layer_id] = get_extents(current_outlines);
+        bboxs[layer_id] = current_outlines_bbox;
 
         // register all trees propagated from the previous layer as to-be-reconnected
         std::vector<NodeSPtr> to_be_reconnected_tree_roots = current_lightning_layer.tree_roots;
 
-        current_lightning_layer.generateNewTrees(m_overhang_per_layer[layer_id], current_outlines, current_outlines_bbox, outlines_locator, m_supporting_radius, m_wall_supporting_radius, throw_on_cancel_callback);
+        generate_new_trees(current_lightning_layer, islands_per_layer[layer_id], current_outlines_bbox, outlines_locator, m_supporting_radius, m_wall_supporting_radius, throw_on_cancel_callback);
+        islands_per_layer[layer_id] = std::vector<LayerIsland>();
         current_lightning_layer.reconnectRoots(to_be_reconnected_tree_roots, current_outlines, current_outlines_bbox, outlines_locator, m_supporting_radius, m_wall_supporting_radius);
 
         // Initialize trees for next lower layer from the current one.
@@ -232,53 +366,4 @@ void Generator::generateTrees(const PrintObject &print_object, const std::functi
     }
 }
 
-void Generator::generateTreesforSupport(std::vector<Polygons>& contours, const std::function<void()> &throw_on_cancel_callback)
-{
-    if (contours.empty()) return;
-
-    m_lightning_layers.resize(contours.size());
-    bboxs.resize(contours.size());
-
-    const auto _locator_cell_size = locator_cell_size();
-    // For various operations its beneficial to quickly locate nearby features on the polygon:
-    const size_t top_layer_id = contours.size() - 1;
-    EdgeGrid::Grid outlines_locator(get_extents(contours[top_layer_id]).inflated(SCALED_EPSILON));
-    outlines_locator.create(contours[top_layer_id], _locator_cell_size);
-
-    // For-each layer from top to bottom:
-    for (int layer_id = int(top_layer_id); layer_id >= 0; layer_id--) {
-		throw_on_cancel_callback();
-        Layer& current_lightning_layer = m_lightning_layers[layer_id];
-        const Polygons& current_outlines = contours[layer_id];
-        const BoundingBox& current_outlines_bbox = get_extents(current_outlines);
-
-        bboxs[layer_id] = get_extents(current_outlines);
-
-        // register all trees propagated from the previous layer as to-be-reconnected
-        std::vector<NodeSPtr> to_be_reconnected_tree_roots = current_lightning_layer.tree_roots;
-
-        current_lightning_layer.generateNewTrees(m_overhang_per_layer[layer_id], current_outlines, current_outlines_bbox, outlines_locator, m_supporting_radius, m_wall_supporting_radius, throw_on_cancel_callback);
-        current_lightning_layer.reconnectRoots(to_be_reconnected_tree_roots, current_outlines, current_outlines_bbox, outlines_locator, m_supporting_radius, m_wall_supporting_radius);
-
-        // Initialize trees for next lower layer from the current one.
-        if (layer_id == 0)
-            return;
-
-        const Polygons& below_outlines = contours[layer_id - 1];
-        BoundingBox     below_outlines_bbox = get_extents(below_outlines).inflated(SCALED_EPSILON);
-        if (const BoundingBox& outlines_locator_bbox = outlines_locator.bbox(); outlines_locator_bbox.defined)
-            below_outlines_bbox.merge(outlines_locator_bbox);
-
-        if (!current_lightning_layer.tree_roots.empty())
-            below_outlines_bbox.merge(get_extents(current_lightning_layer.tree_roots).inflated(SCALED_EPSILON));
-
-        outlines_locator.set_bbox(below_outlines_bbox);
-        outlines_locator.create(below_outlines, _locator_cell_size);
-
-        std::vector<NodeSPtr>& lower_trees = m_lightning_layers[layer_id - 1].tree_roots;
-        for (auto& tree : current_lightning_layer.tree_roots)
-            tree->propagateToNextLayer(lower_trees, below_outlines, outlines_locator, m_prune_length, m_straightening_max_distance, _locator_cell_size / 2);
-    }
-}
-
 } // namespace Slic3r::FillLightning
@@ -72,13 +72,28 @@ protected:
      * only when support is generated. For this pattern, we also need to
      * generate overhang areas for the inside of the model.
      */
-    void generateInitialInternalOverhangs(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback);
+    void generateInitialInternalOverhangs(const std::vector<Polygons> &infill_outlines, const std::function<void()> &throw_on_cancel_callback);
+
+    /*!
+     * Collect the sparse infill areas of all layers of the object, in parallel.
+     */
+    static std::vector<Polygons> collectInfillOutlines(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback);
 
     /*!
      * Calculate the tree structure of all layers.
+     *
+     * The layers are processed from top to bottom, as the trees of a layer are
+     * propagated to the layer below. The independent islands of a layer are
+     * grown in parallel and the distance fields of the layers below are
+     * prepared in parallel ahead of them.
+     *
+     * As each island samples its overhang into its own distance field, the
+     * trees differ from the ones grown with a single distance field per layer
+     * on layers with more than one island: the sampling grid is aligned to the
+     * island and the overhang is supported island by island. Every overhang is
+     * still supported and the result does not depend on the number of threads.
      */
-    void generateTrees(const PrintObject &print_object, const std::function<void()> &throw_on_cancel_callback);
-    void generateTreesforSupport(std::vector<Polygons>& contours, const std::function<void()> &throw_on_cancel_callback);
+    void generateTrees(const std::vector<Polygons> &infill_outlines, const std::function<void()> &throw_on_cancel_callback);
 
     float m_infill_extrusion_width;
 
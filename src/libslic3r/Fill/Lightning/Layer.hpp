@@ -17,6 +17,7 @@ namespace Slic3r::FillLightning
 {
 
 class Node;
+class DistanceField;
 using NodeSPtr = std::shared_ptr<Node>;
 using SparseNodeGrid = std::unordered_multimap<Point, std::weak_ptr<Node>, PointHash>;
 
@@ -37,9 +38,13 @@ class Layer
 public:
     std::vector<NodeSPtr> tree_roots;
 
+    /*!
+     * Grow the trees to support the unsupported points of the distance field, which was built from the overhang
+     * and the outlines of this layer.
+     */
     void generateNewTrees
     (
-        const Polygons& current_overhang,
+        DistanceField& distance_field,
         const Polygons& current_outlines,
         const BoundingBox& current_outlines_bbox,
         const EdgeGrid::Grid& outline_locator,
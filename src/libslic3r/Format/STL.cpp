@@ -4,8 +4,11 @@
 
 #include "STL.hpp"
 
+#include <chrono>
 #include <string>
 
+#include <boost/log/trivial.hpp>
+
 #ifdef _WIN32
 #define DIR_SEPARATOR '\\'
 #else
@@ -19,6 +22,7 @@ bool load_stl(const char *path, Model *model, const char *object_name_in, Import
     TriangleMesh mesh;
     std::string design_id;
 
+    auto time_start = std::chrono::steady_clock::now();
     if (!mesh.ReadSTLFile(path, true, stlFn, custom_header_length)) {
         //    die "Failed to open $file\n" if !-e $path;
         return false;
@@ -27,6 +31,9 @@ bool load_stl(const char *path, Model *model, const char *object_name_in, Import
         // die "This STL file couldn't be read because it's empty.\n"
         return false;
     }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+    BOOST_LOG_TRIVIAL(info) << "load_stl: " << path << ": " << mesh.facets_count() << " facets loaded and repaired in " << seconds << " s, "
+                            << (seconds > 0. ? double(mesh.facets_count()) / seconds * 1e-6 : 0.) << " M facets/s";
 
     std::string object_name;
     if (object_name_in == nullptr) {
@@ -1,20 +1,89 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <memory>
+#include <string_view>
+#include <system_error>
+
 #include <boost/log/trivial.hpp>
 #include <boost/nowide/cstdio.hpp>
 
+#include <fast_float/fast_float.h>
+
+#include <tbb/task_arena.h>
+#if ! defined(TBB_VERSION_MAJOR)
+    #include <tbb/version.h>
+#endif
+#if TBB_VERSION_MAJOR >= 2021
+    #include <tbb/parallel_pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter_mode;
+#else
+    #include <tbb/pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter;
+#endif
+
 #include "objparser.hpp"
 
 #include "libslic3r/LocalesUtils.hpp"
 
 namespace ObjParser {
 #define EATWS()  while (*line == ' ' || *line == '\t') ++line
-static bool obj_parseline(const char *line, ObjData &data)
+// fast_float is several times faster than strtod() and it does not depend on the C locale.
+// strtod() is used for the syntax fast_float does not accept, for example a leading '+' or hexadecimal numbers.
+static inline double parse_double(const char *str, char **endptr)
+{
+	double value = 0;
+	if (*str != '+') {
+		auto [ptr, ec] = fast_float::from_chars(str, str + strlen(str), value);
+		if (ec == std::errc() && *ptr != 'x' && *ptr != 'X') {
+			*endptr = const_cast<char*>(ptr);
+			return value;
+		}
+	}
+	return strtod(str, endptr);
+}
+
+// A line of an OBJ file split into its values. Lines are tokenized independently of each other, thus objparse()
+// tokenizes them in parallel. The part of parsing depending on the lines read before is done by obj_apply_line().
+struct ObjLine
+{
+	enum class Type : unsigned char {
+		// Empty line, comment or a line which failed to parse.
+		None,
+		Vertex,
+		TextureCoordinate,
+		Normal,
+		Parameter,
+		Face,
+		MtlLib,
+		UseMtl,
+		Object,
+		Group,
+		SmoothingGroup,
+		Unknown,
+	};
+
+	Type 				type { Type::None };
+	// The vertex line contained more than three values. Set even if the color failed to parse.
+	bool 				has_vertex_color { false };
+	// A face with an invalid vertex reference keeps the references parsed before the invalid one, but it is not terminated.
+	bool 				face_complete { false };
+	// Command of an unknown line.
+	char 				command { 0 };
+	// Coordinates and color of a vertex, texture coordinate, normal or parameter.
+	float 				values[OBJ_VERTEX_LENGTH];
+	long 				smoothing_group { 0 };
+	// Range of the vertex references of a face in the buffer passed to obj_tokenize_line(), relative indices not resolved yet.
+	size_t 				face_begin { 0 };
+	size_t 				face_end { 0 };
+	// Material library, material, object or group name, pointing into the tokenized line.
+	std::string_view 	name;
+};
+
+static bool obj_tokenize_line(const char *line, ObjLine &out, std::vector<ObjVertex> &face_vertices)
 {
 	if (*line == 0)
 		return true;
-    assert(Slic3r::is_decimal_separator_point());
 	// Ignore whitespaces at the beginning of the line.
 	//FIXME is this a good idea?
 	EATWS();
@@ -38,14 +107,14 @@ static bool obj_parseline(const char *line, ObjData &data)
 				return false;
 			EATWS();
 			char *endptr = 0;
-			double u = strtod(line, &endptr);
+			double u = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t'))
 				return false;
 			line = endptr;
 			EATWS();
 			double v = 0;
 			if (*line != 0) {
-				v = strtod(line, &endptr);
+				v = parse_double(line, &endptr);
 				if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 					return false;
 				line = endptr;
@@ -53,7 +122,7 @@ static bool obj_parseline(const char *line, ObjData &data)
 			}
 			/*double w = 0;
 			if (*line != 0) {
-				w = strtod(line, &endptr);
+				w = parse_double(line, &endptr);
 				if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 					return false;
 				line = endptr;
@@ -61,9 +130,9 @@ static bool obj_parseline(const char *line, ObjData &data)
 			}*/
 			if (*line != 0)
 				return false;
-			data.textureCoordinates.push_back((float)u);
-			data.textureCoordinates.push_back((float)v);
-			//data.textureCoordinates.push_back((float)w);
+			out.type      = ObjLine::Type::TextureCoordinate;
+			out.values[0] = (float)u;
+			out.values[1] = (float)v;
 			break;
 		}
 		case 'n':
@@ -75,26 +144,27 @@ static bool obj_parseline(const char *line, ObjData &data)
 				return false;
 			EATWS();
 			char *endptr = 0;
-			double x = strtod(line, &endptr);
+			double x = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t'))
 				return false;
 			line = endptr;
 			EATWS();
-			double y = strtod(line, &endptr);
+			double y = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t'))
 				return false;
 			line = endptr;
 			EATWS();
-			double z = strtod(line, &endptr);
+			double z = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 				return false;
 			line = endptr;
 			EATWS();
 			if (*line != 0)
 				return false;
-			data.normals.push_back((float)x);
-			data.normals.push_back((float)y);
-			data.normals.push_back((float)z);
+			out.type      = ObjLine::Type::Normal;
+			out.values[0] = (float)x;
+			out.values[1] = (float)y;
+			out.values[2] = (float)z;
 			break;
 		}
 		case 'p':
@@ -105,19 +175,19 @@ static bool obj_parseline(const char *line, ObjData &data)
 				return false;
 			EATWS();
 			char *endptr = 0;
-			double u = strtod(line, &endptr);
+			double u = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 				return false;
 			line = endptr;
 			EATWS();
-			double v = strtod(line, &endptr);
+			double v = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 				return false;
 			line = endptr;
 			EATWS();
 			double w = 0;
 			if (*line != 0) {
-				w = strtod(line, &endptr);
+				w = parse_double(line, &endptr);
 				if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 					return false;
 				line = endptr;
@@ -125,9 +195,10 @@ static bool obj_parseline(const char *line, ObjData &data)
 			}
 			if (*line != 0)
 				return false;
-			data.parameters.push_back((float)u);
-			data.parameters.push_back((float)v);
-			data.parameters.push_back((float)w);
+			out.type      = ObjLine::Type::Parameter;
+			out.values[0] = (float)u;
+			out.values[1] = (float)v;
+			out.values[2] = (float)w;
 			break;
 		}
 		default:
@@ -137,44 +208,42 @@ static bool obj_parseline(const char *line, ObjData &data)
 				return false;
 			EATWS();
 			char *endptr = 0;
-			double x = strtod(line, &endptr);
+			double x = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t'))
 				return false;
 			line = endptr;
 			EATWS();
-			double y = strtod(line, &endptr);
+			double y = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t'))
 				return false;
 			line = endptr;
 			EATWS();
-			double z = strtod(line, &endptr);
+			double z = parse_double(line, &endptr);
 			if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
 				return false;
 			line = endptr;
 			EATWS();
             double color_x = 0.0, color_y = 0.0, color_z = 0.0, color_w = 0.0;//undefine color
             if (*line != 0) {
-                if (!data.has_vertex_color) {
-                    data.has_vertex_color = true;
-                }
-                color_x = strtod(line, &endptr);
+                out.has_vertex_color = true;
+                color_x = parse_double(line, &endptr);
                 if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
                     return false;
                 line = endptr;
                 EATWS();
-                color_y = strtod(line, &endptr);
+                color_y = parse_double(line, &endptr);
                 if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
                      return false;
                 line = endptr;
                 EATWS();
-                color_z = strtod(line, &endptr);
+                color_z = parse_double(line, &endptr);
                 if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
                     return false;
                 line = endptr;
                 EATWS();
                 color_w = 1.0;//default define alpha = 1.0
                 if (*line != 0) {
-                    color_w = strtod(line, &endptr);
+                    color_w = parse_double(line, &endptr);
                     if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0)) return false;
                     line = endptr;
                     EATWS();
@@ -185,13 +254,14 @@ static bool obj_parseline(const char *line, ObjData &data)
             // and this would lead to a crash because no vertex would be stored
 //            if (*line != 0)
 //                return false;
-            data.coordinates.push_back((float)x);
-			data.coordinates.push_back((float)y);
-			data.coordinates.push_back((float)z);
-            data.coordinates.push_back((float) color_x);
-            data.coordinates.push_back((float) color_y);
-            data.coordinates.push_back((float) color_z);
-            data.coordinates.push_back((float) color_w);
+            out.type      = ObjLine::Type::Vertex;
+            out.values[0] = (float)x;
+            out.values[1] = (float)y;
+            out.values[2] = (float)z;
+            out.values[3] = (float)color_x;
+            out.values[4] = (float)color_y;
+            out.values[5] = (float)color_z;
+            out.values[6] = (float)color_w;
 			break;
 		}
 		}
@@ -204,6 +274,9 @@ static bool obj_parseline(const char *line, ObjData &data)
 		if (*line == 0)
 			return false;
 
+		out.type       = ObjLine::Type::Face;
+		out.face_begin = face_vertices.size();
+		out.face_end   = out.face_begin;
 		// current vertex to be parsed
 		ObjVertex vertex;
 		char *endptr = 0;
@@ -236,6 +309,118 @@ static bool obj_parseline(const char *line, ObjData &data)
 					line = endptr;
 				}
 			}
+			face_vertices.push_back(vertex);
+			out.face_end = face_vertices.size();
+			EATWS();
+		}
+		out.face_complete = true;
+		break;
+	}
+	case 'm':
+	{
+		if (*(line ++) != 't' ||
+			*(line ++) != 'l' ||
+			*(line ++) != 'l' ||
+			*(line ++) != 'i' ||
+			*(line ++) != 'b')
+			return false;
+		// mtllib [external .mtl file name]
+		// printf("mtllib %s\r\n", line);
+		EATWS();
+		out.type = ObjLine::Type::MtlLib;
+		out.name = line;
+		break;
+	}
+	case 'u':
+	{
+		if (*(line ++) != 's' ||
+			*(line ++) != 'e' ||
+			*(line ++) != 'm' ||
+			*(line ++) != 't' ||
+			*(line ++) != 'l')
+			return false;
+		// usemtl [material name]
+		// printf("usemtl %s\r\n", line);
+		EATWS();
+		out.type = ObjLine::Type::UseMtl;
+		out.name = line;
+		break;
+	}
+	case 'o':
+	{
+		// o [object name]
+		EATWS();
+		while (*line != ' ' && *line != '\t' && *line != 0)
+			++ line;
+		// copy name to line.
+		EATWS();
+		if (*line != 0)
+			return false;
+		out.type = ObjLine::Type::Object;
+		out.name = line;
+		break;
+	}
+	case 'g':
+	{
+		// g [group name]
+		// printf("group %s\r\n", line);
+		out.type = ObjLine::Type::Group;
+		out.name = line;
+		break;
+	}
+	case 's':
+	{
+		// s 1 / off
+		char c2 = *line ++;
+		if (c2 != ' ' && c2 != '\t')
+			return false;
+		EATWS();
+		char *endptr = 0;
+		long g = strtol(line, &endptr, 10);
+		if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
+			return false;
+		line = endptr;
+		EATWS();
+		if (*line != 0)
+			return false;
+		out.type            = ObjLine::Type::SmoothingGroup;
+		out.smoothing_group = g;
+		break;
+	}
+	default:
+		out.type    = ObjLine::Type::Unknown;
+		out.command = c1;
+		break;
+	}
+
+	return true;
+}
+
+// Stores a tokenized line into data. Resolves the relative vertex references and tracks the faces per material.
+static void obj_apply_line(const ObjLine &line, const ObjVertex *face_vertices, ObjData &data)
+{
+	if (line.has_vertex_color)
+		data.has_vertex_color = true;
+
+	switch (line.type) {
+	case ObjLine::Type::None:
+		break;
+	case ObjLine::Type::Vertex:
+		data.coordinates.insert(data.coordinates.end(), line.values, line.values + OBJ_VERTEX_LENGTH);
+		break;
+	case ObjLine::Type::TextureCoordinate:
+		data.textureCoordinates.insert(data.textureCoordinates.end(), line.values, line.values + 2);
+		break;
+	case ObjLine::Type::Normal:
+		data.normals.insert(data.normals.end(), line.values, line.values + 3);
+		break;
+	case ObjLine::Type::Parameter:
+		data.parameters.insert(data.parameters.end(), line.values, line.values + 3);
+		break;
+	case ObjLine::Type::Face:
+	{
+		for (size_t i = line.face_begin; i < line.face_end; ++ i) {
+			ObjVertex vertex = face_vertices[i];
 			if (vertex.coordIdx < 0)
                 vertex.coordIdx += (int) data.coordinates.size() / OBJ_VERTEX_LENGTH;
             else
@@ -249,8 +434,9 @@ static bool obj_parseline(const char *line, ObjData &data)
             else
 				-- vertex.textureCoordIdx;
 			data.vertices.push_back(vertex);
-			EATWS();
 		}
+		if (! line.face_complete)
+			break;
         if (data.usemtls.size() > 0) {
 			data.usemtls.back().vertexIdxEnd = (int) data.vertices.size();
 		}
@@ -269,43 +455,24 @@ static bool obj_parseline(const char *line, ObjData &data)
                 data.usemtls.back().face_end++;
 			}
         }
+		ObjVertex vertex;
 		vertex.coordIdx			= -1;
 		vertex.normalIdx		= -1;
 		vertex.textureCoordIdx	= -1;
 		data.vertices.push_back(vertex);
 		break;
 	}
-	case 'm':
-	{
-		if (*(line ++) != 't' ||
-			*(line ++) != 'l' ||
-			*(line ++) != 'l' ||
-			*(line ++) != 'i' ||
-			*(line ++) != 'b')
-			return false;
-		// mtllib [external .mtl file name]
-		// printf("mtllib %s\r\n", line);
-		EATWS();
-		data.mtllibs.push_back(std::string(line));
+	case ObjLine::Type::MtlLib:
+		data.mtllibs.emplace_back(line.name);
 		break;
-	}
-	case 'u':
+	case ObjLine::Type::UseMtl:
 	{
-		if (*(line ++) != 's' ||
-			*(line ++) != 'e' ||
-			*(line ++) != 'm' ||
-			*(line ++) != 't' ||
-			*(line ++) != 'l')
-			return false;
-		// usemtl [material name]
-		// printf("usemtl %s\r\n", line);
-		EATWS();
         if (data.usemtls.size()>0) {
 			data.usemtls.back().vertexIdxEnd = (int) data.vertices.size();
 		}
 		ObjUseMtl usemtl;
         usemtl.vertexIdxFirst = (int)data.vertices.size();
-        usemtl.name = line;
+        usemtl.name = line.name;
 		data.usemtls.push_back(usemtl);
         if (data.usemtls.size() == 1) {
             data.usemtls.back().face_start = 0;
@@ -319,60 +486,47 @@ static bool obj_parseline(const char *line, ObjData &data)
         data.usemtls.back().face_end = data.usemtls.back().face_start - 1;
 		break;
 	}
-	case 'o':
+	case ObjLine::Type::Object:
 	{
-		// o [object name]
-		EATWS();
-		while (*line != ' ' && *line != '\t' && *line != 0)
-			++ line;
-		// copy name to line.
-		EATWS();
-		if (*line != 0)
-			return false;
 		ObjObject object;
         object.vertexIdxFirst = (int)data.vertices.size();
-        object.name = line;
+        object.name = line.name;
 		data.objects.push_back(object);
 		break;
 	}
-	case 'g':
+	case ObjLine::Type::Group:
 	{
-		// g [group name]
-		// printf("group %s\r\n", line);
 		ObjGroup group;
         group.vertexIdxFirst = (int)data.vertices.size();
-        group.name = line;
+        group.name = line.name;
 		data.groups.push_back(group);
 		break;
 	}
-	case 's':
+	case ObjLine::Type::SmoothingGroup:
 	{
-		// s 1 / off
-		char c2 = *line ++;
-		if (c2 != ' ' && c2 != '\t')
-			return false;
-		EATWS();
-		char *endptr = 0;
-		long g = strtol(line, &endptr, 10);
-		if (endptr == 0 || (*endptr != ' ' && *endptr != '\t' && *endptr != 0))
-			return false;
-		line = endptr;
-		EATWS();
-		if (*line != 0)
-			return false;
 		ObjSmoothingGroup group;
         group.vertexIdxFirst = (int)data.vertices.size();
-        group.smoothingGroupID = g;
+        group.smoothingGroupID = line.smoothing_group;
 		data.smoothingGroups.push_back(group);
 		break;
 	}
-	default:
-    	BOOST_LOG_TRIVIAL(error) << "ObjParser: Unknown command: " << c1;
+	case ObjLine::Type::Unknown:
+    	BOOST_LOG_TRIVIAL(error) << "ObjParser: Unknown command: " << line.command;
 		break;
 	}
+}
 
-	return true;
+// face_vertices is a buffer for the vertex references of a face, reused between the lines.
+static bool obj_parseline(const char *line, ObjData &data, std::vector<ObjVertex> &face_vertices)
+{
+    assert(Slic3r::is_decimal_separator_point());
+	ObjLine parsed;
+	face_vertices.clear();
+	bool    result = obj_tokenize_line(line, parsed, face_vertices);
+	obj_apply_line(parsed, face_vertices.data(), data);
+	return result;
 }
+
 static std::string cur_mtl_name = "";
 static bool        mtl_parseline(const char *line, MtlData &data)
 {
@@ -565,7 +719,22 @@ static bool        mtl_parseline(const char *line, MtlData &data)
     return true;
 }
 
+// Block of an OBJ file passed through the parsing pipeline of objparse().
+struct ObjChunk
+{
+	// Complete lines of the block, terminated by '\r' or '\n'.
+	std::vector<char>      buffer;
+	std::vector<ObjLine>   lines;
+	// Vertex references of all the faces of the block, referenced by ObjLine::face_begin / face_end.
+	std::vector<ObjVertex> face_vertices;
+};
+
 bool objparse(const char *path, ObjData &data)
+{
+	return objparse(path, data, 4 * 1024 * 1024);
+}
+
+bool objparse(const char *path, ObjData &data, size_t chunk_size)
 {
     Slic3r::CNumericLocalesSetter locales_setter;
 
@@ -573,37 +742,75 @@ bool objparse(const char *path, ObjData &data)
 	if (pFile == 0)
 		return false;
 
+	// Lines are cut out of large blocks of the file and tokenized in parallel,
+	// while the tokenized lines are stored into data serially in the order of the file.
+	static constexpr const size_t max_line_length = 65536;
+	bool line_too_long = false;
 	try {
-		char buf[65536 * 2];
-		size_t len = 0;
-		size_t lenPrev = 0;
-		while ((len = ::fread(buf + lenPrev, 1, 65536, pFile)) != 0) {
-			len += lenPrev;
-			size_t lastLine = 0;
-			for (size_t i = 0; i < len; ++ i)
-				if (buf[i] == '\r' || buf[i] == '\n') {
-					buf[i] = 0;
-					char *c = buf + lastLine;
-					while (*c == ' ' || *c == '\t')
-						++ c;
-					//FIXME check the return value and exit on error?
-					// Will it break parsing of some obj files?
-					obj_parseline(c, data);
-					lastLine = i + 1;
-				}
-			lenPrev = len - lastLine;
-			if (lenPrev > 65536) {
-		    	BOOST_LOG_TRIVIAL(error) << "ObjParser: Excessive line length";
-				::fclose(pFile);
-				return false;
-			}
-			memmove(buf, buf + lastLine, lenPrev);
-		}
+		std::vector<char> leftover;
+		tbb::parallel_pipeline(2 * tbb::this_task_arena::max_concurrency(),
+			tbb::make_filter<void, std::shared_ptr<ObjChunk>>(slic3r_tbb_filtermode::serial_in_order,
+				[pFile, chunk_size, &leftover, &line_too_long](tbb::flow_control &fc) -> std::shared_ptr<ObjChunk> {
+					auto chunk = std::make_shared<ObjChunk>();
+					chunk->buffer.swap(leftover);
+					size_t len_prev = chunk->buffer.size();
+					chunk->buffer.resize(len_prev + chunk_size);
+					size_t len = ::fread(chunk->buffer.data() + len_prev, 1, chunk_size, pFile);
+					if (len == 0) {
+						// The last line not terminated by a new line is ignored.
+						fc.stop();
+						return {};
+					}
+					len += len_prev;
+					size_t last_line = len;
+					while (last_line > 0 && chunk->buffer[last_line - 1] != '\r' && chunk->buffer[last_line - 1] != '\n')
+						-- last_line;
+					if (len - last_line > max_line_length) {
+						line_too_long = true;
+						fc.stop();
+						return {};
+					}
+					leftover.assign(chunk->buffer.begin() + last_line, chunk->buffer.begin() + len);
+					chunk->buffer.resize(last_line);
+					return chunk;
+				}) &
+			tbb::make_filter<std::shared_ptr<ObjChunk>, std::shared_ptr<ObjChunk>>(slic3r_tbb_filtermode::parallel,
+				[](std::shared_ptr<ObjChunk> chunk) {
+					// strtod() is still used for some numbers, the locale has to be set on the worker thread as well.
+					Slic3r::CNumericLocalesSetter locales_setter;
+					char *begin = chunk->buffer.data();
+					char *end   = begin + chunk->buffer.size();
+					for (char *line = begin; line != end;) {
+						char *line_end = line;
+						while (*line_end != '\r' && *line_end != '\n')
+							++ line_end;
+						*line_end = 0;
+						while (*line == ' ' || *line == '\t')
+							++ line;
+						ObjLine parsed;
+						//FIXME check the return value and exit on error?
+						// Will it break parsing of some obj files?
+						obj_tokenize_line(line, parsed, chunk->face_vertices);
+						if (parsed.type != ObjLine::Type::None || parsed.has_vertex_color)
+							chunk->lines.emplace_back(parsed);
+						line = line_end + 1;
+					}
+					return chunk;
+				}) &
+			tbb::make_filter<std::shared_ptr<ObjChunk>, void>(slic3r_tbb_filtermode::serial_in_order,
+				[&data](std::shared_ptr<ObjChunk> chunk) {
+					for (const ObjLine &line : chunk->lines)
+						obj_apply_line(line, chunk->face_vertices.data(), data);
+				}));
     }
     catch (std::bad_alloc&) {
     	BOOST_LOG_TRIVIAL(error) << "ObjParser: Out of memory";
 	}
 	::fclose(pFile);
+	if (line_too_long) {
+    	BOOST_LOG_TRIVIAL(error) << "ObjParser: Excessive line length";
+		return false;
+	}
 	return true;
 }
 
@@ -654,6 +861,7 @@ bool objparse(std::istream &stream, ObjData &data)
         char buf[65536 * 2];
         size_t len = 0;
         size_t lenPrev = 0;
+        std::vector<ObjVertex> face_vertices;
         while ((len = size_t(stream.read(buf + lenPrev, 65536).gcount())) != 0) {
             len += lenPrev;
             size_t lastLine = 0;
@@ -663,7 +871,7 @@ bool objparse(std::istream &stream, ObjData &data)
                     char *c = buf + lastLine;
                     while (*c == ' ' || *c == '\t')
                         ++ c;
-                    obj_parseline(c, data);
+                    obj_parseline(c, data, face_vertices);
                     lastLine = i + 1;
                 }
             lenPrev = len - lastLine;
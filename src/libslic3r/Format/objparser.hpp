@@ -124,6 +124,8 @@ struct MtlData
     std::unordered_map<std::string, std::shared_ptr<ObjNewMtl>> new_mtl_unmap;
 };
 extern bool objparse(const char *path, ObjData &data);
+// Reads the file in blocks of chunk_size bytes, which are tokenized in parallel.
+extern bool objparse(const char *path, ObjData &data, size_t chunk_size);
 extern bool mtlparse(const char *path, MtlData &data);
 extern bool objparse(std::istream &stream, ObjData &data);
 
@@ -3276,29 +3276,39 @@ void GCode::process_layers(
     GCodeOutputStream                                                   &output_stream)
 {
     // The pipeline is variable: The vase mode filter is optional.
+    // Pressure equalizer need insert empty input. Because it returns one layer back.
+    const size_t num_layers_to_process = layers_to_print.size() + (m_pressure_equalizer ? 1 : 0);
     size_t layer_to_print_idx = 0;
-    const auto generator = tbb::make_filter<void, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &tool_ordering, &print_object_instances_ordering, &layers_to_print, &layer_to_print_idx](tbb::flow_control& fc) -> LayerResult {
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
-                    fc.stop();
-                    return {};
-                } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    ++layer_to_print_idx;
-                    return LayerResult::make_nop_layer_result();
-                }
+    const auto layer_source = tbb::make_filter<void, size_t>(slic3r_tbb_filtermode::serial_in_order,
+        [&layer_to_print_idx, num_layers_to_process](tbb::flow_control& fc) -> size_t {
+            if (layer_to_print_idx == num_layers_to_process) {
+                fc.stop();
+                return 0;
+            }
+            return layer_to_print_idx ++;
+        });
+    // Data independent of the G-code generator state is calculated for several layers in parallel.
+    // Layers with the same lslices share their boundaries for the travels avoiding perimeters.
+    const auto avoid_crossing_cache = m_config.reduce_crossing_wall ? std::make_unique<AvoidCrossingPerimeters::LayerBoundariesCache>() : nullptr;
+    const auto precompute = tbb::make_filter<size_t, LayerPrecomputed>(slic3r_tbb_filtermode::parallel,
+        [&layers_to_print, &avoid_crossing_cache](size_t idx) -> LayerPrecomputed {
+            return idx < layers_to_print.size() ? LayerPrecomputed::make(idx, layers_to_print[idx].second, avoid_crossing_cache.get()) : LayerPrecomputed{ idx };
+        });
+    const auto generator = tbb::make_filter<LayerPrecomputed, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &tool_ordering, &print_object_instances_ordering, &layers_to_print](LayerPrecomputed precomputed) -> LayerResult {
+            if (precomputed.layer_to_print_idx == layers_to_print.size()) {
+                // Insert NOP (no operation) layer;
+                return LayerResult::make_nop_layer_result();
             } else {
-                const std::pair<coordf_t, std::vector<LayerToPrint>>& layer = layers_to_print[layer_to_print_idx++];
+                const std::pair<coordf_t, std::vector<LayerToPrint>>& layer = layers_to_print[precomputed.layer_to_print_idx];
                 const LayerTools& layer_tools = tool_ordering.tools_for_layer(layer.first);
-                print.set_status(80, Slic3r::format(_(L("Generating G-code: layer %1%")), std::to_string(layer_to_print_idx)));
+                print.set_status(80, Slic3r::format(_(L("Generating G-code: layer %1%")), std::to_string(precomputed.layer_to_print_idx + 1)));
                 if (m_wipe_tower && layer_tools.has_wipe_tower)
                     m_wipe_tower->next_layer();
                 //BBS
                 check_placeholder_parser_failed();
                 print.throw_if_canceled();
-                return this->process_layer(print, layer.second, layer_tools, &layer == &layers_to_print.back(), &print_object_instances_ordering, tool_ordering.get_most_used_extruder(), size_t(-1));
+                return this->process_layer(print, layer.second, layer_tools, &layer == &layers_to_print.back(), &print_object_instances_ordering, tool_ordering.get_most_used_extruder(), size_t(-1), false, &precomputed);
             }
         });
     if (m_spiral_vase) {
@@ -3356,14 +3366,21 @@ void GCode::process_layers(
     });
 
     // The pipeline elements are joined using const references, thus no copying is performed.
+    //FIXME The filters pass the layer G-code as text, each of them parses it again line by line. A typed stream
+    // of moves and commands formatted once by the output filter would save these round trips, but it requires
+    // rewriting CoolingBuffer, PressureEqualizer, FanMover, SpiralVase and AdaptivePAProcessor together.
     if (m_spiral_vase && m_pressure_equalizer)
-        tbb::parallel_pipeline(12, generator & spiral_mode & pressure_equalizer & cooling & fan_mover & output);
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & spiral_mode & pressure_equalizer & cooling & fan_mover & output);
     else if (m_spiral_vase)
-    	tbb::parallel_pipeline(12, generator & spiral_mode & cooling & fan_mover & output);
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & spiral_mode & cooling & fan_mover & output);
+    else if	(m_pressure_equalizer && m_pa_processor->is_active())
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & pressure_equalizer & cooling & fan_mover & pa_processor_filter & output);
     else if	(m_pressure_equalizer)
-        tbb::parallel_pipeline(12, generator & pressure_equalizer & cooling & fan_mover & pa_processor_filter & output);
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & pressure_equalizer & cooling & fan_mover & output);
+    else if	(m_pa_processor->is_active())
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & cooling & fan_mover & pa_processor_filter & output);
     else
-    	tbb::parallel_pipeline(12, generator & cooling & fan_mover & pa_processor_filter & output);
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & cooling & fan_mover & output);
 }
 
 // Process all layers of a single object instance (sequential mode) with a parallel pipeline:
@@ -3379,26 +3396,36 @@ void GCode::process_layers(
     const bool                               prime_extruder)
 {
     // The pipeline is variable: The vase mode filter is optional.
+    // Pressure equalizer need insert empty input. Because it returns one layer back.
+    const size_t num_layers_to_process = layers_to_print.size() + (m_pressure_equalizer ? 1 : 0);
     size_t layer_to_print_idx = 0;
-    const auto generator = tbb::make_filter<void, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
-        [this, &print, &tool_ordering, &layers_to_print, &layer_to_print_idx, single_object_idx, prime_extruder](tbb::flow_control& fc) -> LayerResult {
-            if (layer_to_print_idx >= layers_to_print.size()) {
-                if (layer_to_print_idx == layers_to_print.size() + (m_pressure_equalizer ? 1 : 0)) {
-                    fc.stop();
-                    return {};
-                } else {
-                    // Pressure equalizer need insert empty input. Because it returns one layer back.
-                    // Insert NOP (no operation) layer;
-                    ++layer_to_print_idx;
-                    return LayerResult::make_nop_layer_result();
-                }
+    const auto layer_source = tbb::make_filter<void, size_t>(slic3r_tbb_filtermode::serial_in_order,
+        [&layer_to_print_idx, num_layers_to_process](tbb::flow_control& fc) -> size_t {
+            if (layer_to_print_idx == num_layers_to_process) {
+                fc.stop();
+                return 0;
+            }
+            return layer_to_print_idx ++;
+        });
+    // Data independent of the G-code generator state is calculated for several layers in parallel.
+    // Layers with the same lslices share their boundaries for the travels avoiding perimeters.
+    const auto avoid_crossing_cache = m_config.reduce_crossing_wall ? std::make_unique<AvoidCrossingPerimeters::LayerBoundariesCache>() : nullptr;
+    const auto precompute = tbb::make_filter<size_t, LayerPrecomputed>(slic3r_tbb_filtermode::parallel,
+        [&layers_to_print, &avoid_crossing_cache](size_t idx) -> LayerPrecomputed {
+            return idx < layers_to_print.size() ? LayerPrecomputed::make(idx, { layers_to_print[idx] }, avoid_crossing_cache.get()) : LayerPrecomputed{ idx };
+        });
+    const auto generator = tbb::make_filter<LayerPrecomputed, LayerResult>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &print, &tool_ordering, &layers_to_print, single_object_idx, prime_extruder](LayerPrecomputed precomputed) -> LayerResult {
+            if (precomputed.layer_to_print_idx == layers_to_print.size()) {
+                // Insert NOP (no operation) layer;
+                return LayerResult::make_nop_layer_result();
             } else {
-                LayerToPrint &layer = layers_to_print[layer_to_print_idx ++];
-                print.set_status(80, Slic3r::format(_(L("Generating G-code: layer %1%")), std::to_string(layer_to_print_idx)));
+                LayerToPrint &layer = layers_to_print[precomputed.layer_to_print_idx];
+                print.set_status(80, Slic3r::format(_(L("Generating G-code: layer %1%")), std::to_string(precomputed.layer_to_print_idx + 1)));
                 //BBS
                 check_placeholder_parser_failed();
                 print.throw_if_canceled();
-                return this->process_layer(print, { std::move(layer) }, tool_ordering.tools_for_layer(layer.print_z()), &layer == &layers_to_print.back(), nullptr, tool_ordering.get_most_used_extruder(), single_object_idx, prime_extruder);
+                return this->process_layer(print, { std::move(layer) }, tool_ordering.tools_for_layer(layer.print_z()), &layer == &layers_to_print.back(), nullptr, tool_ordering.get_most_used_extruder(), single_object_idx, prime_extruder, &precomputed);
             }
         });
     if (m_spiral_vase) {
@@ -3454,13 +3481,17 @@ void GCode::process_layers(
 
     // The pipeline elements are joined using const references, thus no copying is performed.
     if (m_spiral_vase && m_pressure_equalizer)
-        tbb::parallel_pipeline(12, generator & spiral_mode & pressure_equalizer & cooling & fan_mover & output);
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & spiral_mode & pressure_equalizer & cooling & fan_mover & output);
     else if (m_spiral_vase)
-    	tbb::parallel_pipeline(12, generator & spiral_mode & cooling & fan_mover & output);
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & spiral_mode & cooling & fan_mover & output);
+    else if	(m_pressure_equalizer && m_pa_processor->is_active())
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & pressure_equalizer & cooling & fan_mover & pa_processor_filter & output);
     else if	(m_pressure_equalizer)
-        tbb::parallel_pipeline(12, generator & pressure_equalizer & cooling & fan_mover & pa_processor_filter & output);
+        tbb::parallel_pipeline(12, layer_source & precompute & generator & pressure_equalizer & cooling & fan_mover & output);
+    else if	(m_pa_processor->is_active())
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & cooling & fan_mover & pa_processor_filter & output);
     else
-    	tbb::parallel_pipeline(12, generator & cooling & fan_mover & pa_processor_filter & output);
+    	tbb::parallel_pipeline(12, layer_source & precompute & generator & cooling & fan_mover & output);
 }
 
 std::string GCode::placeholder_parser_process(const std::string &name, const std::string &templ, unsigned int current_filament_id, const DynamicConfig *config_override)
@@ -4051,6 +4082,29 @@ std::string GCode::generate_skirt(const Print &print,
     return gcode;
 }
 
+// Build the data of a layer, which does not depend on the state of the G-code generator.
+GCode::LayerPrecomputed GCode::LayerPrecomputed::make(size_t layer_to_print_idx, const std::vector<LayerToPrint> &layers, AvoidCrossingPerimeters::LayerBoundariesCache *avoid_crossing_cache)
+{
+    LayerPrecomputed out;
+    out.layer_to_print_idx = layer_to_print_idx;
+    out.overhang_boundaries.reserve(layers.size());
+    out.avoid_crossing_boundaries.reserve(layers.size());
+    for (const LayerToPrint &layer_to_print : layers) {
+        std::optional<ExtrusionQualityEstimator::LayerBoundaries> boundaries;
+        if (layer_to_print.object_layer) {
+            const auto& regions = layer_to_print.object_layer->regions();
+            const bool  enable_overhang_speed = std::any_of(regions.begin(), regions.end(), [](const LayerRegion* r) {
+                return r->has_extrusions() && r->region().config().enable_overhang_speed;
+            });
+            if (enable_overhang_speed)
+                boundaries = ExtrusionQualityEstimator::LayerBoundaries::make(*layer_to_print.object_layer);
+        }
+        out.overhang_boundaries.emplace_back(std::move(boundaries));
+        out.avoid_crossing_boundaries.emplace_back(avoid_crossing_cache && layer_to_print.layer() ? avoid_crossing_cache->get(*layer_to_print.layer()) : nullptr);
+    }
+    return out;
+}
+
 // In sequential mode, process_layer is called once per each object and its copy,
 // therefore layers will contain a single entry and single_object_instance_idx will point to the copy of the object.
 // In non-sequential mode, process_layer is called per each print_z height with all object and support layers accumulated.
@@ -4069,7 +4123,8 @@ LayerResult GCode::process_layer(
     // Otherwise print a single copy of a single object.
     const size_t                     		 single_object_instance_idx,
     // BBS
-    const bool                               prime_extruder)
+    const bool                               prime_extruder,
+    LayerPrecomputed                        *precomputed)
 {
     assert(! layers.empty());
     // Either printing all copies of all objects, or just a single copy of a single object.
@@ -4373,18 +4428,15 @@ LayerResult GCode::process_layer(
         return next_extruder;
     };
     
-    for (const auto &layer_to_print : layers) {
-        if (layer_to_print.object_layer) {
-            const auto& regions = layer_to_print.object_layer->regions();
-            const bool  enable_overhang_speed = std::any_of(regions.begin(), regions.end(), [](const LayerRegion* r) {
-                return r->has_extrusions() && r->region().config().enable_overhang_speed;
-            });
-            if (enable_overhang_speed) {
-                m_extrusion_quality_estimator.prepare_for_new_layer(layer_to_print.original_object,
-                                                                    layer_to_print.object_layer);
-            }
-        }
+    LayerPrecomputed layer_precomputed;
+    if (precomputed == nullptr) {
+        layer_precomputed = LayerPrecomputed::make(0, layers, nullptr);
+        precomputed = &layer_precomputed;
     }
+    assert(precomputed->overhang_boundaries.size() == layers.size());
+    for (size_t i = 0; i < layers.size(); ++ i)
+        if (std::optional<ExtrusionQualityEstimator::LayerBoundaries> &boundaries = precomputed->overhang_boundaries[i]; boundaries)
+            m_extrusion_quality_estimator.prepare_for_new_layer(layers[i].original_object, std::move(*boundaries));
 
     // Group extrusions by an extruder, then by an object, an island and a region.
     std::map<unsigned int, std::vector<ObjectByExtruder>> by_extruder;
@@ -4854,8 +4906,12 @@ LayerResult GCode::process_layer(
                 m_config.apply(instance_to_print.print_object.config(), true);
                 m_layer = layer_to_print.layer();
                 m_object_layer_over_raft = object_layer_over_raft;
-                if (m_config.reduce_crossing_wall)
-                    m_avoid_crossing_perimeters.init_layer(*m_layer);
+                if (m_config.reduce_crossing_wall) {
+                    if (std::shared_ptr<const AvoidCrossingPerimeters::LayerBoundaries> &boundaries = precomputed->avoid_crossing_boundaries[instance_to_print.layer_id]; boundaries)
+                        m_avoid_crossing_perimeters.init_layer(*m_layer, boundaries);
+                    else
+                        m_avoid_crossing_perimeters.init_layer(*m_layer);
+                }
 
                 if (this->config().gcode_label_objects) {
                     gcode += std::string("; printing object ") + instance_to_print.print_object.model_object()->name +
@@ -5643,6 +5699,14 @@ std::string GCode::extrude_perimeters(const Print &print, const std::vector<Obje
     return gcode;
 }
 
+static ChainingParams chaining_params(const PrintConfig &config)
+{
+    ChainingParams params;
+    params.spatial_grid           = config.path_chaining.value == PathChaining::SpatialGrid;
+    params.improve_passes         = size_t(std::max(0, config.path_chaining_improve_passes.value));
+    return params;
+}
+
 // Chain the paths hierarchically by a greedy algorithm to minimize a travel distance.
 std::string GCode::extrude_infill(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, bool ironing)
 {
@@ -5658,11 +5722,12 @@ std::string GCode::extrude_infill(const Print &print, const std::vector<ObjectBy
                     extrusions.emplace_back(ee);
             if (! extrusions.empty()) {
                 m_config.apply(print.get_print_region(&region - &by_region.front()).config());
-                chain_and_reorder_extrusion_entities(extrusions, &m_last_pos);
+                const ChainingParams params = chaining_params(m_config);
+                chain_and_reorder_extrusion_entities(extrusions, &m_last_pos, params);
                 for (const ExtrusionEntity *fill : extrusions) {
                     auto *eec = dynamic_cast<const ExtrusionEntityCollection*>(fill);
                     if (eec) {
-                        for (ExtrusionEntity *ee : eec->chained_path_from(m_last_pos).entities)
+                        for (ExtrusionEntity *ee : eec->chained_path_from(m_last_pos, erMixed, params).entities)
                             gcode += this->extrude_entity(*ee, extrusion_name);
                     } else
                         gcode += this->extrude_entity(*fill, extrusion_name);
@@ -5693,7 +5758,7 @@ std::string GCode::extrude_support(const ExtrusionEntityCollection &support_fill
         if (extrusions.empty())
             return gcode;
 
-        chain_and_reorder_extrusion_entities(extrusions, &m_last_pos);
+        chain_and_reorder_extrusion_entities(extrusions, &m_last_pos, chaining_params(m_config));
 
         const double  support_speed            = m_config.support_speed.value;
         const double  support_interface_speed  = m_config.get_abs_value("support_interface_speed");
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <cfloat>
@@ -299,6 +300,21 @@ public:
         }
     };
 
+    // Data of a set of LayerToPrint with the same print_z, which does not depend on the state of the G-code generator.
+    // It is calculated by a parallel stage of the process_layers() pipeline ahead of the serial process_layer() stage.
+    struct LayerPrecomputed
+    {
+        // Index into layers_to_print passed to process_layers(). Equal to layers_to_print.size() for the NOP layer.
+        size_t                                                                      layer_to_print_idx { 0 };
+        // Layer boundaries for the overhang speed estimation, one per LayerToPrint, empty if not needed.
+        std::vector<std::optional<ExtrusionQualityEstimator::LayerBoundaries>>      overhang_boundaries;
+        // Boundaries for the travels avoiding perimeters, one per LayerToPrint, null if not needed.
+        std::vector<std::shared_ptr<const AvoidCrossingPerimeters::LayerBoundaries>> avoid_crossing_boundaries;
+
+        // If avoid_crossing_cache is null, the boundaries for the travels avoiding perimeters are not calculated.
+        static LayerPrecomputed make(size_t layer_to_print_idx, const std::vector<LayerToPrint> &layers, AvoidCrossingPerimeters::LayerBoundariesCache *avoid_crossing_cache);
+    };
+
 private:
     class GCodeOutputStream {
     public:
@@ -354,7 +370,9 @@ private:
         // Otherwise print a single copy of a single object.
         const size_t                     single_object_idx = size_t(-1),
         // BBS
-        const bool                       prime_extruder = false);
+        const bool                       prime_extruder = false,
+        // Layer data precomputed in parallel by process_layers(). If null, it is calculated here.
+        LayerPrecomputed                *precomputed = nullptr);
     // Process all layers of all objects (non-sequential mode) with a parallel pipeline:
     // Generate G-code, run the filters (vase mode, cooling buffer), run the G-code analyser
     // and export G-code into file.
@@ -64,16 +64,30 @@ AdaptivePAInterpolator* AdaptivePAProcessor::getInterpolator(unsigned int tool_i
  * @return A string containing the processed G-code with adaptive pressure advance applied.
  */
 std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
-    std::istringstream stream(gcode);
-    std::string line;
-    std::ostringstream output;
+    // The layer is scanned in place through string views, only the lines being output are copied.
+    const std::string_view layer_gcode(gcode);
+    size_t             line_start = 0;
+    // Returns the next line of the layer without the trailing newline, false at the end of the layer.
+    auto next_line_of_layer = [&layer_gcode](size_t &start, std::string_view &out) {
+        if (start >= layer_gcode.size())
+            return false;
+        size_t end = layer_gcode.find('\n', start);
+        if (end == std::string_view::npos)
+            end = layer_gcode.size();
+        out   = layer_gcode.substr(start, end - start);
+        start = end + 1;
+        return true;
+    };
+    std::string_view line;
+    std::string output;
+    output.reserve(gcode.size());
     double mm3mm_value = 0.0;
     unsigned int accel_value = 0;
     std::string pa_change_line;
     bool wipe_command = false;
 
     // Iterate through each line of the layer G-code
-    while (std::getline(stream, line)) {
+    while (next_line_of_layer(line_start, line)) {
         
         // If a wipe start command is found, ignore all speed changes till the wipe end part is found
         if (line.find("WIPE_START") != std::string::npos) {
@@ -85,7 +99,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
         if ( (line.find("G1 F") == 0) && (!wipe_command) ) { // prune lines quickly before running pattern matching
             std::size_t pos = line.find('F');
             if (pos != std::string::npos){
-                m_current_feedrate = std::stod(line.substr(pos + 1)) / 60.0; // Convert from mm/min to mm/s
+                m_current_feedrate = std::stod(std::string(line.substr(pos + 1))) / 60.0; // Convert from mm/min to mm/s
             }
         }
         
@@ -106,7 +120,9 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
         // For a mixed extruder layer with both adaptive PA enabled and disabled when the new tool is selected
         // the PA for that material is set. As no tag below will be found for this extruder, the original PA is retained.
         if (line.find("; PA_CHANGE") == 0) { // prune lines quickly before running regex check as regex is more expensive to run
-            if (std::regex_search(line, m_match, m_pa_change_pattern)) {
+            // Save the PA_CHANGE line to output later after finding feedrate
+            pa_change_line = line;
+            if (std::regex_search(pa_change_line, m_match, m_pa_change_pattern)) {
                 int extruder_id = std::stoi(m_match[1].str());
                 mm3mm_value = std::stod(m_match[2].str());
                 accel_value = std::stod(m_match[3].str());
@@ -118,12 +134,9 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                 bool extruder_changed = (extruder_id != m_last_extruder_id);
                 m_last_extruder_id = extruder_id;
                 
-                // Save the PA_CHANGE line to output later after finding feedrate
-                pa_change_line = line;
-                
                 // Look ahead for feedrate before any line containing both G and E commands
-                std::streampos current_pos = stream.tellg();
-                std::string next_line;
+                size_t           next_line_start = line_start;
+                std::string_view next_line;
                 double temp_feed_rate = 0;
                 bool extrude_move_found = false;
                 int line_counter = 0;
@@ -132,7 +145,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                 // If a G1 Fxxxx pattern is found, the new speed is identified
                 // Carry on searching for feedrates to find the maximum print speed
                 // until a feature change pattern or a wipe command is detected
-                while (std::getline(stream, next_line)) {
+                while (next_line_of_layer(next_line_start, next_line)) {
                     line_counter++;
                     // Found an extrude move, set extrude move found flag and move to the next line
                     if ((!extrude_move_found) && next_line.find("G1 ") == 0 &&
@@ -170,7 +183,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                     if (next_line.find("; PA_CHANGE") == 0) { // prune lines quickly before running pattern matching
                         std::size_t rc_pos = next_line.rfind("RC:");
                         if (rc_pos != std::string::npos) {
-                            int rc_value = std::stoi(next_line.substr(rc_pos + 3));
+                            int rc_value = std::stoi(std::string(next_line.substr(rc_pos + 3)));
                             if (rc_value == 1) {
                                 break; // Role change found, stop searching
                             }
@@ -183,7 +196,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                     if (next_line.find("G1 F") == 0) { // prune lines quickly before running pattern matching
                         std::size_t pos = next_line.find('F');
                         if (pos != std::string::npos) {
-                            double feedrate = std::stod(next_line.substr(pos + 1)) / 60.0; // Convert from mm/min to mm/s
+                            double feedrate = std::stod(std::string(next_line.substr(pos + 1))) / 60.0; // Convert from mm/min to mm/s
                             if(line_counter==1){ // this is the first command after the PA change pattern, and hence before any extrusion has happened. Reset
                                                 // the current speed to this one
                                 m_current_feedrate = feedrate;
@@ -205,9 +218,6 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                 } else // If we didnt find a new feedrate at all after the PA change command, use the current feedrate.
                     m_max_next_feedrate = m_current_feedrate;
                 
-                // Restore stream position
-                stream.clear();
-                stream.seekg(current_pos);
                 
                 // Calculate the predicted PA using the upcomming feature maximum feedrate
                 // Get the interpolator for the active tool
@@ -219,7 +229,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                 if(!interpolator){ // Tool not found in the interpolator map
                     // Tool not found in the PA interpolator to tool map
                     predicted_pa = m_config.enable_pressure_advance.get_at(m_last_extruder_id) ? m_config.pressure_advance.get_at(m_last_extruder_id) : 0;
-                    if(m_config.gcode_comments) output << "; APA: Tool doesnt have APA enabled\n";
+                    if(m_config.gcode_comments) output += "; APA: Tool doesnt have APA enabled\n";
                 } else if (!interpolator->isInitialised() || (!m_config.adaptive_pressure_advance.get_at(m_last_extruder_id)) )
                     // Check if the model is not initialised by the constructor for the active extruder
                     // Also check that adaptive PA is enabled for that extruder. This should not be needed
@@ -228,7 +238,7 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                 {
                     // Model failed or adaptive pressure advance not enabled - use default value from m_config
                     predicted_pa = m_config.enable_pressure_advance.get_at(m_last_extruder_id) ? m_config.pressure_advance.get_at(m_last_extruder_id) : 0;
-                    if(m_config.gcode_comments) output << "; APA: Interpolator setup failed, using default pressure advance\n";
+                    if(m_config.gcode_comments) output += "; APA: Interpolator setup failed, using default pressure advance\n";
                 } else { // Model setup succeeded
                     // Proceed to identify the print speed to use to calculate the adaptive PA value
                     if(isOverhang > 0){  // If we are in an overhang area, use the minimum between current print speed
@@ -253,33 +263,34 @@ std::string AdaptivePAProcessor::process_layer(std::string &&gcode) {
                     
                     if (predicted_pa < 0) { // If extrapolation fails, fall back to the default PA for the extruder.
                         predicted_pa = m_config.enable_pressure_advance.get_at(m_last_extruder_id) ? m_config.pressure_advance.get_at(m_last_extruder_id) : 0;
-                        if(m_config.gcode_comments) output << "; APA: Interpolation failed, using fallback pressure advance value\n";
+                        if(m_config.gcode_comments) output += "; APA: Interpolation failed, using fallback pressure advance value\n";
                     }
                 }
                 if(m_config.gcode_comments) {
                     // Output debug GCode comments
-                    output << pa_change_line << '\n'; // Output PA change command tag
+                    output += pa_change_line + '\n'; // Output PA change command tag
                     if(isBridge && m_config.adaptive_pressure_advance_bridges.get_at(m_last_extruder_id) > EPSILON)
-                        output << "; APA Model Override (bridge)\n";
-                    output << "; APA Current Speed: " << std::to_string(m_current_feedrate) << "\n";
-                    output << "; APA Next Speed: " << std::to_string(m_next_feedrate) << "\n";
-                    output << "; APA Max Next Speed: " << std::to_string(m_max_next_feedrate) << "\n";
-                    output << "; APA Speed Used: " << std::to_string(adaptive_PA_speed) << "\n";
-                    output << "; APA Flow rate: " << std::to_string(mm3mm_value * m_max_next_feedrate) << "\n";
-                    output << "; APA Prev PA: " << std::to_string(m_last_predicted_pa) << " New PA: " << std::to_string(predicted_pa) << "\n"; 
+                        output += "; APA Model Override (bridge)\n";
+                    output += "; APA Current Speed: " + std::to_string(m_current_feedrate) + "\n";
+                    output += "; APA Next Speed: " + std::to_string(m_next_feedrate) + "\n";
+                    output += "; APA Max Next Speed: " + std::to_string(m_max_next_feedrate) + "\n";
+                    output += "; APA Speed Used: " + std::to_string(adaptive_PA_speed) + "\n";
+                    output += "; APA Flow rate: " + std::to_string(mm3mm_value * m_max_next_feedrate) + "\n";
+                    output += "; APA Prev PA: " + std::to_string(m_last_predicted_pa) + " New PA: " + std::to_string(predicted_pa) + "\n"; 
                 }
                 if (extruder_changed || std::fabs(predicted_pa - m_last_predicted_pa) > EPSILON) {
-                    output << m_gcodegen.writer().set_pressure_advance(predicted_pa); // Use m_writer to set pressure advance
+                    output += m_gcodegen.writer().set_pressure_advance(predicted_pa); // Use m_writer to set pressure advance
                     m_last_predicted_pa = predicted_pa; // Update the last predicted PA value
                 }
             }
         }else {
             // Output the current line as this isn't a PA change tag
-            output << line << '\n';
+            output += line;
+            output += '\n';
         }
     }
 
-    return output.str();
+    return output;
 }
 
 } // namespace Slic3r
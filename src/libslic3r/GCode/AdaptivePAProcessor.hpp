@@ -7,6 +7,7 @@
 #define ADAPTIVEPAPROCESSOR_H
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <regex>
 #include <memory>
@@ -53,6 +54,14 @@ public:
      * Call this when changing tools or in any other case where the internally assumed last PA value may be incorrect
      */
     void resetPreviousPA(double PA){ m_last_predicted_pa = PA; };
+
+    /**
+     * @brief Checks whether adaptive pressure advance is enabled for any of the used tools.
+     *
+     * PA_CHANGE tags are only emitted for such tools. If there is none, process_layer() would just
+     * copy the layer G-code, therefore it may be left out of the G-code export pipeline.
+     */
+    bool is_active() const { return !m_AdaptivePAInterpolators.empty(); }
     
 private:
     GCode &m_gcodegen; ///< Reference to the GCode object.
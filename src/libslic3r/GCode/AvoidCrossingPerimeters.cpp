@@ -10,7 +10,9 @@
 #include "AvoidCrossingPerimeters.hpp"
 
 #include <numeric>
+#include <string_view>
 #include <unordered_set>
+#include <boost/container_hash/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 namespace Slic3r {
@@ -1247,18 +1249,22 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
     const ExPolygons               &lslices          = gcodegen.layer()->lslices;
     const std::vector<BoundingBox> &lslices_bboxes   = gcodegen.layer()->lslices_bboxes;
     bool                            is_support_layer = (dynamic_cast<const SupportLayer *>(gcodegen.layer()) != nullptr);
-    if (!use_external && (is_support_layer || (!m_lslices_offset.empty() && !any_expolygon_contains(m_lslices_offset, m_lslices_offset_bboxes, m_grid_lslice, travel)))) {
-        // Initialize m_internal only when it is necessary.
-        if (m_internal.boundaries.empty()) {
-            init_boundary(&m_internal, to_polygons(get_boundary(*gcodegen.layer(), get_perimeter_spacing(*gcodegen.layer()))), {start, end});
-        } else if (!(m_internal.bbox.contains(startf) && m_internal.bbox.contains(endf))) {
-            // check if start and end are in bbox, if not, merge start and end points to bbox
-            m_internal.clear();
-            init_boundary(&m_internal, to_polygons(get_boundary(*gcodegen.layer(), get_perimeter_spacing(*gcodegen.layer()))), {start, end});
+    static const LayerBoundaries no_layer_boundaries {};
+    const LayerBoundaries       &layer_boundaries = m_layer_boundaries ? *m_layer_boundaries : no_layer_boundaries;
+    if (!use_external && (is_support_layer || (!layer_boundaries.lslices_offset.empty() && !any_expolygon_contains(layer_boundaries.lslices_offset, layer_boundaries.lslices_offset_bboxes, layer_boundaries.grid_lslice, travel)))) {
+        const Boundary *internal = &layer_boundaries.internal;
+        if (!(internal->bbox.contains(startf) && internal->bbox.contains(endf))) {
+            // Initialize m_internal only when it is necessary.
+            if (m_internal.boundaries.empty() || !(m_internal.bbox.contains(startf) && m_internal.bbox.contains(endf))) {
+                // check if start and end are in bbox, if not, merge start and end points to bbox
+                m_internal.clear();
+                init_boundary(&m_internal, Polygons(layer_boundaries.internal.boundaries), {start, end});
+            }
+            internal = &m_internal;
         }
 
-        if (!m_internal.boundaries.empty()) {
-            travel_intersection_count = avoid_perimeters(m_internal, start, end, *gcodegen.layer(), result_pl);
+        if (!internal->boundaries.empty()) {
+            travel_intersection_count = avoid_perimeters(*internal, start, end, *gcodegen.layer(), result_pl);
             result_pl.points.front()  = start;
             result_pl.points.back()   = end;
         }
@@ -1308,7 +1314,7 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
     } else if (max_detour_length_exceeded) {
         *could_be_wipe_disabled = false;
     } else
-        *could_be_wipe_disabled = !need_wipe(gcodegen, m_lslices_offset, m_lslices_offset_bboxes, m_grid_lslice, travel, result_pl, travel_intersection_count);
+        *could_be_wipe_disabled = !need_wipe(gcodegen, layer_boundaries.lslices_offset, layer_boundaries.lslices_offset_bboxes, layer_boundaries.grid_lslice, travel, result_pl, travel_intersection_count);
 
     return result_pl;
 }
@@ -1317,24 +1323,107 @@ Polyline AvoidCrossingPerimeters::travel_to(const GCode &gcodegen, const Point &
 
 void AvoidCrossingPerimeters::init_layer(const Layer &layer)
 {
+    this->init_layer(layer, LayerBoundaries::make(layer));
+}
+
+void AvoidCrossingPerimeters::init_layer(const Layer &layer, std::shared_ptr<const LayerBoundaries> layer_boundaries)
+{
+    assert(layer_boundaries);
     m_internal.clear();
-    m_external.clear();
+    // All objects and instances printed at the same print_z share the same external boundary.
+    if (const bool support_layer = dynamic_cast<const SupportLayer*>(&layer) != nullptr; layer.print_z != m_external_print_z || support_layer != m_external_support_layer) {
+        m_external.clear();
+        m_external_print_z       = layer.print_z;
+        m_external_support_layer = support_layer;
+    }
+    m_layer_boundaries = std::move(layer_boundaries);
+}
+
+// Collect all top surfaces of a layer, which travels inside the object will not cross.
+static ExPolygons collect_top_surfaces(const Layer &layer)
+{
+    ExPolygons top_surfaces;
+    for (const LayerRegion *layer_region : layer.regions())
+        for (const Surface &surface : layer_region->fill_surfaces.surfaces)
+            if (surface.is_top()) top_surfaces.emplace_back(surface.expolygon);
+    return top_surfaces;
+}
+
+std::shared_ptr<const AvoidCrossingPerimeters::LayerBoundaries> AvoidCrossingPerimeters::LayerBoundaries::make(const Layer &layer)
+{
+    auto out = std::make_shared<LayerBoundaries>();
+    out->layer                    = &layer;
+    out->external_perimeter_width = get_external_perimeter_width(layer);
+    out->perimeter_spacing        = get_perimeter_spacing(layer);
 
-    m_lslices_offset.clear();
-    m_lslices_offset_bboxes.clear();
     for (auto coeff : {0.6f, 0.5f, 0.45f}) {
-        m_lslices_offset = offset_ex(layer.lslices, -get_external_perimeter_width(layer) * coeff);
-        if (!m_lslices_offset.empty()) break;
-    }    
-    m_lslices_offset_bboxes.reserve(m_lslices_offset.size());
-    for (const auto &ex_polygon : m_lslices_offset) m_lslices_offset_bboxes.emplace_back(get_extents(ex_polygon));
+        out->lslices_offset = offset_ex(layer.lslices, -out->external_perimeter_width * coeff);
+        if (!out->lslices_offset.empty()) break;
+    }
+    out->lslices_offset_bboxes.reserve(out->lslices_offset.size());
+    for (const auto &ex_polygon : out->lslices_offset) out->lslices_offset_bboxes.emplace_back(get_extents(ex_polygon));
 
     BoundingBox bbox_slice(get_extents(layer.lslices));
     bbox_slice.offset(SCALED_EPSILON);
 
-    m_grid_lslice.set_bbox(bbox_slice);
+    out->grid_lslice.set_bbox(bbox_slice);
     //FIXME 1mm grid?
-    m_grid_lslice.create(m_lslices_offset, coord_t(scale_(1.)));
+    out->grid_lslice.create(out->lslices_offset, coord_t(scale_(1.)));
+
+    init_boundary(&out->internal, to_polygons(get_boundary(layer, out->perimeter_spacing)), {});
+    return out;
+}
+
+bool AvoidCrossingPerimeters::LayerBoundaries::same_boundaries(const Layer &other, float other_external_perimeter_width, float other_perimeter_spacing) const
+{
+    assert(this->layer != nullptr);
+    assert(dynamic_cast<const SupportLayer*>(this->layer) == nullptr && dynamic_cast<const SupportLayer*>(&other) == nullptr);
+    return this->external_perimeter_width == other_external_perimeter_width && this->perimeter_spacing == other_perimeter_spacing &&
+           this->layer->lslices == other.lslices && collect_top_surfaces(*this->layer) == collect_top_surfaces(other);
+}
+
+std::shared_ptr<const AvoidCrossingPerimeters::LayerBoundaries> AvoidCrossingPerimeters::LayerBoundariesCache::get(const Layer &layer)
+{
+    // The boundaries of support layers depend on the layer below, they are not shared.
+    if (dynamic_cast<const SupportLayer*>(&layer) != nullptr)
+        return LayerBoundaries::make(layer);
+
+    const float external_perimeter_width = get_external_perimeter_width(layer);
+    const float perimeter_spacing        = get_perimeter_spacing(layer);
+    size_t      hash                     = 0;
+    boost::hash_combine(hash, external_perimeter_width);
+    boost::hash_combine(hash, perimeter_spacing);
+    for (const ExPolygon &expoly : layer.lslices)
+        for (size_t icontour = 0; icontour <= expoly.holes.size(); ++ icontour) {
+            const Points &pts = icontour == 0 ? expoly.contour.points : expoly.holes[icontour - 1].points;
+            boost::hash_combine(hash, std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(pts.data()), pts.size() * sizeof(Point))));
+        }
+
+    auto find = [this, hash, &layer, external_perimeter_width, perimeter_spacing]() -> std::shared_ptr<const LayerBoundaries> {
+        for (auto [it, it_end] = m_map.equal_range(hash); it != it_end;) {
+            if (std::shared_ptr<const LayerBoundaries> boundaries = it->second.lock(); ! boundaries) {
+                // Released by the G-code generator already.
+                it = m_map.erase(it);
+                continue;
+            } else if (boundaries->same_boundaries(layer, external_perimeter_width, perimeter_spacing))
+                return boundaries;
+            ++ it;
+        }
+        return {};
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (std::shared_ptr<const LayerBoundaries> boundaries = find(); boundaries)
+            return boundaries;
+    }
+    // Calculate the boundaries outside of the lock. If another thread calculated the same boundaries meanwhile, use its copy.
+    std::shared_ptr<const LayerBoundaries> boundaries = LayerBoundaries::make(layer);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::shared_ptr<const LayerBoundaries> other = find(); other)
+        return other;
+    m_map.emplace(hash, boundaries);
+    return boundaries;
 }
 
 #if 0
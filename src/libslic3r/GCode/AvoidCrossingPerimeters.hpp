@@ -5,6 +5,10 @@
 #include "../ExPolygon.hpp"
 #include "../EdgeGrid.hpp"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace Slic3r {
 
 // Forward declarations.
@@ -24,7 +28,11 @@ public:
     bool        disabled_once() const   { return m_disabled_once; }
     void        reset_once_modifiers()  { m_use_external_mp_once = false; m_disabled_once = false; }
 
+    struct LayerBoundaries;
+
     void        init_layer(const Layer &layer);
+    // Initialize with boundaries precomputed by LayerBoundaries::make() or by LayerBoundariesCache.
+    void        init_layer(const Layer &layer, std::shared_ptr<const LayerBoundaries> layer_boundaries);
 
     Polyline    travel_to(const GCode& gcodegen, const Point& point)
     {
@@ -51,6 +59,41 @@ public:
         }
     };
 
+    // Boundaries of a single layer, which do not depend on the travels planned over it.
+    // They are immutable once made, thus they may be calculated in parallel ahead of the G-code generator
+    // and shared by all instances of an object and by all layers with the same lslices.
+    struct LayerBoundaries {
+        // Lslices offseted by half an external perimeter width. Used for detection if line or polyline is inside of any polygon.
+        ExPolygons               lslices_offset;
+        std::vector<BoundingBox> lslices_offset_bboxes;
+        // Used for detection of line or polyline is inside of any polygon.
+        EdgeGrid::Grid           grid_lslice;
+        // Boundary for travels inside object. Its bounding box is inflated by its radius, travels leaving it
+        // are planned over a boundary with a bounding box enlarged by their end points.
+        Boundary                 internal;
+
+        // Layer the boundaries were calculated for and the perimeter widths they were calculated with.
+        const Layer             *layer { nullptr };
+        float                    external_perimeter_width { 0.f };
+        float                    perimeter_spacing { 0.f };
+
+        static std::shared_ptr<const LayerBoundaries> make(const Layer &layer);
+        // Could the boundaries of this layer be used for the other layer? Only valid for object layers.
+        bool                     same_boundaries(const Layer &other, float other_external_perimeter_width, float other_perimeter_spacing) const;
+    };
+
+    // Thread safe cache of LayerBoundaries, which deduplicates the boundaries of layers with the same lslices,
+    // for example of the layers of prismatic parts. The cache does not own the boundaries, they are released
+    // once no layer of the G-code generator references them.
+    class LayerBoundariesCache {
+    public:
+        std::shared_ptr<const LayerBoundaries> get(const Layer &layer);
+
+    private:
+        std::mutex                                                           m_mutex;
+        std::unordered_multimap<size_t, std::weak_ptr<const LayerBoundaries>> m_map;
+    };
+
 private:
     bool           m_use_external_mp { false };
     // just for the next travel move
@@ -59,15 +102,15 @@ private:
     // we enable it by default for the first travel move in print
     bool           m_disabled_once { true };
 
-    // Lslices offseted by half an external perimeter width. Used for detection if line or polyline is inside of any polygon.
-    ExPolygons               m_lslices_offset;
-    std::vector<BoundingBox> m_lslices_offset_bboxes;
-    // Used for detection of line or polyline is inside of any polygon.
-    EdgeGrid::Grid m_grid_lslice;
-    // Store all needed data for travels inside object
+    // Boundaries of the current layer, see LayerBoundaries.
+    std::shared_ptr<const LayerBoundaries> m_layer_boundaries;
+    // Store all needed data for travels inside object, which leave the bounding box of m_layer_boundaries->internal.
     Boundary m_internal;
     // Store all needed data for travels outside object
     Boundary m_external;
+    // The external boundary is shared by all layers with the same print_z, it is only invalidated by a layer change.
+    double   m_external_print_z { -1. };
+    bool     m_external_support_layer { false };
 };
 
 } // namespace Slic3r
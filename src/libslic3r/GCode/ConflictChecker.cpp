@@ -1,9 +1,7 @@
 #include "ConflictChecker.hpp"
 
 #include <tbb/parallel_for.h>
-#include <tbb/concurrent_vector.h>
 
-#include <map>
 #include <functional>
 #include <atomic>
 
@@ -84,6 +82,147 @@ inline Grids line_rasterization(const Line &line, int64_t xdist = scale_(1), int
 
     return res;
 }
+
+// Grid cells mapped to the lines rasterized into them, stored in a flat open addressing hash table.
+// The lines of a cell are kept in the order they were added.
+class LineGrid
+{
+public:
+    struct Cell
+    {
+        IndexPair index;
+        // First and last node of the lines of this cell, -1 for an unused slot.
+        int       first { -1 };
+        int       last { -1 };
+    };
+
+    explicit LineGrid(size_t num_lines)
+    {
+        size_t capacity = 64;
+        while (capacity < 2 * num_lines)
+            capacity *= 2;
+        m_cells.assign(capacity, Cell());
+        m_nodes.reserve(2 * num_lines);
+    }
+
+    // Find the cell, add an empty one if missing. The reference is valid until the next call to cell().
+    Cell& cell(const IndexPair &index)
+    {
+        if (2 * (m_num_cells + 1) > m_cells.size())
+            this->grow();
+        Cell &out = m_cells[this->find_slot(m_cells, index)];
+        if (out.first == -1) {
+            out.index = index;
+            ++ m_num_cells;
+        }
+        return out;
+    }
+
+    // A cell returned by cell() has to be filled right away, an empty cell marks an unused slot.
+    void append(Cell &cell, int line_idx)
+    {
+        int node = int(m_nodes.size());
+        m_nodes.push_back({ line_idx, -1 });
+        if (cell.first == -1)
+            cell.first = node;
+        else
+            m_nodes[cell.last].next = node;
+        cell.last = node;
+    }
+
+    int line(int node) const { return m_nodes[node].line_idx; }
+    int next(int node) const { return m_nodes[node].next; }
+
+private:
+    struct Node
+    {
+        int line_idx;
+        int next;
+    };
+
+    static size_t find_slot(const std::vector<Cell> &cells, const IndexPair &index)
+    {
+        uint64_t h = uint64_t(index.first) * 0x9E3779B97F4A7C15ull ^ uint64_t(index.second) * 0xC2B2AE3D27D4EB4Full;
+        h ^= h >> 29;
+        size_t mask = cells.size() - 1;
+        for (size_t slot = size_t(h) & mask;; slot = (slot + 1) & mask)
+            if (cells[slot].first == -1 || cells[slot].index == index)
+                return slot;
+    }
+
+    void grow()
+    {
+        std::vector<Cell> cells(m_cells.size() * 2, Cell());
+        for (const Cell &cell : m_cells)
+            if (cell.first != -1)
+                cells[find_slot(cells, cell.index)] = cell;
+        m_cells = std::move(cells);
+    }
+
+    std::vector<Cell> m_cells;
+    std::vector<Node> m_nodes;
+    size_t            m_num_cells { 0 };
+};
+
+// Indices of the lines, which may intersect a line of another object. Only the lines overlapping the bounding box
+// of the lines of another object are returned, the other lines cannot produce a conflict.
+inline std::vector<int> lines_near_other_objects(const LineWithIDs &lines)
+{
+    std::vector<std::pair<const void*, BoundingBox>> objects;
+    std::vector<int>                                 line_objects;
+    line_objects.reserve(lines.size());
+    for (const LineWithID &l : lines) {
+        // The lines of an object are mostly consecutive.
+        int idx = int(objects.size()) - 1;
+        if (idx < 0 || objects[idx].first != l._id) {
+            idx = 0;
+            while (idx < int(objects.size()) && objects[idx].first != l._id)
+                ++ idx;
+            if (idx == int(objects.size())) {
+                BoundingBox bbox;
+                bbox.min = l._line.a;
+                bbox.max = l._line.a;
+                objects.emplace_back(l._id, bbox);
+            }
+        }
+        BoundingBox &bbox = objects[idx].second;
+        bbox.min = bbox.min.cwiseMin(l._line.a).cwiseMin(l._line.b);
+        bbox.max = bbox.max.cwiseMax(l._line.a).cwiseMax(l._line.b);
+        line_objects.emplace_back(idx);
+    }
+
+    // Overlaps of the bounding box of each object with the ones of the other objects.
+    std::vector<std::vector<BoundingBox>> overlaps(objects.size());
+    bool                                  any_overlap = false;
+    for (size_t i = 0; i < objects.size(); ++ i)
+        for (size_t j = i + 1; j < objects.size(); ++ j) {
+            BoundingBox bbox1 = objects[i].second.inflated(SCALED_EPSILON);
+            BoundingBox bbox2 = objects[j].second.inflated(SCALED_EPSILON);
+            if (bbox1.overlap(bbox2)) {
+                BoundingBox overlap;
+                overlap.min = bbox1.min.cwiseMax(bbox2.min);
+                overlap.max = bbox1.max.cwiseMin(bbox2.max);
+                overlaps[i].emplace_back(overlap);
+                overlaps[j].emplace_back(overlap);
+                any_overlap = true;
+            }
+        }
+
+    std::vector<int> out;
+    if (any_overlap)
+        for (int i = 0; i < int(lines.size()); ++ i) {
+            const Line &l = lines[i]._line;
+            BoundingBox bbox;
+            bbox.min = l.a.cwiseMin(l.b);
+            bbox.max = l.a.cwiseMax(l.b);
+            for (const BoundingBox &overlap : overlaps[line_objects[i]])
+                if (bbox.overlap(overlap)) {
+                    out.emplace_back(i);
+                    break;
+                }
+        }
+    return out;
+}
 } // namespace RasterizationImpl
 
 void LinesBucketQueue::emplace_back_bucket(ExtrusionLayers &&els, const void *objPtr, Point offset)
@@ -200,18 +339,21 @@ ObjectExtrusions getAllLayersExtrusionPathsFromObject(PrintObject *obj)
 ConflictComputeOpt ConflictChecker::find_inter_of_lines(const LineWithIDs &lines)
 {
     using namespace RasterizationImpl;
-    std::map<IndexPair, std::vector<int>> indexToLine;
+    // Skipping the lines which cannot intersect a line of another object does not change the first intersection found.
+    std::vector<int> candidates = lines_near_other_objects(lines);
+    if (candidates.empty()) { return {}; }
+    LineGrid indexToLine(candidates.size());
 
-    for (int i = 0; i < lines.size(); ++i) {
+    for (int i : candidates) {
         const LineWithID &l1      = lines[i];
         auto              indexes = line_rasterization(l1._line);
         for (auto index : indexes) {
-            const auto &possibleIntersectIdxs = indexToLine[index];
-            for (auto possibleIntersectIdx : possibleIntersectIdxs) {
-                const LineWithID &l2 = lines[possibleIntersectIdx];
+            LineGrid::Cell &cell = indexToLine.cell(index);
+            for (int node = cell.first; node != -1; node = indexToLine.next(node)) {
+                const LineWithID &l2 = lines[indexToLine.line(node)];
                 if (auto interRes = line_intersect(l1, l2); interRes.has_value()) { return interRes; }
             }
-            indexToLine[index].push_back(i);
+            indexToLine.append(cell, i);
         }
     }
     return {};
@@ -251,23 +393,23 @@ ConflictResultOpt ConflictChecker::find_inter_of_lines_in_diff_objs(PrintObjectP
         layersLines.push_back(std::move(lines));
     }
 
-    bool                                                          find = false;
-    tbb::concurrent_vector<std::pair<ConflictComputeResult, float>> conflict;
+    // Report the conflict of the lowest layer. The layers above a conflict already found are not checked.
+    std::vector<ConflictComputeOpt> conflicts(layersLines.size());
+    std::atomic<size_t>             first_conflict(layersLines.size());
     tbb::parallel_for(tbb::blocked_range<size_t>(0, layersLines.size()), [&](tbb::blocked_range<size_t> range) {
-        for (size_t i = range.begin(); i < range.end(); i++) {
-            auto interRes = find_inter_of_lines(layersLines[i]);
-            if (interRes.has_value()) {
-                find = true;
-                conflict.emplace_back(interRes.value(), bottomZs[i]);
+        for (size_t i = range.begin(); i < range.end() && i < first_conflict.load(std::memory_order_relaxed); i++) {
+            conflicts[i] = find_inter_of_lines(layersLines[i]);
+            if (conflicts[i].has_value()) {
+                for (size_t prev = first_conflict.load(); i < prev && !first_conflict.compare_exchange_weak(prev, i);) ;
                 break;
             }
         }
     });
 
-    if (find) {
-        const void *ptr1           = conflict[0].first._obj1;
-        const void *ptr2           = conflict[0].first._obj2;
-        float       conflictPrintZ = conflict[0].second;
+    if (size_t i = first_conflict.load(); i < layersLines.size()) {
+        const void *ptr1           = conflicts[i]->_obj1;
+        const void *ptr2           = conflicts[i]->_obj2;
+        float       conflictPrintZ = bottomZs[i];
         if (wtdptr.has_value()) {
             const FakeWipeTower *wtdp = wtdptr.value();
             if (ptr1 == wtdp || ptr2 == wtdp) {
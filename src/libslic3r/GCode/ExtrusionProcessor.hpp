@@ -297,16 +297,34 @@ class ExtrusionQualityEstimator
     const PrintObject                                                            *current_object;
 
 public:
+    // AABB trees over the boundaries and curled extrusions of a single layer.
+    // They depend on the layer only, thus they may be built in parallel ahead of the G-code generator.
+    struct LayerBoundaries
+    {
+        AABBTreeLines::LinesDistancer<Linef>      boundaries;
+        AABBTreeLines::LinesDistancer<CurledLine> curled_extrusions;
+
+        static LayerBoundaries make(const Layer &layer)
+        {
+            return { AABBTreeLines::LinesDistancer<Linef>{ to_unscaled_linesf(layer.lslices) },
+                     AABBTreeLines::LinesDistancer<CurledLine>{ layer.curled_lines } };
+        }
+    };
+
     void set_current_object(const PrintObject *object) { current_object = object; }
 
     void prepare_for_new_layer(const PrintObject * obj, const Layer *layer)
     {
         if (layer == nullptr) return;
-        const PrintObject *object = obj;
-        prev_layer_boundaries[object] = next_layer_boundaries[object];
-        next_layer_boundaries[object] = AABBTreeLines::LinesDistancer<Linef>{to_unscaled_linesf(layer->lslices)};
-        prev_curled_extrusions[object] = next_curled_extrusions[object];
-        next_curled_extrusions[object] = AABBTreeLines::LinesDistancer<CurledLine>{layer->curled_lines};
+        this->prepare_for_new_layer(obj, LayerBoundaries::make(*layer));
+    }
+
+    void prepare_for_new_layer(const PrintObject *object, LayerBoundaries &&layer_boundaries)
+    {
+        prev_layer_boundaries[object] = std::move(next_layer_boundaries[object]);
+        next_layer_boundaries[object] = std::move(layer_boundaries.boundaries);
+        prev_curled_extrusions[object] = std::move(next_curled_extrusions[object]);
+        next_curled_extrusions[object] = std::move(layer_boundaries.curled_extrusions);
     }
 
     std::vector<ProcessedPoint> estimate_extrusion_quality(const ExtrusionPath                &path,
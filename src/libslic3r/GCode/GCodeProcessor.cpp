@@ -107,7 +107,7 @@ const std::string GCodeProcessor::External_Purge_Tag = " EXTERNAL_PURGE";
 const float GCodeProcessor::Wipe_Width = 0.05f;
 const float GCodeProcessor::Wipe_Height = 0.05f;
 
-bool GCodeProcessor::s_IsBBLPrinter = true;
+std::atomic<bool> GCodeProcessor::s_IsBBLPrinter = true;
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
 const std::string GCodeProcessor::Mm3_Per_Mm_Tag = "MM3_PER_MM:";
@@ -1515,7 +1515,7 @@ const std::vector<std::pair<GCodeProcessor::EProducer, std::string>> GCodeProces
     //{ EProducer::KissSlicer,  "KISSlicer" }
 };
 
-unsigned int GCodeProcessor::s_result_id = 0;
+std::atomic<unsigned int> GCodeProcessor::s_result_id = 0;
 
 bool GCodeProcessor::contains_reserved_tag(const std::string& gcode, std::string& found_tag)
 {
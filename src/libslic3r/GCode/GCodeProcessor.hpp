@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <array>
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <string>
@@ -374,7 +375,8 @@ class Print;
         static const float Wipe_Width;
         static const float Wipe_Height;
 
-        static bool s_IsBBLPrinter;
+        // Atomic, the CLI slices a plate while exporting the G-code of the previous one.
+        static std::atomic<bool> s_IsBBLPrinter;
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
         static const std::string Mm3_Per_Mm_Tag;
@@ -832,7 +834,7 @@ class Print;
         Print* m_print{ nullptr };
 
         GCodeProcessorResult m_result;
-        static unsigned int s_result_id;
+        static std::atomic<unsigned int> s_result_id;
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
         DataChecker m_mm3_per_mm_compare{ "mm3_per_mm", 0.01f };
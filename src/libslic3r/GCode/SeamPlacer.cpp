@@ -153,8 +153,12 @@ std::vector<float> raycast_visibility(const AABBTreeIndirect::Tree<3, float> &ra
   tbb::parallel_for(tbb::blocked_range<size_t>(0, result.size()),
                     [&triangles, &precomputed_sample_directions, model_contains_negative_parts, negative_volumes_start_index,
                      &raycasting_tree, &result, &samples, seam_position](tbb::blocked_range<size_t> r) {
-                      // Maintaining hits memory outside of the loop, so it does not have to be reallocated for each query.
-                      std::vector<igl::Hit> hits;
+                      // Maintaining rays and hits memory outside of the loop, so it does not have to be reallocated for each query.
+                      std::vector<Vec3f> ray_dirs(precomputed_sample_directions.size());
+                      std::vector<Vec3d> ray_dirs_d(precomputed_sample_directions.size());
+                      std::vector<Vec3d> ray_origins_d(precomputed_sample_directions.size());
+                      std::vector<igl::Hit> first_hits;
+                      std::vector<std::vector<igl::Hit>> all_hits;
                       for (size_t s_idx = r.begin(); s_idx < r.end(); ++s_idx) {
                         result[s_idx] = 1.0f;
                         constexpr float decrease_step = 1.0f
@@ -171,33 +175,39 @@ std::vector<float> raycast_visibility(const AABBTreeIndirect::Tree<3, float> &ra
                         Frame f;
                         f.set_from_z(normal);
 
-                        for (const auto &dir : precomputed_sample_directions) {
-                          Vec3f final_ray_dir = (f.to_world(dir));
-                          if (!model_contains_negative_parts) {
-                            igl::Hit hitpoint;
-                            // FIXME: This AABBTTreeIndirect query will not compile for float ray origin and
-                            // direction.
-                            Vec3d final_ray_dir_d = final_ray_dir.cast<double>();
-                            Vec3d ray_origin_d = (center + normal * 0.01f).cast<double>(); // start above surface.
-                            bool hit = AABBTreeIndirect::intersect_ray_first_hit(triangles.vertices,
-                                                                                 triangles.indices, raycasting_tree, ray_origin_d, final_ray_dir_d, hitpoint);
-                            if (hit && its_face_normal(triangles, hitpoint.id).dot(final_ray_dir) <= 0) {
+                        // All rays of a sample start at the same point, they are traced through the AABB tree together.
+                        //TODO improve logic for order based boolean operations - consider order of volumes
+                        bool casting_from_negative_volume = model_contains_negative_parts &&
+                                                            samples.triangle_indices[s_idx] >= negative_volumes_start_index;
+                        // start above surface.
+                        Vec3d ray_origin_d = (center + normal * 0.01f).cast<double>();
+                        if (casting_from_negative_volume) // if casting from negative volume face, change start pos
+                          ray_origin_d = (center - normal * 0.01f).cast<double>();
+                        for (size_t dir_idx = 0; dir_idx < precomputed_sample_directions.size(); ++dir_idx) {
+                          Vec3f final_ray_dir = (f.to_world(precomputed_sample_directions[dir_idx]));
+                          if (casting_from_negative_volume) // if casting from negative volume face, invert direction
+                            final_ray_dir = -final_ray_dir;
+                          ray_dirs[dir_idx] = final_ray_dir;
+                          ray_dirs_d[dir_idx] = final_ray_dir.cast<double>();
+                          ray_origins_d[dir_idx] = ray_origin_d;
+                        }
+
+                        if (!model_contains_negative_parts) {
+                          AABBTreeIndirect::intersect_rays_first_hit(triangles.vertices, triangles.indices, raycasting_tree,
+                                                                     ray_origins_d, ray_dirs_d, first_hits);
+                          for (size_t dir_idx = 0; dir_idx < ray_dirs.size(); ++dir_idx) {
+                            const igl::Hit &hitpoint = first_hits[dir_idx];
+                            if (hitpoint.id != -1 && its_face_normal(triangles, hitpoint.id).dot(ray_dirs[dir_idx]) <= 0) {
                               result[s_idx] -= decrease_step;
                             }
-                          } else { //TODO improve logic for order based boolean operations - consider order of volumes
-                            bool casting_from_negative_volume = samples.triangle_indices[s_idx]
-                                                                >= negative_volumes_start_index;
-
-                            Vec3d ray_origin_d = (center + normal * 0.01f).cast<double>(); // start above surface.
-                            if (casting_from_negative_volume) { // if casting from negative volume face, invert direction, change start pos
-                              final_ray_dir = -1.0 * final_ray_dir;
-                              ray_origin_d = (center - normal * 0.01f).cast<double>();
-                            }
-                            Vec3d final_ray_dir_d = final_ray_dir.cast<double>();
-                            bool some_hit = AABBTreeIndirect::intersect_ray_all_hits(triangles.vertices,
-                                                                                     triangles.indices, raycasting_tree,
-                                                                                     ray_origin_d, final_ray_dir_d, hits);
-                            if (some_hit) {
+                          }
+                        } else {
+                          AABBTreeIndirect::intersect_rays_all_hits(triangles.vertices, triangles.indices, raycasting_tree,
+                                                                    ray_origins_d, ray_dirs_d, all_hits);
+                          for (size_t dir_idx = 0; dir_idx < ray_dirs.size(); ++dir_idx) {
+                            const std::vector<igl::Hit> &hits = all_hits[dir_idx];
+                            const Vec3f &final_ray_dir = ray_dirs[dir_idx];
+                            if (!hits.empty()) {
                               int counter = 0;
                               // NOTE: iterating in reverse, from the last hit for one simple reason: We know the state of the ray at that point;
                               //  It cannot be inside model, and it cannot be inside negative volume
@@ -14,6 +14,22 @@
 #include <Shiny/Shiny.h>
 #include <fast_float/fast_float.h>
 
+#include <atomic>
+#include <memory>
+
+#include <tbb/task_arena.h>
+// Intel redesigned some TBB interface considerably when merging TBB with their oneAPI set of libraries, see GH #7332.
+#if ! defined(TBB_VERSION_MAJOR)
+    #include <tbb/version.h>
+#endif
+#if TBB_VERSION_MAJOR >= 2021
+    #include <tbb/parallel_pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter_mode;
+#else
+    #include <tbb/pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter;
+#endif
+
 namespace Slic3r {
 
 void GCodeReader::apply_config(const GCodeConfig &config)
@@ -30,12 +46,30 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
 {
     PROFILE_FUNC();
 
+    const char *c = tokenize_line(ptr, end, gline, command);
+    this->update_relative_e(gline);
+
+    if (m_verbose)
+        std::cout << gline.m_raw << std::endl;
+
+    return c;
+}
+
+void GCodeReader::update_relative_e(const GCodeLine &gline)
+{
+    if (gline.has(E) && m_config.use_relative_e_distances)
+        m_position[E] = 0;
+}
+
+const char* GCodeReader::tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
+{
     assert(is_decimal_separator_point());
+    // No PROFILE_BLOCKs here: tokenize_line() runs on the TBB worker threads of parse_file_internal(),
+    // while the Shiny profiler keeps a single global call tree.
     
     // command and args
     const char *c = ptr;
     {
-        PROFILE_BLOCK(command_and_args);
         // Skip the whitespaces.
         command.first = skip_whitespaces(c);
         // Skip the command.
@@ -82,16 +116,12 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
                 c = skip_word(c);
         }
     }
-    
-    if (gline.has(E) && m_config.use_relative_e_distances)
-        m_position[E] = 0;
 
     // Skip the rest of the line.
     for (; ! is_end_of_line(*c); ++ c);
 
     // Copy the raw string including the comment, without the trailing newlines.
     if (c > ptr) {
-        PROFILE_BLOCK(copy_raw_string);
         gline.m_raw.assign(ptr, c);
     }
 
@@ -101,9 +131,6 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
 	if (*c == '\n')
 		++ c;
 
-    if (m_verbose)
-        std::cout << gline.m_raw << std::endl;
-
     return c;
 }
 
@@ -178,22 +205,126 @@ bool GCodeReader::parse_file_raw_internal(const std::string &filename, ParseLine
     return true;
 }
 
+// Block of complete lines read from a G-code file, tokenized in parallel by parse_file_internal().
+struct GCodeReaderChunk
+{
+    // Lines of the block, null terminated.
+    std::string                         text;
+    // Position of the start of the block in the file.
+    size_t                              file_pos { 0 };
+    std::vector<GCodeReader::GCodeLine> lines;
+    // For each line, position in the file just after its terminating '\n', zero if the line is not terminated by '\n'.
+    std::vector<size_t>                 lines_ends;
+};
+
+// Length of the complete lines at the start of text. Lines may be terminated by "\n", "\r\n" or "\r" alone.
+// '\r' at the very end of text may be the first half of "\r\n" split between two reads, thus it is left for the next block.
+static size_t complete_lines_length(const std::string &text)
+{
+    size_t last_eol = text.find_last_of("\r\n");
+    if (last_eol != std::string::npos && last_eol + 1 == text.size() && text[last_eol] == '\r')
+        last_eol = last_eol == 0 ? std::string::npos : text.find_last_of("\r\n", last_eol - 1);
+    return last_eol == std::string::npos ? 0 : last_eol + 1;
+}
+
+// The file is read in blocks of complete lines by a serial stage of a pipeline, the lines are split into commands and axes
+// by a parallel stage and then passed to the callback in the order of the file by the last serial stage.
+// Lines are only tokenized in parallel, the state of the reader (position, relative extrusion) is updated serially.
 template<typename ParseLineCallback, typename LineEndCallback>
 bool GCodeReader::parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback)
 {
-    GCodeLine gline;    
-    return this->parse_file_raw_internal(filename, 
-        [this, &gline, parse_line_callback](const char *begin, const char *end) {
-            gline.reset();
-
-            const char* begin_new = begin;
-            begin_new = skip_whitespaces(begin_new);
-            if (std::toupper(*begin_new) == 'N')
-                begin_new = skip_word(begin_new);
-            begin_new = skip_whitespaces(begin_new);
-            this->parse_line(begin_new, end, gline, parse_line_callback);
-        }, 
-        line_end_callback);
+    FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
+    if (in.f == nullptr)
+        return false;
+
+    static constexpr const size_t chunk_size = 1024 * 1024;
+    // Incomplete line at the end of the last block read.
+    std::string       line_rest;
+    size_t            file_pos   = 0;
+    bool              read_error = false;
+    std::atomic<bool> stop { false };
+    m_parsing = true;
+
+    auto reader = tbb::make_filter<void, std::shared_ptr<GCodeReaderChunk>>(slic3r_tbb_filtermode::serial_in_order,
+        [&in, &line_rest, &file_pos, &read_error, &stop](tbb::flow_control &fc) -> std::shared_ptr<GCodeReaderChunk> {
+            if (stop || (::feof(in.f) && line_rest.empty())) {
+                fc.stop();
+                return {};
+            }
+            auto chunk = std::make_shared<GCodeReaderChunk>();
+            chunk->file_pos = file_pos - line_rest.size();
+            chunk->text     = std::move(line_rest);
+            line_rest.clear();
+            size_t old_size = chunk->text.size();
+            chunk->text.resize(old_size + chunk_size);
+            size_t cnt_read = ::fread(chunk->text.data() + old_size, 1, chunk_size, in.f);
+            if (::ferror(in.f)) {
+                read_error = true;
+                fc.stop();
+                return {};
+            }
+            chunk->text.resize(old_size + cnt_read);
+            file_pos += cnt_read;
+            if (cnt_read > 0 && ! ::feof(in.f)) {
+                // Move the incomplete last line into the next block.
+                size_t len = complete_lines_length(chunk->text);
+                line_rest.assign(chunk->text.begin() + len, chunk->text.end());
+                chunk->text.resize(len);
+            }
+            return chunk;
+        });
+
+    auto tokenizer = tbb::make_filter<std::shared_ptr<GCodeReaderChunk>, std::shared_ptr<GCodeReaderChunk>>(slic3r_tbb_filtermode::parallel,
+        [](std::shared_ptr<GCodeReaderChunk> chunk) {
+            const char *begin = chunk->text.c_str();
+            const char *end   = begin + chunk->text.size();
+            std::pair<const char*, const char*> command;
+            for (const char *ptr = begin; ptr != end;) {
+                chunk->lines.emplace_back();
+                const char *begin_new = skip_whitespaces(ptr);
+                if (std::toupper(*begin_new) == 'N')
+                    begin_new = skip_word(begin_new);
+                begin_new = skip_whitespaces(begin_new);
+                ptr = tokenize_line(begin_new, end, chunk->lines.back(), command);
+                if (ptr != end && *ptr == 0) {
+                    // Binary zero inside a line, skip the rest of the line.
+                    for (; ptr != end && *ptr != '\r' && *ptr != '\n'; ++ ptr) ;
+                    if (ptr != end && *ptr == '\r')
+                        ++ ptr;
+                    if (ptr != end && *ptr == '\n')
+                        ++ ptr;
+                }
+                chunk->lines_ends.emplace_back(ptr[-1] == '\n' ? chunk->file_pos + (ptr - begin) : 0);
+            }
+            return chunk;
+        });
+
+    auto consumer = tbb::make_filter<std::shared_ptr<GCodeReaderChunk>, void>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &stop, &parse_line_callback, &line_end_callback](std::shared_ptr<GCodeReaderChunk> chunk) {
+            if (stop)
+                return;
+            for (size_t i = 0; i < chunk->lines.size(); ++ i) {
+                GCodeLine &gline = chunk->lines[i];
+                std::pair<const char*, const char*> command;
+                command.first  = skip_whitespaces(gline.m_raw.c_str());
+                command.second = skip_word(command.first);
+                this->update_relative_e(gline);
+                if (m_verbose)
+                    std::cout << gline.m_raw << std::endl;
+                parse_line_callback(*this, gline);
+                this->update_coordinates(gline, command);
+                if (! m_parsing) {
+                    // The callback wishes to exit, the end of its line is not reported.
+                    stop = true;
+                    return;
+                }
+                if (chunk->lines_ends[i] != 0)
+                    line_end_callback(chunk->lines_ends[i]);
+            }
+        });
+
+    tbb::parallel_pipeline(2 * tbb::this_task_arena::max_concurrency(), reader & tokenizer & consumer);
+    return ! read_error;
 }
 
 bool GCodeReader::parse_file(const std::string &file, callback_t callback)
@@ -174,6 +174,10 @@ private:
     bool        parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
 
     const char* parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    // Stateless part of parse_line_internal(): Split the line into the command and axes, may be called from multiple threads.
+    static const char* tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    // Stateful part of parse_line_internal(), to be called in the order of the lines.
+    void        update_relative_e(const GCodeLine &gline);
     void        update_coordinates(GCodeLine &gline, std::pair<const char*, const char*> &command);
 
     static bool         is_whitespace(char c)           { return c == ' ' || c == '\t'; }
@@ -1,7 +1,6 @@
 #include "GCodeWriter.hpp"
 #include "CustomGCode.hpp"
 #include <algorithm>
-#include <iomanip>
 #include <iostream>
 #include <map>
 #include <assert.h>
@@ -16,7 +15,7 @@
 
 namespace Slic3r {
 
-bool GCodeWriter::full_gcode_comment = true;
+std::atomic<bool> GCodeWriter::full_gcode_comment = true;
 
 bool GCodeWriter::supports_separate_travel_acceleration(GCodeFlavor flavor)
 {
@@ -59,11 +58,11 @@ void GCodeWriter::set_extruders(std::vector<unsigned int> extruder_ids)
 
 std::string GCodeWriter::preamble()
 {
-    std::ostringstream gcode;
+    std::string gcode;
 
     if (FLAVOR_IS_NOT(gcfMakerWare)) {
-        gcode << "G90\n";
-        gcode << "G21\n";
+        gcode += "G90\n";
+        gcode += "G21\n";
     }
     if (FLAVOR_IS(gcfRepRapSprinter) ||
         FLAVOR_IS(gcfRepRapFirmware) ||
@@ -75,22 +74,22 @@ std::string GCodeWriter::preamble()
         FLAVOR_IS(gcfKlipper))
     {
         if (this->config.use_relative_e_distances) {
-            gcode << "M83 ; use relative distances for extrusion\n";
+            gcode += "M83 ; use relative distances for extrusion\n";
         } else {
-            gcode << "M82 ; use absolute distances for extrusion\n";
+            gcode += "M82 ; use absolute distances for extrusion\n";
         }
-        gcode << this->reset_e(true);
+        gcode += this->reset_e(true);
     }
 
-    return gcode.str();
+    return gcode;
 }
 
 std::string GCodeWriter::postamble() const
 {
-    std::ostringstream gcode;
+    std::string gcode;
     if (FLAVOR_IS(gcfMachinekit))
-          gcode << "M2 ; end of program\n";
-    return gcode.str();
+          gcode += "M2 ; end of program\n";
+    return gcode;
 }
 
 std::string GCodeWriter::set_temperature(unsigned int temperature, GCodeFlavor flavor, bool wait, int tool, std::string comment){
@@ -112,25 +111,28 @@ std::string GCodeWriter::set_temperature(unsigned int temperature, GCodeFlavor f
             comment = "set nozzle temperature";
     }
 
-    std::ostringstream gcode;
-    gcode << code << " ";
+    GCodeFormatter gcode;
+    gcode.emit_string(code);
+    gcode.emit_char(' ');
     if (flavor == gcfMach3 || flavor == gcfMachinekit) {
-        gcode << "P";
+        gcode.emit_char('P');
     } else {
-        gcode << "S";
+        gcode.emit_char('S');
     }
-    gcode << temperature;
+    gcode.emit_int(temperature);
     if (tool != -1) {
         if (flavor == gcfRepRapFirmware) {
-            gcode << " P" << tool;
+            gcode.emit_string(" P");
         } else {
-            gcode << " T" << tool;
+            gcode.emit_string(" T");
         }
+        gcode.emit_int(tool);
     }
-    gcode << " ; " << comment << "\n";
+    gcode.emit_comment(true, comment);
+    gcode.emit_eol();
 
     if ((flavor == gcfTeacup || flavor == gcfRepRapFirmware) && wait)
-        gcode << "M116 ; wait for temperature to be reached\n";
+        gcode.emit_string("M116 ; wait for temperature to be reached\n");
 
     return gcode.str();
 }
@@ -152,41 +154,32 @@ std::string GCodeWriter::set_bed_temperature(int temperature, bool wait)
     m_last_bed_temperature = temperature;
     m_last_bed_temperature_reached = wait;
 
-    std::string code, comment;
-    std::ostringstream gcode;
-
-    if (wait) {
-        code = "M190";
-        comment = "set bed temperature and wait for it to be reached";
-    }
-    else {
-        code = "M140";
-        comment = "set bed temperature";
-    }
-
-    gcode << code << " S" << temperature << " ; " << comment << "\n";
-    return gcode.str();
+    GCodeFormatter gcode;
+    gcode.emit_string(wait ? "M190 S" : "M140 S");
+    gcode.emit_int(temperature);
+    gcode.emit_string(wait ? " ; set bed temperature and wait for it to be reached" : " ; set bed temperature");
+    return gcode.string();
 }
 
 std::string GCodeWriter::set_chamber_temperature(int temperature, bool wait)
 {
-    std::string code, comment;
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
 
     if (wait)
     {
         // Orca: should we let the M191 command to turn on the auxiliary fan?
         if (config.auxiliary_fan)
-            gcode << "M106 P2 S255 \n";
-        gcode << "M191 S" << std::to_string(temperature) << " ;"
-              << "set chamber_temperature and wait for it to be reached\n";
+            gcode.emit_string("M106 P2 S255 \n");
+        gcode.emit_string("M191 S");
+        gcode.emit_int(temperature);
+        gcode.emit_string(" ;set chamber_temperature and wait for it to be reached\n");
         if (config.auxiliary_fan)
-            gcode << "M106 P2 S0 \n";
+            gcode.emit_string("M106 P2 S0 \n");
     }
     else {
-        code = "M141";
-        comment = "set chamber_temperature";
-        gcode << code << " S" << temperature << ";" << comment << "\n";
+        gcode.emit_string("M141 S");
+        gcode.emit_int(temperature);
+        gcode.emit_string(";set chamber_temperature\n");
     }
     return gcode.str();
 }
@@ -209,26 +202,30 @@ std::string GCodeWriter::set_acceleration_internal(Acceleration type, unsigned i
 
     last_value = acceleration;
 
-    std::ostringstream gcode;
-    if (FLAVOR_IS(gcfRepetier))
-        gcode << (separate_travel ? "M202 X" : "M201 X") << acceleration << " Y" << acceleration;
-    else if (FLAVOR_IS(gcfRepRapFirmware) || FLAVOR_IS(gcfMarlinFirmware))
-        gcode << (separate_travel ? "M204 T" : "M204 P") << acceleration;
-    else if (FLAVOR_IS(gcfKlipper)) {
-        gcode << "SET_VELOCITY_LIMIT ACCEL=" << acceleration;
+    GCodeFormatter gcode;
+    if (FLAVOR_IS(gcfRepetier)) {
+        gcode.emit_string(separate_travel ? "M202 X" : "M201 X");
+        gcode.emit_int(acceleration);
+        gcode.emit_string(" Y");
+        gcode.emit_int(acceleration);
+    } else if (FLAVOR_IS(gcfRepRapFirmware) || FLAVOR_IS(gcfMarlinFirmware)) {
+        gcode.emit_string(separate_travel ? "M204 T" : "M204 P");
+        gcode.emit_int(acceleration);
+    } else if (FLAVOR_IS(gcfKlipper)) {
+        gcode.emit_string("SET_VELOCITY_LIMIT ACCEL=");
+        gcode.emit_int(acceleration);
         if (this->config.accel_to_decel_enable) {
-            gcode << " ACCEL_TO_DECEL=" << acceleration * this->config.accel_to_decel_factor / 100;
-            if (GCodeWriter::full_gcode_comment)
-                gcode << " ; adjust ACCEL_TO_DECEL";
+            gcode.emit_string(" ACCEL_TO_DECEL=");
+            gcode.emit_general(acceleration * this->config.accel_to_decel_factor / 100);
+            gcode.emit_comment(GCodeWriter::full_gcode_comment, "adjust ACCEL_TO_DECEL");
         }
+    } else {
+        gcode.emit_string("M204 S");
+        gcode.emit_int(acceleration);
     }
-    else
-        gcode << "M204 S" << acceleration;
 
-    if (GCodeWriter::full_gcode_comment) gcode << " ; adjust acceleration";
-    gcode << "\n";
-
-    return gcode.str();
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, "adjust acceleration");
+    return gcode.string();
 }
 
 std::string GCodeWriter::set_jerk_xy(double jerk)
@@ -238,7 +235,7 @@ std::string GCodeWriter::set_jerk_xy(double jerk)
     
     m_last_jerk = jerk;
 
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     if (FLAVOR_IS(gcfKlipper)) {
         // Clamp the jerk to the allowed maximum.
         if (m_max_jerk_x > 0 && jerk > m_max_jerk_x)
@@ -246,7 +243,8 @@ std::string GCodeWriter::set_jerk_xy(double jerk)
         if (m_max_jerk_y > 0 && jerk > m_max_jerk_y)
             jerk = m_max_jerk_y;
         
-        gcode << "SET_VELOCITY_LIMIT SQUARE_CORNER_VELOCITY=" << jerk;
+        gcode.emit_string("SET_VELOCITY_LIMIT SQUARE_CORNER_VELOCITY=");
+        gcode.emit_general(jerk);
     } else {
         double jerk_x = jerk;
         double jerk_y = jerk;
@@ -256,16 +254,21 @@ std::string GCodeWriter::set_jerk_xy(double jerk)
         if (m_max_jerk_y > 0 && jerk > m_max_jerk_y)
             jerk_y = m_max_jerk_y;
         
-        gcode << "M205 X" << jerk_x << " Y" << jerk_y;
+        gcode.emit_string("M205 X");
+        gcode.emit_general(jerk_x);
+        gcode.emit_string(" Y");
+        gcode.emit_general(jerk_y);
     }
       
-    if (m_is_bbl_printers)
-        gcode << std::setprecision(2) << " Z" << m_max_jerk_z << " E" << m_max_jerk_e;
+    if (m_is_bbl_printers) {
+        gcode.emit_string(" Z");
+        gcode.emit_general(m_max_jerk_z, 2);
+        gcode.emit_string(" E");
+        gcode.emit_general(m_max_jerk_e, 2);
+    }
 
-    if (GCodeWriter::full_gcode_comment) gcode << " ; adjust jerk";
-    gcode << "\n";
-
-    return gcode.str();
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, "adjust jerk");
+    return gcode.string();
 
 }
 
@@ -280,12 +283,14 @@ std::string GCodeWriter::set_accel_and_jerk(unsigned int acceleration, double je
         acceleration = m_max_acceleration;
     
     bool is_empty = true;
-    std::ostringstream gcode;
-    gcode << "SET_VELOCITY_LIMIT";
+    GCodeFormatter gcode;
+    gcode.emit_string("SET_VELOCITY_LIMIT");
     if (acceleration != 0 && acceleration != m_last_acceleration) {
-        gcode << " ACCEL=" << acceleration;
+        gcode.emit_string(" ACCEL=");
+        gcode.emit_int(acceleration);
         if (this->config.accel_to_decel_enable) {
-            gcode << " ACCEL_TO_DECEL=" << acceleration * this->config.accel_to_decel_factor / 100;
+            gcode.emit_string(" ACCEL_TO_DECEL=");
+            gcode.emit_general(acceleration * this->config.accel_to_decel_factor / 100);
         }
         m_last_acceleration = acceleration;
         is_empty = false;
@@ -297,7 +302,8 @@ std::string GCodeWriter::set_accel_and_jerk(unsigned int acceleration, double je
         jerk = m_max_jerk_y;
 
     if (jerk > 0.01 && !is_approx(jerk, m_last_jerk)) {
-        gcode << " SQUARE_CORNER_VELOCITY=" << jerk;
+        gcode.emit_string(" SQUARE_CORNER_VELOCITY=");
+        gcode.emit_general(jerk);
         m_last_jerk = jerk;
         is_empty = false;
     }
@@ -305,50 +311,45 @@ std::string GCodeWriter::set_accel_and_jerk(unsigned int acceleration, double je
     if(is_empty)
         return std::string();
 
-    if (GCodeWriter::full_gcode_comment)
-        gcode << " ; adjust VELOCITY_LIMIT(accel/jerk)";
-    gcode << "\n";
-
-    return gcode.str();
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, "adjust VELOCITY_LIMIT(accel/jerk)");
+    return gcode.string();
 
 }
 
 std::string GCodeWriter::set_junction_deviation(double junction_deviation){
-    std::ostringstream gcode;
     if (FLAVOR_IS(gcfMarlinFirmware) && junction_deviation > 0 && m_max_junction_deviation > 0) {
+        GCodeFormatter gcode;
         // Clamp the junction deviation to the allowed maximum.
-        gcode << "M205 J";
-        if (junction_deviation <= m_max_junction_deviation) {
-            gcode << std::fixed << std::setprecision(3) << junction_deviation;
-        } else {
-            gcode << std::fixed << std::setprecision(3) << m_max_junction_deviation;
-        }
-        if (GCodeWriter::full_gcode_comment) {
-            gcode << " ; Junction Deviation";
-        }
-        gcode << "\n";
+        gcode.emit_string("M205 J");
+        gcode.emit_fixed(std::min(junction_deviation, m_max_junction_deviation), 3);
+        gcode.emit_comment(GCodeWriter::full_gcode_comment, "Junction Deviation");
+        return gcode.string();
     }
-    return gcode.str();
+    return std::string();
 }
 
 std::string GCodeWriter::set_pressure_advance(double pa) const
 {
-    std::ostringstream gcode;
     if (pa < 0)
-        return gcode.str();
+        return std::string();
+    GCodeFormatter gcode;
     if(m_is_bbl_printers){
         //SoftFever: set L1000 to use linear model
-        gcode << "M900 K" <<std::setprecision(4)<< pa << " L1000 M10 ; Override pressure advance value\n";
+        gcode.emit_string("M900 K");
+        gcode.emit_general(pa, 4);
+        gcode.emit_string(" L1000 M10 ; Override pressure advance value");
     }
     else{
         if (FLAVOR_IS(gcfKlipper))
-            gcode << "SET_PRESSURE_ADVANCE ADVANCE=" << std::setprecision(4) << pa << "; Override pressure advance value\n";
+            gcode.emit_string("SET_PRESSURE_ADVANCE ADVANCE=");
         else if(FLAVOR_IS(gcfRepRapFirmware))
-            gcode << ("M572 D0 S") << std::setprecision(4) << pa << "; Override pressure advance value\n";
+            gcode.emit_string("M572 D0 S");
         else
-            gcode << "M900 K" <<std::setprecision(4)<< pa << "; Override pressure advance value\n";
+            gcode.emit_string("M900 K");
+        gcode.emit_general(pa, 4);
+        gcode.emit_string("; Override pressure advance value");
     }
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::set_input_shaping(char axis, float damp, float freq, std::string type) const
@@ -359,61 +360,78 @@ std::string GCodeWriter::set_input_shaping(char axis, float damp, float freq, st
     {
     throw std::runtime_error("Invalid input shaping parameters: freq=" + std::to_string(freq) + ", damp=" + std::to_string(damp));
     }
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     if (FLAVOR_IS(gcfKlipper)) {
-        gcode << "SET_INPUT_SHAPER";
+        gcode.emit_string("SET_INPUT_SHAPER");
         if (!type.empty() && type != "Default") {
-                gcode << " SHAPER_TYPE=" << type;
+                gcode.emit_string(" SHAPER_TYPE=");
+                gcode.emit_string(type);
         }
         if (axis != 'A')
         {
             if (freq > 0.0f) {
-                gcode << " SHAPER_FREQ_" << axis << "=" << std::fixed << std::setprecision(2) << freq;
+                gcode.emit_string(" SHAPER_FREQ_");
+                gcode.emit_char(axis);
+                gcode.emit_char('=');
+                gcode.emit_fixed(freq, 2);
             }
             if (damp > 0.0f){
-                gcode  << " DAMPING_RATIO_" << axis << "=" << std::fixed << std::setprecision(3) << damp;
+                gcode.emit_string(" DAMPING_RATIO_");
+                gcode.emit_char(axis);
+                gcode.emit_char('=');
+                gcode.emit_fixed(damp, 3);
             }
         } else {
             if (freq > 0.0f) {
-                gcode << " SHAPER_FREQ_X=" << std::fixed << std::setprecision(2) << freq << " SHAPER_FREQ_Y=" << std::fixed << std::setprecision(2) << freq;
+                gcode.emit_string(" SHAPER_FREQ_X=");
+                gcode.emit_fixed(freq, 2);
+                gcode.emit_string(" SHAPER_FREQ_Y=");
+                gcode.emit_fixed(freq, 2);
             }
             if (damp > 0.0f) {
-                gcode << " DAMPING_RATIO_X=" << std::fixed << std::setprecision(3) << damp << " DAMPING_RATIO_Y=" << std::fixed << std::setprecision(3) << damp;
+                gcode.emit_string(" DAMPING_RATIO_X=");
+                gcode.emit_fixed(damp, 3);
+                gcode.emit_string(" DAMPING_RATIO_Y=");
+                gcode.emit_fixed(damp, 3);
             }
         }
     } else if (FLAVOR_IS(gcfRepRapFirmware)) {
-        gcode << "M593";
+        gcode.emit_string("M593");
         if (!type.empty() && type != "Default" && type != "DAA") {
-            gcode << " P\"" << type << "\"";
+            gcode.emit_string(" P\"");
+            gcode.emit_string(type);
+            gcode.emit_char('"');
         }
         if (freq > 0.0f) {
-            gcode << " F" << std::fixed << std::setprecision(2) << freq;
+            gcode.emit_string(" F");
+            gcode.emit_fixed(freq, 2);
         }
         if (damp > 0.0f){
-            gcode  << " S" << std::fixed << std::setprecision(3) << damp;
+            gcode.emit_string(" S");
+            gcode.emit_fixed(damp, 3);
         }
     } else if (FLAVOR_IS(gcfMarlinFirmware)) {
-        gcode << "M593";
+        gcode.emit_string("M593");
         if (axis != 'A')
         {
-            gcode << " " << axis;
+            gcode.emit_char(' ');
+            gcode.emit_char(axis);
         }
         if (freq > 0.0f)
         {
-            gcode << " F" << std::fixed << std::setprecision(2) << freq;
+            gcode.emit_string(" F");
+            gcode.emit_fixed(freq, 2);
         }
         if (damp > 0.0f)
         {
-            gcode << " D" << std::fixed << std::setprecision(3) << damp;
+            gcode.emit_string(" D");
+            gcode.emit_fixed(damp, 3);
         }
     } else {
         throw std::runtime_error("Input shaping is only supported by Klipper, RepRapFirmware and Marlin 2");
     }
-    if (GCodeWriter::full_gcode_comment){
-        gcode << " ; Override input shaping";
-    }
-    gcode << "\n";
-    return gcode.str();
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, "Override input shaping");
+    return gcode.string();
 }
 
 
@@ -431,12 +449,11 @@ std::string GCodeWriter::reset_e(bool force)
     }
 
     if (! this->config.use_relative_e_distances) {
-        std::ostringstream gcode;
-        gcode << "G92 E0";
+        GCodeFormatter gcode;
+        gcode.emit_string("G92 E0");
         //BBS
-        if (GCodeWriter::full_gcode_comment) gcode << " ; reset extrusion distance";
-        gcode << "\n";
-        return gcode.str();
+        gcode.emit_comment(GCodeWriter::full_gcode_comment, "reset extrusion distance");
+        return gcode.string();
     } else {
         return "";
     }
@@ -454,12 +471,12 @@ std::string GCodeWriter::update_progress(unsigned int num, unsigned int tot, boo
     unsigned int percent = (unsigned int)floor(100.0 * num / tot + 0.5);
     if (!allow_100) percent = std::min(percent, (unsigned int)99);
 
-    std::ostringstream gcode;
-    gcode << "M73 P" << percent;
+    GCodeFormatter gcode;
+    gcode.emit_string("M73 P");
+    gcode.emit_int(percent);
     //BBS
-    if (GCodeWriter::full_gcode_comment) gcode << " ; update progress";
-    gcode << "\n";
-    return gcode.str();
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, "update progress");
+    return gcode.string();
 }
 
 std::string GCodeWriter::toolchange_prefix() const
@@ -479,20 +496,19 @@ std::string GCodeWriter::toolchange(unsigned int filament_id)
 
     // return the toolchange command
     // if we are running a single-extruder setup, just set the extruder and return nothing
-    std::ostringstream gcode;
     if (this->multiple_extruders || (this->config.filament_diameter.values.size() > 1 && !is_bbl_printers())) {
+        GCodeFormatter gcode;
         // BBS
         if (this->m_is_bbl_printers)
-            gcode << "M1020 S" << filament_id;
+            gcode.emit_string("M1020 S");
         else
-            gcode << this->toolchange_prefix() << filament_id;
+            gcode.emit_string(this->toolchange_prefix());
+        gcode.emit_int(filament_id);
         //BBS
-        if (GCodeWriter::full_gcode_comment)
-            gcode << " ; change extruder";
-        gcode << "\n";
-        gcode << this->reset_e(true);
+        gcode.emit_comment(GCodeWriter::full_gcode_comment, "change extruder");
+        return gcode.string() + this->reset_e(true);
     }
-    return gcode.str();
+    return std::string();
 }
 
 std::string GCodeWriter::set_speed(double F, const std::string &comment, const std::string &cooling_marker)
@@ -913,36 +929,34 @@ std::string GCodeWriter::unlift()
 
 std::string GCodeWriter::set_fan(const GCodeFlavor gcode_flavor, unsigned int speed)
 {
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     if (speed == 0) {
         switch (gcode_flavor) {
         case gcfTeacup:
-            gcode << "M106 S0"; break;
+            gcode.emit_string("M106 S0"); break;
         case gcfMakerWare:
         case gcfSailfish:
-            gcode << "M127";    break;
+            gcode.emit_string("M127");    break;
         default:
-            gcode << "M106 S0";    break;
+            gcode.emit_string("M106 S0");    break;
         }
-        if (GCodeWriter::full_gcode_comment)
-            gcode << " ; disable fan";
-        gcode << "\n";
+        gcode.emit_comment(GCodeWriter::full_gcode_comment, "disable fan");
     } else {
         switch (gcode_flavor) {
         case gcfMakerWare:
         case gcfSailfish:
-            gcode << "M126";    break;
+            gcode.emit_string("M126");    break;
         case gcfMach3:
         case gcfMachinekit:
-            gcode << "M106 P" << static_cast<unsigned int>(255.5 * speed / 100.0); break;
+            gcode.emit_string("M106 P");
+            gcode.emit_int(static_cast<unsigned int>(255.5 * speed / 100.0)); break;
         default:
-            gcode << "M106 S" << static_cast<unsigned int>(255.5 * speed / 100.0); break;
+            gcode.emit_string("M106 S");
+            gcode.emit_int(static_cast<unsigned int>(255.5 * speed / 100.0)); break;
         }
-        if (GCodeWriter::full_gcode_comment)
-            gcode << " ; enable fan";
-        gcode << "\n";
+        gcode.emit_comment(GCodeWriter::full_gcode_comment, "enable fan");
     }
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::set_fan(unsigned int speed) const
@@ -954,26 +968,22 @@ std::string GCodeWriter::set_fan(unsigned int speed) const
 //BBS: set additional fan speed for BBS machine only
 std::string GCodeWriter::set_additional_fan(unsigned int speed)
 {
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
 
-    gcode << "M106 " << "P2 " << "S" << (int)(255.0 * speed / 100.0);
-    if (GCodeWriter::full_gcode_comment) {
-        if (speed == 0)
-            gcode << " ; disable additional fan ";
-        else
-            gcode << " ; enable additional fan ";
-    }
-    gcode << "\n";
-    return gcode.str();
+    gcode.emit_string("M106 P2 S");
+    gcode.emit_int((int)(255.0 * speed / 100.0));
+    gcode.emit_comment(GCodeWriter::full_gcode_comment, speed == 0 ? "disable additional fan " : "enable additional fan ");
+    return gcode.string();
 }
 
 std::string GCodeWriter::set_exhaust_fan( int speed,bool add_eol)
 {
-    std::ostringstream gcode;
-    gcode << "M106" << " P3" << " S" << (int)(speed / 100.0 * 255);
+    GCodeFormatter gcode;
+    gcode.emit_string("M106 P3 S");
+    gcode.emit_int((int)(speed / 100.0 * 255));
 
     if(add_eol)
-        gcode << "\n";
+        gcode.emit_eol();
     return gcode.str();
 }
 
@@ -1028,9 +1038,55 @@ bool GCodeWriter::need_toolchange(unsigned int filament_id)const
     return filament()==nullptr || filament()->id()!=filament_id;
 }
 
+void GCodeFormatter::emit_int64(int64_t v)
+{
+    // Sign and 19 digits.
+    this->reserve(20);
+#ifdef __APPLE__
+    boost::spirit::karma::generate(this->ptr_err.ptr, boost::spirit::karma::int_generator<int64_t>(), v);
+#else
+    this->ptr_err = std::to_chars(this->ptr_err.ptr, this->buf_end, v);
+#endif
+}
+
+void GCodeFormatter::emit_printf(const char *format, int precision, double v)
+{
+    size_t space = this->buf_end - this->ptr_err.ptr;
+    int    len   = snprintf(this->ptr_err.ptr, space, format, precision, v);
+    if (len < 0)
+        return;
+    if (size_t(len) < space) {
+        this->ptr_err.ptr += len;
+        return;
+    }
+    // Truncated, snprintf() returned the length it would have written. Spill the buffer and format again,
+    // into the empty buffer if the number fits, otherwise (%f of a huge value) straight into m_spill.
+    this->spill();
+    if (size_t(len) < buflen) {
+        this->ptr_err.ptr += snprintf(this->ptr_err.ptr, buflen, format, precision, v);
+    } else {
+        size_t old_size = m_spill.size();
+        m_spill.resize(old_size + len + 1);
+        snprintf(m_spill.data() + old_size, len + 1, format, precision, v);
+        m_spill.resize(old_size + len);
+    }
+}
+
+void GCodeFormatter::emit_general(double v, int precision)
+{
+    // printf("%g") is what std::ostream uses internally for the default float field.
+    this->emit_printf("%.*g", precision, v);
+}
+
+void GCodeFormatter::emit_fixed(double v, int precision)
+{
+    this->emit_printf("%.*f", precision, v);
+}
+
 void GCodeFormatter::emit_axis(const char axis, const double v, size_t digits) {
     assert(digits <= 9);
     static constexpr const std::array<int, 10> pow_10{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    this->reserve(max_axis_len);
     *ptr_err.ptr++ = ' '; *ptr_err.ptr++ = axis;
 
     char *base_ptr = this->ptr_err.ptr;
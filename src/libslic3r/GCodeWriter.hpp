@@ -2,8 +2,11 @@
 #define slic3r_GCodeWriter_hpp_
 
 #include "libslic3r.h"
+#include <atomic>
 #include <string>
 #include <charconv>
+#include <cstring>
+#include <type_traits>
 #include "Extruder.hpp"
 #include "Point.hpp"
 #include "PrintConfig.hpp"
@@ -114,7 +117,7 @@ public:
     void set_current_position_clear(bool clear) { m_is_current_pos_clear = clear; };
     bool is_current_position_clear() const { return m_is_current_pos_clear; };
     //BBS:
-    static bool full_gcode_comment;
+    static std::atomic<bool> full_gcode_comment;
     //SoftFever
     void set_is_bbl_machine(bool bval) {m_is_bbl_printers = bval;}
     const bool is_bbl_printers() const {return m_is_bbl_printers;}
@@ -250,27 +253,99 @@ public:
     }
 
     void emit_string(const std::string &s) {
-        strncpy(ptr_err.ptr, s.c_str(), s.size());
-        ptr_err.ptr += s.size();
+        this->emit_string(s.data(), s.size());
+    }
+
+    void emit_string(const char *s) {
+        this->emit_string(s, strlen(s));
+    }
+
+    void emit_string(const char *s, size_t len) {
+        if (len > buflen / 2) {
+            // Long strings (custom comments, tags) are not copied into the fixed buffer at all.
+            this->spill();
+            m_spill.append(s, len);
+        } else {
+            this->reserve(len);
+            memcpy(ptr_err.ptr, s, len);
+            ptr_err.ptr += len;
+        }
+    }
+
+    void emit_char(const char c) {
+        this->reserve(1);
+        *ptr_err.ptr ++ = c;
+    }
+
+    // Integer parameter of a command (temperature, acceleration, fan speed, tool index ...).
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    void emit_int(T v) {
+        this->emit_int64(int64_t(v));
+    }
+
+    // Same output as std::ostream << v with std::setprecision(precision), but without the stream and locale overhead.
+    void emit_general(double v, int precision = 6);
+    // Same output as std::ostream << std::fixed << std::setprecision(precision) << v.
+    void emit_fixed(double v, int precision);
+
+    void emit_eol() {
+        this->emit_char('\n');
     }
 
     void emit_comment(bool allow_comments, const std::string &comment) {
         if (allow_comments && ! comment.empty()) {
-            *ptr_err.ptr ++ = ' '; *ptr_err.ptr ++ = ';'; *ptr_err.ptr ++ = ' ';
+            this->emit_string(" ; ", 3);
+            this->emit_string(comment);
+        }
+    }
+
+    void emit_comment(bool allow_comments, const char *comment) {
+        if (allow_comments && *comment != 0) {
+            this->emit_string(" ; ", 3);
             this->emit_string(comment);
         }
     }
 
     std::string string() {
-        *ptr_err.ptr ++ = '\n';
-        return std::string(this->buf, ptr_err.ptr - buf);
+        this->emit_char('\n');
+        return this->str();
+    }
+
+    // Returns the formatted G-code without appending a newline. Used for multi-line commands
+    // with newlines emitted through emit_eol().
+    std::string str() const {
+        if (m_spill.empty())
+            return std::string(this->buf, ptr_err.ptr - buf);
+        std::string out;
+        out.reserve(m_spill.size() + (ptr_err.ptr - buf));
+        out.append(m_spill).append(this->buf, ptr_err.ptr - buf);
+        return out;
     }
 
 protected:
+    void emit_int64(int64_t v);
+    void emit_printf(const char *format, int precision, double v);
+
+    // Make sure there is space for n more characters in buf. If there is not, the text formatted so far
+    // is moved to m_spill, which only happens for unusually long commands.
+    void reserve(size_t n) {
+        assert(n <= buflen);
+        if (size_t(buf_end - ptr_err.ptr) < n)
+            this->spill();
+    }
+    void spill() {
+        m_spill.append(this->buf, ptr_err.ptr - buf);
+        ptr_err.ptr = this->buf;
+    }
+
     static constexpr const size_t   buflen = 256;
+    // Longest output of emit_axis(): separator, axis, sign, 19 digits of int64_t, decimal point and zero padding.
+    static constexpr const size_t   max_axis_len = 40;
     char                            buf[buflen];
     char* buf_end;
     std::to_chars_result            ptr_err;
+    // Text formatted before buf ran out of space, prepended to buf by str().
+    std::string                     m_spill;
 };
 
 class GCodeG1Formatter : public GCodeFormatter {
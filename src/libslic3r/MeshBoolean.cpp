@@ -564,13 +564,13 @@ TriangleMesh mcut_to_triangle_mesh(const McutMesh &mcutmesh)
 }
 
 void merge_mcut_meshes(McutMesh& src, const McutMesh& cut) {
-    indexed_triangle_set all_its;
-    TriangleMesh tri_src = mcut_to_triangle_mesh(src);
-    TriangleMesh tri_cut = mcut_to_triangle_mesh(cut);
-    its_merge(all_its, tri_src.its);
-    its_merge(all_its, tri_cut.its);
-    src = *triangle_mesh_to_mcut(all_its);
-    }
+    const auto vertex_offset = uint32_t(src.vertexCoordsArray.size() / 3);
+    src.vertexCoordsArray.insert(src.vertexCoordsArray.end(), cut.vertexCoordsArray.begin(), cut.vertexCoordsArray.end());
+    src.faceSizesArray.insert(src.faceSizesArray.end(), cut.faceSizesArray.begin(), cut.faceSizesArray.end());
+    src.faceIndicesArray.reserve(src.faceIndicesArray.size() + cut.faceIndicesArray.size());
+    for (uint32_t vi : cut.faceIndicesArray)
+        src.faceIndicesArray.push_back(vi + vertex_offset);
+}
 
 MCAPI_ATTR void MCAPI_CALL mcDebugOutput(McDebugSource source,
     McDebugType type,
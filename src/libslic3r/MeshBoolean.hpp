@@ -83,6 +83,8 @@ bool empty(const McutMesh &mesh);
 
 McutMeshPtr  triangle_mesh_to_mcut(const indexed_triangle_set &M);
 TriangleMesh mcut_to_triangle_mesh(const McutMesh &mcutmesh);
+// Append the faces of cut to src without any boolean operation.
+void merge_mcut_meshes(McutMesh &src, const McutMesh &cut);
 
 // do boolean and save result to srcMesh
 // return true if sucessful
@@ -0,0 +1,148 @@
+#ifndef slic3r_NodeArena_hpp_
+#define slic3r_NodeArena_hpp_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Slic3r {
+
+// Memory arena handing out memory from large blocks. Memory returned to the arena is kept in a free list
+// of its size and reused by the next allocation of the same size, the blocks are only released at once
+// when the arena is destroyed or cleared. Suited for node based containers (std::list, std::map, ...)
+// of many small objects, which are inserted and erased while being built and torn down together.
+// Not thread safe, use one arena per thread or per task.
+class NodeArena
+{
+public:
+    explicit NodeArena(size_t block_size = 64 * 1024) : m_block_size(block_size) {}
+    NodeArena(const NodeArena &) = delete;
+    NodeArena& operator=(const NodeArena &) = delete;
+
+    void* allocate(size_t size, size_t alignment)
+    {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        size = padded_size(size);
+        if (FreeList *free_list = this->free_list(size, alignment); free_list && free_list->head) {
+            FreeNode *node = free_list->head;
+            free_list->head = node->next;
+            m_allocated += size;
+            return node;
+        }
+        auto ptr = (reinterpret_cast<uintptr_t>(m_ptr) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (m_ptr == nullptr || ptr + size > reinterpret_cast<uintptr_t>(m_end)) {
+            // An allocation larger than the block size gets a block of its own.
+            const size_t block_size = std::max(m_block_size, size + alignment);
+            m_blocks.emplace_back(new char[block_size]);
+            m_reserved += block_size;
+            m_ptr = m_blocks.back().get();
+            m_end = m_ptr + block_size;
+            ptr   = (reinterpret_cast<uintptr_t>(m_ptr) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        }
+        m_ptr = reinterpret_cast<char*>(ptr + size);
+        m_allocated += size;
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    // Return memory to the free list of its size, to be reused by allocate() with the same size and alignment.
+    void deallocate(void *ptr, size_t size, size_t alignment) noexcept
+    {
+        assert(ptr != nullptr);
+        size = padded_size(size);
+        FreeList *free_list = this->free_list(size, alignment);
+        if (free_list == nullptr) {
+            // Few distinct sizes are expected, a node based container allocates its nodes only.
+            // Allocating the free list may throw, then the memory is only released with the arena.
+            try {
+                free_list = &m_free_lists.emplace_back(FreeList{ size, alignment, nullptr });
+            } catch (...) {
+                return;
+            }
+        }
+        auto *node = reinterpret_cast<FreeNode*>(ptr);
+        node->next = free_list->head;
+        free_list->head = node;
+        m_allocated -= size;
+    }
+
+    // Release all the memory. All objects allocated from the arena have to be destroyed already.
+    void clear()
+    {
+        m_blocks.clear();
+        m_free_lists.clear();
+        m_ptr       = nullptr;
+        m_end       = nullptr;
+        m_allocated = 0;
+        m_reserved  = 0;
+    }
+
+    // Sum of the sizes of the allocations not returned to the arena.
+    size_t allocated() const { return m_allocated; }
+    // Memory held by the arena.
+    size_t reserved() const { return m_reserved; }
+
+private:
+    struct FreeNode {
+        FreeNode *next;
+    };
+    struct FreeList {
+        size_t    size;
+        size_t    alignment;
+        FreeNode *head;
+    };
+
+    // Each allocation is large and aligned enough to hold a FreeNode, once returned to the arena.
+    static size_t padded_size(size_t size)
+    {
+        return (std::max(size, sizeof(FreeNode)) + alignof(FreeNode) - 1) & ~(alignof(FreeNode) - 1);
+    }
+
+    FreeList* free_list(size_t size, size_t alignment)
+    {
+        for (FreeList &free_list : m_free_lists)
+            if (free_list.size == size && free_list.alignment == alignment)
+                return &free_list;
+        return nullptr;
+    }
+
+    size_t                               m_block_size;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::vector<FreeList>                m_free_lists;
+    char                                *m_ptr       { nullptr };
+    char                                *m_end       { nullptr };
+    size_t                               m_allocated { 0 };
+    size_t                               m_reserved  { 0 };
+};
+
+// Standard allocator allocating from a NodeArena, deallocate() returns the memory to the arena for reuse.
+// Containers sharing an arena compare equal, thus they may splice or swap their contents.
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(NodeArena *arena) noexcept : m_arena(arena) { assert(arena); }
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &rhs) noexcept : m_arena(rhs.arena()) {}
+
+    T*   allocate(size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *ptr, size_t n) noexcept { m_arena->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    NodeArena* arena() const noexcept { return m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &rhs) const noexcept { return m_arena == rhs.arena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &rhs) const noexcept { return m_arena != rhs.arena(); }
+
+private:
+    NodeArena *m_arena;
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_NodeArena_hpp_
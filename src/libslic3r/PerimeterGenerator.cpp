@@ -1299,9 +1299,8 @@ void PerimeterGenerator::process_classic()
                         // not using safety offset here would "detect" very narrow gaps
                         // (but still long enough to escape the area threshold) that gap fill
                         // won't be able to fill but we'd still remove from infill area
-                        append(gaps, diff_ex(
-                            offset(last,    - float(0.5 * distance)),
-                            offset(offsets,   float(0.5 * distance + 10))));  // safety offset
+                        append(gaps, ClipperChain::offset(last, - float(0.5 * distance)).diff_ex(
+                            ClipperChain::offset(offsets, float(0.5 * distance + 10))));  // safety offset
                 }
                 if (offsets.empty() && offsets_with_smaller_width.empty()) {
                     // Store the number of loops actually generated.
@@ -1548,10 +1547,9 @@ void PerimeterGenerator::process_classic()
             // collapse
             double min = 0.2 * perimeter_width * (1 - INSET_OVERLAP_TOLERANCE);
             double max = 2. * perimeter_spacing;
-            ExPolygons gaps_ex = diff_ex(
-                //FIXME offset2 would be enough and cheaper.
-                opening_ex(gaps, float(min / 2.)),
-                offset2_ex(gaps, - float(max / 2.), float(max / 2. + ClipperSafetyOffset)));
+            // Both openings stay in the ClipperLib representation, only the difference is converted to ExPolygons.
+            ExPolygons gaps_ex = ClipperChain::offset(gaps, - float(min / 2.)).offset(float(min / 2.)).diff_ex(
+                ClipperChain::offset(gaps, - float(max / 2.)).offset(float(max / 2. + ClipperSafetyOffset)));
             ThickPolylines polylines;
             for (ExPolygon& ex : gaps_ex) {
                 //BBS: Use DP simplify to avoid duplicated points and accelerate medial-axis calculation as well.
@@ -1630,10 +1628,9 @@ void PerimeterGenerator::process_classic()
         // collapse too narrow infill areas
         coord_t min_perimeter_infill_spacing = coord_t(solid_infill_spacing * (1. - INSET_OVERLAP_TOLERANCE));
 
-        ExPolygons infill_exp = offset2_ex(
-            not_filled_exp,
-            float(-inset - min_perimeter_infill_spacing / 2.),
-            float(min_perimeter_infill_spacing / 2.));
+        // The inner offset is shared by the infill area and by the no-overlap infill area below.
+        const ClipperChain not_filled_shrunk = ClipperChain::offset(not_filled_exp, float(-inset - min_perimeter_infill_spacing / 2.));
+        ExPolygons infill_exp = not_filled_shrunk.offset_ex(float(min_perimeter_infill_spacing / 2.));
         // append infill areas to fill_surfaces
         //if any top_fills, grow them by ext_perimeter_spacing/2 to have the real un-anchored fill
         ExPolygons top_infill_exp = intersection_ex(fill_clip, offset_ex(top_fills, double(ext_perimeter_spacing / 2)));
@@ -1648,10 +1645,7 @@ void PerimeterGenerator::process_classic()
         {
             ExPolygons polyWithoutOverlap;
             if (min_perimeter_infill_spacing / 2 > infill_peri_overlap)
-                polyWithoutOverlap = offset2_ex(
-                    not_filled_exp,
-                    float(-inset - min_perimeter_infill_spacing / 2.),
-                    float(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
+                polyWithoutOverlap = not_filled_shrunk.offset_ex(float(min_perimeter_infill_spacing / 2 - infill_peri_overlap));
             else
                 polyWithoutOverlap = offset_ex(
                     not_filled_exp,
@@ -1692,9 +1686,11 @@ void PerimeterGenerator::add_infill_contour_for_arachne( ExPolygons        infil
     for (ExPolygon &ex : infill_contour)
         ex.simplify_p(m_scaled_resolution, &inner_pp);
 
-    this->fill_surfaces->append(offset2_ex(union_ex(inner_pp), float(-min_perimeter_infill_spacing / 2.), float(insert + min_perimeter_infill_spacing / 2.)), stInternal);
+    // The union and the inner offset are shared by the infill area and by the no-overlap infill area.
+    const ClipperChain inner_shrunk = ClipperChain::offset(union_ex(inner_pp), float(-min_perimeter_infill_spacing / 2.));
+    this->fill_surfaces->append(inner_shrunk.offset_ex(float(insert + min_perimeter_infill_spacing / 2.)), stInternal);
 
-    append(*this->fill_no_overlap, offset2_ex(union_ex(inner_pp), float(-min_perimeter_infill_spacing / 2.), float(+min_perimeter_infill_spacing / 2.)));
+    append(*this->fill_no_overlap, inner_shrunk.offset_ex(float(+min_perimeter_infill_spacing / 2.)));
 }
 
 // Orca: sacrificial bridge layer algorithm ported from SuperSlicer
@@ -2180,10 +2176,10 @@ void PerimeterGenerator::process_arachne()
                 if (lower_slices != nullptr) {
                     const float      bridge_offset          = float(std::max<coord_t>(ext_perimeter_spacing, perimeter_width));
                     const Polygons   lower_slices_clipped   = ClipperUtils::clip_clipper_polygons_with_subject_bbox(*lower_slices, infill_contour_bbox);
-                    const ExPolygons current_slices_bridges = offset_ex(diff_ex(top_expolygons, lower_slices_clipped), bridge_offset);
+                    const ClipperChain current_slices_bridges = ClipperChain::offset(diff_ex(top_expolygons, lower_slices_clipped), bridge_offset);
 
                     // Remove bridges from top surface polygons.
-                    top_expolygons = diff_ex(top_expolygons, current_slices_bridges);
+                    top_expolygons = ClipperChain(top_expolygons).diff_ex(current_slices_bridges);
                 }
 
                 // Filter out areas that are too thin and expand top surface polygons a bit to hide the wall line.
@@ -2193,13 +2189,15 @@ void PerimeterGenerator::process_arachne()
                 // ORCA: Expand the polygon with half the perimeter width in addition to the contracted amount,
                 // not the full perimeter width as PS does, to enable thin lettering to print on the top surface without nozzle collisions
                 // due to thin lines being generated
-                top_expolygons = offset2_ex(top_expolygons, -top_surface_min_width, top_surface_min_width + float(perimeter_width * 0.85));
+                ClipperChain top_expanded = ClipperChain::offset(top_expolygons, -top_surface_min_width);
+                top_expanded.offset(top_surface_min_width + float(perimeter_width * 0.85));
 
                 // Get the not-top ExPolygons (including bridges) from current slices and expanded real top ExPolygons (without bridges).
-                const ExPolygons not_top_expolygons = diff_ex(infill_contour, top_expolygons);
+                const ClipperChain infill_contour_paths(infill_contour);
+                const ExPolygons   not_top_expolygons = infill_contour_paths.diff_ex(top_expanded);
 
                 // Get final top ExPolygons.
-                top_expolygons = intersection_ex(top_expolygons, infill_contour);
+                top_expolygons = top_expanded.intersection_ex(infill_contour_paths);
 
                 const Polygons not_top_polygons = to_polygons(offset_ex(not_top_expolygons,wall_0_inset));
                 Arachne::WallToolPaths inner_wall_tool_paths(not_top_polygons, perimeter_spacing, perimeter_spacing, coord_t(inner_loop_number + 1), 0, layer_height, input_params_tmp);
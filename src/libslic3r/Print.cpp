@@ -24,6 +24,10 @@
 #include <algorithm>
 #include <limits>
 #include <unordered_set>
+#include <array>
+#include <type_traits>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
@@ -41,6 +45,10 @@
 
 #include <codecvt>
 
+#include <openssl/sha.h>
+
+#include "libslic3r_version.h"
+
 using namespace nlohmann;
 
 // Mark string for localization and translate.
@@ -89,16 +97,11 @@ bool Print::has_tpu_filament() const
     return false;
 }
 
-// Called by Print::apply().
-// This method only accepts PrintConfig option keys.
-bool Print::invalidate_state_by_config_options(const ConfigOptionResolver & /* new_config */, const std::vector<t_config_option_key> &opt_keys)
+// Parameters, which influence the G-code generator only,
+// or they are only notes not influencing the generated G-code.
+static const std::unordered_set<std::string>& print_options_gcode_only()
 {
-    if (opt_keys.empty())
-        return false;
-
-    // Cache the plenty of parameters, which influence the G-code generator only,
-    // or they are only notes not influencing the generated G-code.
-    static std::unordered_set<std::string> steps_gcode = {
+    static const std::unordered_set<std::string> steps_gcode = {
         //BBS
         "additional_cooling_fan_speed",
         "reduce_crossing_wall",
@@ -214,6 +217,8 @@ bool Print::invalidate_state_by_config_options(const ConfigOptionResolver & /* n
         "gcode_comments",
         "gcode_label_objects", 
         "exclude_object",
+        "path_chaining",
+        "path_chaining_improve_passes",
         "support_material_interface_fan_speed",
         "internal_bridge_fan_speed", // ORCA: Add support for separate internal bridge fan speed control
         "ironing_fan_speed",
@@ -236,6 +241,17 @@ bool Print::invalidate_state_by_config_options(const ConfigOptionResolver & /* n
         "process_notes",
         "printer_notes"
     };
+    return steps_gcode;
+}
+
+// Called by Print::apply().
+// This method only accepts PrintConfig option keys.
+bool Print::invalidate_state_by_config_options(const ConfigOptionResolver & /* new_config */, const std::vector<t_config_option_key> &opt_keys)
+{
+    if (opt_keys.empty())
+        return false;
+
+    const std::unordered_set<std::string> &steps_gcode = print_options_gcode_only();
 
     static std::unordered_set<std::string> steps_ignore;
 
@@ -4303,11 +4319,280 @@ static void from_json(const json& j, groupedVolumeSlices& firstlayer_group)
     }
 }
 
+// Binary slice cache: a small header followed by the CBOR encoding of the same document the JSON cache holds.
+// The header carries a digest of everything the cached layers were computed from, so that stale data is rejected
+// before being parsed. The first 64 bits of the digest name the entries of the step cache shared by CLI runs.
+static constexpr const char     SLICE_CACHE_MAGIC[8]    = { 'O', 'R', 'C', 'A', 'S', 'L', 'C', '\0' };
+static constexpr const uint32_t SLICE_CACHE_VERSION     = 2;
+static constexpr const char    *SLICE_CACHE_EXTENSION   = ".bin";
+
+using SliceCacheDigest = std::array<uint8_t, SHA256_DIGEST_LENGTH>;
+
+// The version is stored in little endian byte order.
+struct SliceCacheHeader
+{
+    char             magic[8];
+    uint32_t         version;
+    uint32_t         reserved;
+    SliceCacheDigest content_digest;
+};
+
+// SHA-256 of the data the cached layers were computed from. The values are hashed in little endian byte order
+// and the options by their serialized values, so that the hash does not depend on the platform, the standard library
+// or the Boost version, and a step cache directory may be shared by different builds.
+class SliceCacheHasher
+{
+public:
+    SliceCacheHasher() { SHA256_Init(&m_ctx); }
+
+    template<typename T>
+    void value(T v) {
+        static_assert(std::is_arithmetic_v<T>);
+        if constexpr (std::is_floating_point_v<T>) {
+            using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            static_assert(sizeof(T) == sizeof(U));
+            U u;
+            memcpy(&u, &v, sizeof(u));
+            this->value(u);
+        } else {
+            boost::endian::native_to_little_inplace(v);
+            SHA256_Update(&m_ctx, &v, sizeof(v));
+        }
+    }
+    template<typename T>
+    void values(const T *data, size_t size) {
+        this->value(uint64_t(size));
+        if constexpr (boost::endian::order::native == boost::endian::order::little)
+            SHA256_Update(&m_ctx, data, size * sizeof(T));
+        else
+            for (size_t i = 0; i < size; ++ i)
+                this->value(data[i]);
+    }
+    void string(const std::string &s) {
+        this->value(uint64_t(s.size()));
+        SHA256_Update(&m_ctx, s.data(), s.size());
+    }
+    void bits(const std::vector<bool> &bits) {
+        this->value(uint64_t(bits.size()));
+        for (size_t i = 0; i < bits.size(); i += 8) {
+            uint8_t byte = 0;
+            for (size_t j = i; j < std::min(i + 8, bits.size()); ++ j)
+                byte |= uint8_t(bits[j]) << (j - i);
+            this->value(byte);
+        }
+    }
+
+    SliceCacheDigest digest() {
+        SliceCacheDigest out;
+        SHA256_Final(out.data(), &m_ctx);
+        return out;
+    }
+
+private:
+    SHA256_CTX m_ctx;
+};
+
+// The slicing code changes between the versions of the application, thus the cached layers are only reused
+// by the same version.
+static SliceCacheDigest slice_cache_content_digest(const PrintObject &obj)
+{
+    SliceCacheHasher hasher;
+    hasher.string(SLIC3R_VERSION);
+    hasher.value(SLICE_CACHE_VERSION);
+
+    // Options influencing the G-code export only do not invalidate the cached layers.
+    auto hash_config = [&hasher](const auto &config, auto &&gcode_only) {
+        for (const t_config_option_key &opt_key : config.keys())
+            if (! gcode_only(opt_key)) {
+                hasher.string(opt_key);
+                hasher.string(config.option(opt_key)->serialize());
+            }
+    };
+    // Per volume and per layer range overrides are hashed whole.
+    auto no_option_skipped = [](const t_config_option_key &) { return false; };
+    auto hash_facets = [&hasher](const FacetsAnnotation &facets) {
+        const TriangleSelector::TriangleSplittingData &data = facets.get_data();
+        hasher.value(uint64_t(data.triangles_to_split.size()));
+        for (const TriangleSelector::TriangleBitStreamMapping &mapping : data.triangles_to_split) {
+            hasher.value(int32_t(mapping.triangle_idx));
+            hasher.value(int32_t(mapping.bitstream_start_idx));
+        }
+        hasher.bits(data.bitstream);
+        hasher.bits(data.used_states);
+    };
+
+    const ModelObject *model_object = obj.model_object();
+    for (const ModelVolume *volume : model_object->volumes) {
+        const indexed_triangle_set &its = volume->mesh().its;
+        hasher.value(int32_t(volume->type()));
+        hasher.values(its.vertices.empty() ? nullptr : its.vertices.front().data(), its.vertices.size() * 3);
+        hasher.values(its.indices.empty() ? nullptr : its.indices.front().data(), its.indices.size() * 3);
+        hasher.values(volume->get_matrix().data(), size_t(Transform3d::MatrixType::SizeAtCompileTime));
+        hash_config(volume->config, no_option_skipped);
+        hash_facets(volume->supported_facets);
+        hash_facets(volume->seam_facets);
+        hash_facets(volume->mmu_segmentation_facets);
+        hash_facets(volume->fuzzy_skin_facets);
+    }
+    hasher.values(obj.trafo().data(), size_t(Transform3d::MatrixType::SizeAtCompileTime));
+    hasher.value(int64_t(obj.center_offset().x()));
+    hasher.value(int64_t(obj.center_offset().y()));
+    const std::vector<coordf_t> layer_height_profile = model_object->layer_height_profile.get();
+    hasher.values(layer_height_profile.data(), layer_height_profile.size());
+    hash_config(model_object->config, no_option_skipped);
+    for (const auto &[range, range_config] : model_object->layer_config_ranges) {
+        hasher.value(range.first);
+        hasher.value(range.second);
+        hash_config(range_config, no_option_skipped);
+    }
+
+    const std::unordered_set<std::string> &print_options_gcode = print_options_gcode_only();
+    hash_config(obj.print()->config(), [&print_options_gcode](const t_config_option_key &opt_key) { return print_options_gcode.count(opt_key) > 0; });
+    hash_config(obj.config(), PrintObject::is_gcode_only_option);
+    for (size_t region_id = 0; region_id < obj.num_printing_regions(); ++ region_id)
+        hash_config(obj.printing_region(region_id).config(), PrintObject::is_gcode_only_option);
+    return hasher.digest();
+}
+
+static void write_slice_cache(const std::string &file_name, const json &root_json, const SliceCacheDigest &content_digest)
+{
+    SliceCacheHeader header {};
+    memcpy(header.magic, SLICE_CACHE_MAGIC, sizeof(header.magic));
+    header.version        = boost::endian::native_to_little(SLICE_CACHE_VERSION);
+    header.content_digest = content_digest;
+    const std::vector<uint8_t> payload = json::to_cbor(root_json);
+
+    // Written under a temporary name first, the step cache may be shared by concurrent CLI runs.
+    const std::string tmp_file_name = file_name + "." + boost::filesystem::unique_path().string() + ".tmp";
+    boost::nowide::ofstream c(tmp_file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+    c.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    c.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    c.close();
+    if (c.fail()) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(tmp_file_name, ec);
+        throw Slic3r::RuntimeError(std::string("Failed writing slice cache ") + file_name);
+    }
+    boost::filesystem::rename(tmp_file_name, file_name);
+}
+
+// Returns false if the cache was written by another version or for different input data.
+static bool read_slice_cache(const std::string &file_name, const SliceCacheDigest &content_digest, json &root_json)
+{
+    boost::nowide::ifstream ifs(file_name, std::ios::in | std::ios::binary);
+    SliceCacheHeader header;
+    if (! ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw Slic3r::RuntimeError(std::string("Failed reading slice cache ") + file_name);
+    header.version = boost::endian::little_to_native(header.version);
+    if (memcmp(header.magic, SLICE_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != SLICE_CACHE_VERSION) {
+        BOOST_LOG_TRIVIAL(warning) << __FUNCTION__ << ": " << file_name << " has an unknown format or version " << header.version;
+        return false;
+    }
+    if (header.content_digest != content_digest) {
+        BOOST_LOG_TRIVIAL(warning) << __FUNCTION__ << ": " << file_name << " was created for a different mesh or configuration";
+        return false;
+    }
+    root_json = json::from_cbor(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static size_t slice_cache_identify_id(const PrintObject &obj)
+{
+    const ModelInstance *model_instance = obj.instances()[0].model_instance;
+    return (model_instance->loaded_id > 0) ? model_instance->loaded_id : model_instance->id().id;
+}
+
+static std::string step_cache_file_name(const std::string &cache_dir, const PrintObject &obj)
+{
+    const SliceCacheDigest digest = slice_cache_content_digest(obj);
+    std::string            name   = cache_dir + "/";
+    for (size_t i = 0; i < 8; ++ i)
+        name += (boost::format("%02x") % int(digest[i])).str();
+    return name + SLICE_CACHE_EXTENSION;
+}
+
+// Reads the json document of a cached object. If a binary cache was created for other input data or cannot be parsed,
+// the json cache next to it is read instead, if there is one. Returns false if there is no usable cache.
+static bool read_object_cache(const std::string &file_name, const PrintObject &obj, json &root_json)
+{
+    std::string json_file_name = file_name;
+    if (boost::ends_with(file_name, SLICE_CACHE_EXTENSION)) {
+        json_file_name = fs::path(file_name).replace_extension(".json").string();
+        try {
+            if (read_slice_cache(file_name, slice_cache_content_digest(obj), root_json))
+                return true;
+        } catch (std::exception &err) {
+            if (!fs::exists(json_file_name))
+                throw;
+            BOOST_LOG_TRIVIAL(warning) << __FUNCTION__ << ": failed reading " << file_name << ", reason = " << err.what();
+        }
+        if (!fs::exists(json_file_name))
+            return false;
+        BOOST_LOG_TRIVIAL(warning) << __FUNCTION__ << ": falling back to " << json_file_name;
+        root_json = json();
+    }
+    boost::nowide::ifstream ifs(json_file_name);
+    ifs >> root_json;
+    return true;
+}
+
 int Print::export_cached_data(const std::string& directory, bool with_space)
 {
-    int ret = 0;
     boost::filesystem::path directory_path(directory);
 
+    //firstly clear this directory
+    if (fs::exists(directory_path)) {
+        fs::remove_all(directory_path);
+    }
+    try {
+        if (!fs::create_directory(directory_path)) {
+            BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
+            return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
+        }
+    }
+    catch (...)
+    {
+        BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
+        return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
+    }
+
+    std::vector<std::pair<std::string, PrintObject*>> object_files;
+    for (PrintObject *obj : m_objects) {
+        if (obj->get_shared_object()) {
+            BOOST_LOG_TRIVIAL(info) << boost::format("shared object %1%, skip directly")%obj->model_object()->name;
+            continue;
+        }
+        // The human readable json is only written for debugging, the binary cache is much smaller and faster to load.
+        object_files.emplace_back(directory +"/obj_"+std::to_string(slice_cache_identify_id(*obj))+(with_space ? ".json" : SLICE_CACHE_EXTENSION), obj);
+    }
+    return this->export_cached_objects(object_files, with_space);
+}
+
+int Print::export_step_cache(const std::string& cache_dir)
+{
+    try {
+        fs::create_directories(cache_dir);
+    }
+    catch (...)
+    {
+        BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%cache_dir;
+        return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
+    }
+
+    // The plate is only sliced if load_step_cache() failed, which may be due to an existing entry, which is stale,
+    // corrupt or a collision of the names. The entries are overwritten, they are written to a temporary file
+    // and renamed, thus the concurrent CLI runs read either the old or the new entry.
+    std::vector<std::pair<std::string, PrintObject*>> object_files;
+    for (PrintObject *obj : m_objects)
+        if (! obj->get_shared_object())
+            object_files.emplace_back(step_cache_file_name(cache_dir, *obj), obj);
+    return this->export_cached_objects(object_files, false);
+}
+
+int Print::export_cached_objects(const std::vector<std::pair<std::string, PrintObject*>> &object_files, bool with_space)
+{
+    int ret = 0;
+
     auto convert_layer_to_json = [](json& layer_json, const Layer* layer) {
         json slice_polygons_json = json::array(), slice_bboxs_json = json::array(), overhang_polygons_json = json::array(), layer_regions_json = json::array();
         layer_json[JSON_LAYER_PRINT_Z] = layer->print_z;
@@ -4352,36 +4637,13 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
         return;
     };
 
-    //firstly clear this directory
-    if (fs::exists(directory_path)) {
-        fs::remove_all(directory_path);
-    }
-    try {
-        if (!fs::create_directory(directory_path)) {
-            BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
-            return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
-        }
-    }
-    catch (...)
-    {
-        BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
-        return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
-    }
-
     int count = 0;
     std::vector<std::string> filename_vector;
     std::vector<json> json_vector;
-    for (PrintObject *obj : m_objects) {
+    std::vector<SliceCacheDigest> content_digests;
+    for (const auto &[file_name, obj] : object_files) {
         const ModelObject* model_obj = obj->model_object();
-        if (obj->get_shared_object()) {
-            BOOST_LOG_TRIVIAL(info) << boost::format("shared object %1%, skip directly")%model_obj->name;
-            continue;
-        }
-
-        const PrintInstance &print_instance = obj->instances()[0];
-        const ModelInstance *model_instance = print_instance.model_instance;
-        size_t identify_id = (model_instance->loaded_id > 0)?model_instance->loaded_id: model_instance->id().id;
-        std::string file_name = directory +"/obj_"+std::to_string(identify_id)+".json";
+        size_t identify_id = slice_cache_identify_id(*obj);
 
         BOOST_LOG_TRIVIAL(info) << boost::format("begin to dump object %1%, identify_id %2% to %3%")%model_obj->name %identify_id %file_name;
 
@@ -4527,6 +4789,7 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
 
             filename_vector.push_back(file_name);
             json_vector.push_back(std::move(root_json));
+            content_digests.push_back(slice_cache_content_digest(*obj));
             /*boost::nowide::ofstream c;
             c.open(file_name, std::ios::out | std::ios::trunc);
             if (with_space)
@@ -4546,16 +4809,17 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
     boost::mutex mutex;
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, filename_vector.size()),
-        [filename_vector, &json_vector, with_space, &ret, &mutex](const tbb::blocked_range<size_t>& output_range) {
+        [&filename_vector, &json_vector, &content_digests, with_space, &ret, &mutex](const tbb::blocked_range<size_t>& output_range) {
             for (size_t object_index = output_range.begin(); object_index < output_range.end(); ++ object_index) {
                 try {
-                    boost::nowide::ofstream c;
-                    c.open(filename_vector[object_index], std::ios::out | std::ios::trunc);
-                    if (with_space)
+                    if (with_space) {
+                        boost::nowide::ofstream c;
+                        c.open(filename_vector[object_index], std::ios::out | std::ios::trunc);
                         c << std::setw(4) << json_vector[object_index] << std::endl;
+                        c.close();
+                    }
                     else
-                        c << json_vector[object_index].dump(0) << std::endl;
-                    c.close();
+                        write_slice_cache(filename_vector[object_index], json_vector[object_index], content_digests[object_index]);
                 }
                 catch(std::exception &err) {
                     BOOST_LOG_TRIVIAL(error) << __FUNCTION__<< ": save to "<<filename_vector[object_index]<<" got a generic exception, reason = " << err.what();
@@ -4566,14 +4830,13 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
         }
     );
 
-    BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(": total printobject count %1%, saved %2%, ret=%3%")%m_objects.size() %count %ret;
+    BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(": total printobject count %1%, saved %2%, ret=%3%")%object_files.size() %count %ret;
     return ret;
 }
 
 
 int Print::load_cached_data(const std::string& directory)
 {
-    int ret = 0;
     boost::filesystem::path directory_path(directory);
 
     if (!fs::exists(directory_path)) {
@@ -4581,19 +4844,6 @@ int Print::load_cached_data(const std::string& directory)
         return CLI_IMPORT_CACHE_NOT_FOUND;
     }
 
-    auto find_region = [this](PrintObject* object, size_t config_hash) -> const PrintRegion* {
-        int regions_count = object->num_printing_regions();
-        for (int index = 0; index < regions_count; index++ )
-        {
-            const PrintRegion&  print_region = object->printing_region(index);
-            if (print_region.config_hash() == config_hash ) {
-                return &print_region;
-            }
-        }
-        return NULL;
-    };
-
-    int count = 0;
     std::vector<std::pair<std::string, PrintObject*>> object_filenames;
     for (PrintObject *obj : m_objects) {
         const ModelObject* model_obj = obj->model_object();
@@ -4610,7 +4860,12 @@ int Print::load_cached_data(const std::string& directory)
             BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(": object %1%'s loaded_id is 0, need to use the instance_id %2%")%model_obj->name %identify_id;
             //continue;
         }
+        // Prefer the binary cache, fall back to the json written by older versions or on request,
+        // also if the binary cache is older than the json one.
         std::string file_name = directory +"/obj_"+std::to_string(identify_id)+".json";
+        std::string bin_file_name = directory +"/obj_"+std::to_string(identify_id)+SLICE_CACHE_EXTENSION;
+        if (fs::exists(bin_file_name) && (!fs::exists(file_name) || fs::last_write_time(bin_file_name) >= fs::last_write_time(file_name)))
+            file_name = std::move(bin_file_name);
 
         if (!fs::exists(file_name)) {
             BOOST_LOG_TRIVIAL(info) << __FUNCTION__<<boost::format(": file %1% not exist, maybe a shared object, skip it")%file_name;
@@ -4618,17 +4873,59 @@ int Print::load_cached_data(const std::string& directory)
         }
         object_filenames.push_back({file_name, obj});
     }
+    return this->load_cached_objects(object_filenames);
+}
 
+int Print::load_step_cache(const std::string& cache_dir)
+{
+    // All or nothing: the objects of a plate are either all restored or all sliced.
+    std::vector<std::pair<std::string, PrintObject*>> object_filenames;
+    for (PrintObject *obj : m_objects) {
+        std::string file_name = step_cache_file_name(cache_dir, *obj);
+        if (!fs::exists(file_name)) {
+            BOOST_LOG_TRIVIAL(info) << __FUNCTION__<<boost::format(": no cached slices of object %1% in %2%")%obj->model_object()->name %cache_dir;
+            return CLI_IMPORT_CACHE_NOT_FOUND;
+        }
+        object_filenames.push_back({std::move(file_name), obj});
+    }
+
+    for (PrintObject *obj : m_objects) {
+        obj->clear_layers();
+        obj->clear_support_layers();
+    }
+    return this->load_cached_objects(object_filenames);
+}
+
+int Print::load_cached_objects(const std::vector<std::pair<std::string, PrintObject*>> &object_filenames)
+{
+    int ret = 0;
+
+    auto find_region = [this](PrintObject* object, size_t config_hash) -> const PrintRegion* {
+        int regions_count = object->num_printing_regions();
+        for (int index = 0; index < regions_count; index++ )
+        {
+            const PrintRegion&  print_region = object->printing_region(index);
+            if (print_region.config_hash() == config_hash ) {
+                return &print_region;
+            }
+        }
+        return NULL;
+    };
+
+    int count = 0;
     boost::mutex mutex;
     std::vector<json> object_jsons(object_filenames.size());
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, object_filenames.size()),
-        [object_filenames, &ret, &object_jsons, &mutex](const tbb::blocked_range<size_t>& filename_range) {
+        [&object_filenames, &ret, &object_jsons, &mutex](const tbb::blocked_range<size_t>& filename_range) {
             for (size_t filename_index = filename_range.begin(); filename_index < filename_range.end(); ++ filename_index) {
                 try {
                     json root_json;
-                    boost::nowide::ifstream ifs(object_filenames[filename_index].first);
-                    ifs >> root_json;
+                    if (! read_object_cache(object_filenames[filename_index].first, *object_filenames[filename_index].second, root_json)) {
+                        boost::unique_lock l(mutex);
+                        ret = CLI_IMPORT_CACHE_DATA_CAN_NOT_USE;
+                        continue;
+                    }
                     object_jsons[filename_index] = std::move(root_json);
                 }
                 catch(std::exception &err) {
@@ -4782,7 +5079,6 @@ int Print::load_cached_data(const std::string& directory)
     }
 
     object_jsons.clear();
-    object_filenames.clear();
     BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(": total printobject count %1%, loaded %2%, ret=%3%")%m_objects.size() %count %ret;
     return ret;
 }
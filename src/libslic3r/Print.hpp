@@ -412,6 +412,9 @@ public:
     // Returns true, if the layer_height_profile was changed.
     static bool     update_layer_height_profile(const ModelObject &model_object, const SlicingParameters &slicing_parameters, std::vector<coordf_t> &layer_height_profile);
 
+    // PrintObjectConfig / PrintRegionConfig options, which influence the G-code generator only.
+    static bool     is_gcode_only_option(const t_config_option_key &opt_key);
+
     // Collect the slicing parameters, to be used by variable layer thickness algorithm,
     // by the interactive layer height editor and by the printing process itself.
     // The slicing parameters are dependent on various configuration values
@@ -911,6 +914,10 @@ public:
     //return 0 means successful
     int                 export_cached_data(const std::string& dir_path, bool with_space=false);
     int                 load_cached_data(const std::string& directory);
+    // Content addressed cache of the sliced objects shared by CLI runs: an entry is keyed by the meshes, transformations
+    // and all options except for those influencing the G-code export only.
+    int                 export_step_cache(const std::string& cache_dir);
+    int                 load_step_cache(const std::string& cache_dir);
 
     // methods for handling state
     bool                is_step_done(PrintStep step) const { return Inherited::is_step_done(step); }
@@ -1123,6 +1130,9 @@ private:
     void                _make_wipe_tower();
     void                finalize_first_layer_convex_hull();
 
+    int                 export_cached_objects(const std::vector<std::pair<std::string, PrintObject*>> &object_files, bool with_space);
+    int                 load_cached_objects(const std::vector<std::pair<std::string, PrintObject*>> &object_filenames);
+
     // Islands of objects and their supports extruded at the 1st layer.
     Polygons            first_layer_islands() const;
 
@@ -427,6 +427,9 @@ public:
     virtual void            process(long long *time_cost_with_cache = nullptr, bool use_cache = false) = 0;
     virtual int             export_cached_data(const std::string& dir_path, bool with_space=false) { return 0;}
     virtual int            load_cached_data(const std::string& directory) { return 0;}
+    // Returns non-zero if the cache is not supported or holds no entry for the objects of this print.
+    virtual int             export_step_cache(const std::string& cache_dir) { return -1; }
+    virtual int             load_step_cache(const std::string& cache_dir) { return -1; }
     // Clean up after process() finished, either with success, error or if canceled.
     // The adjustments on the Print / PrintObject data due to set_task() are to be reverted here.
     virtual void            finalize() {}
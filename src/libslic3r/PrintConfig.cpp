@@ -469,6 +469,12 @@ static t_config_enum_values s_keys_map_PerimeterGeneratorType{
 };
 CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(PerimeterGeneratorType)
 
+static t_config_enum_values s_keys_map_PathChaining{
+    { "greedy",       int(PathChaining::Greedy) },
+    { "spatial_grid", int(PathChaining::SpatialGrid) }
+};
+CONFIG_OPTION_ENUM_DEFINE_STATIC_MAPS(PathChaining)
+
 static const t_config_enum_values s_keys_map_ZHopType = {
     { "Auto Lift",          zhtAuto },
     { "Normal Lift",        zhtNormal },
@@ -3495,6 +3501,30 @@ void PrintConfigDef::init_fff_params()
     def->mode = comAdvanced;
     def->set_default_value(new ConfigOptionBool(false));
 
+    def = this->add("path_chaining", coEnum);
+    def->label = L("Path ordering");
+    def->tooltip = L("Algorithm ordering the infill and support extrusions of a layer to shorten the travel moves.\n"
+                     "Greedy: joins the closest extrusion ends first, producing short travels.\n"
+                     "Spatial grid: always continues with the closest remaining extrusion. Much faster on layers with tens of thousands "
+                     "of short extrusions such as gyroid, lightning infill or top surfaces of text, at the cost of somewhat longer travels.");
+    def->enum_keys_map = &ConfigOptionEnum<PathChaining>::get_enum_values();
+    def->enum_values.push_back("greedy");
+    def->enum_values.push_back("spatial_grid");
+    def->enum_labels.push_back(L("Greedy"));
+    def->enum_labels.push_back(L("Spatial grid"));
+    def->mode = comAdvanced;
+    def->set_default_value(new ConfigOptionEnum<PathChaining>(PathChaining::Greedy));
+
+    def = this->add("path_chaining_improve_passes", coInt);
+    def->label = L("Path ordering improvement passes");
+    def->tooltip = L("Maximum number of passes of the improvement of the path ordering over each collection of extrusions. "
+                     "A pass reverses runs of extrusions when it shortens the travel moves, the improvement stops earlier "
+                     "if a pass does not shorten the travels. Zero disables the improvement.");
+    def->min = 0;
+    def->max = 100;
+    def->mode = comAdvanced;
+    def->set_default_value(new ConfigOptionInt(0));
+
     def = this->add("gcode_comments", coBool);
     def->label = L("Verbose G-code");
     def->tooltip = L("Enable this to get a commented G-code file, with each line explained by a descriptive text. "
@@ -7263,6 +7293,16 @@ void PrintConfigDef::init_sla_params()
     def->mode = comAdvanced;
     def->set_default_value(new ConfigOptionFloat(2.0));
 
+    def = this->add("hollowing_max_memory", coFloat);
+    def->label = L("Hollowing memory limit");
+    def->category = L("Hollowing");
+    def->tooltip = L("Memory the voxelization of the model may use when hollowing it. If the model needs more "
+                     "at the selected accuracy, the accuracy is lowered, down to the lowest one. 0 means no limit.");
+    def->sidetext = "MB";
+    def->min = 0;
+    def->mode = comAdvanced;
+    def->set_default_value(new ConfigOptionFloat(0.));
+
     def = this->add("material_print_speed", coEnum);
     //def->label = L("");
     //def->tooltip = L("");
@@ -9869,6 +9909,20 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->cli_params = "dir";
     def->set_default_value(new ConfigOptionString());
 
+    def = this->add("slice_cache_dir", coString);
+    def->label = L("Slice cache directory");
+    def->tooltip = L("Reuse the sliced objects stored in this directory by previous runs with the same models and with "
+                     "settings differing only in options affecting the G-code export, and store the newly sliced ones.");
+    def->cli_params = "dir";
+    def->set_default_value(new ConfigOptionString());
+
+    def = this->add("parallel_plate_exports", coBool);
+    def->label = L("Parallel plate exports");
+    def->tooltip = L("When slicing all plates, export the G-code of a plate in the background while the next plate is being "
+                     "sliced. Otherwise the plates are exported one after another.");
+    def->cli_params = "option";
+    def->set_default_value(new ConfigOptionBool(false));
+
     def = this->add("debug", coInt);
     def->label = L("Debug level");
     def->tooltip = L("Sets debug logging level. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n");
@@ -275,6 +275,15 @@ enum class PerimeterGeneratorType
     Arachne
 };
 
+// Algorithm ordering the extrusions of a collection to shorten the travels, see chain_extrusion_entities().
+enum class PathChaining
+{
+    // Multi-fragment greedy algorithm over a KD tree of end points.
+    Greedy,
+    // Nearest neighbour over a uniform grid of end points, scales to layers with tens of thousands of short extrusions.
+    SpatialGrid
+};
+
 // BBS
 enum OverhangFanThreshold {
     Overhang_threshold_none = 0,
@@ -505,6 +514,7 @@ CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS(PrintHostType)
 CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS(AuthorizationType)
 CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS(WipeTowerWallType)
 CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS(PerimeterGeneratorType)
+CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS(PathChaining)
 
 #undef CONFIG_OPTION_ENUM_DECLARE_STATIC_MAPS
 
@@ -1520,6 +1530,8 @@ PRINT_CONFIG_CLASS_DERIVED_DEFINE(
     ((ConfigOptionPercents,            filament_shrinkage_compensation_z))
     ((ConfigOptionBool,                gcode_label_objects))
     ((ConfigOptionBool,                exclude_object))
+    ((ConfigOptionEnum<PathChaining>,  path_chaining))
+    ((ConfigOptionInt,                 path_chaining_improve_passes))
     ((ConfigOptionFloats,             grab_length))
     ((ConfigOptionBool,                gcode_comments))
     ((ConfigOptionInt,                 slow_down_layers))
@@ -1698,6 +1710,9 @@ PRINT_CONFIG_CLASS_DEFINE(
 
     // Indirectly controls the minimum size of created cavities.
     ((ConfigOptionFloat, hollowing_closing_distance))
+
+    // Memory budget of the voxelization in MB, the voxels are coarsened to fit.
+    ((ConfigOptionFloat, hollowing_max_memory))
 )
 
 enum SLAMaterialSpeed { slamsSlow, slamsFast };
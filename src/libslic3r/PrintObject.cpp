@@ -27,6 +27,7 @@
 #include <oneapi/tbb/concurrent_vector.h>
 #include <oneapi/tbb/parallel_for.h>
 #include <string_view>
+#include <unordered_set>
 #include <utility>
 
 #include <boost/log/trivial.hpp>
@@ -995,6 +996,37 @@ SupportLayerPtrs::iterator PrintObject::insert_support_layer(SupportLayerPtrs::i
 
 // Called by Print::apply().
 // This method only accepts PrintObjectConfig and PrintRegionConfig option keys.
+bool PrintObject::is_gcode_only_option(const t_config_option_key &opt_key)
+{
+    // The speeds brim generation depends on are not listed, they invalidate posSupportMaterial.
+    static const std::unordered_set<std::string> options_gcode = {
+        "seam_position",
+        "seam_slope_type",
+        "seam_slope_conditional",
+        "scarf_angle_threshold",
+        "scarf_overhang_threshold",
+        "scarf_joint_speed",
+        "scarf_joint_flow_ratio",
+        "seam_slope_start_height",
+        "seam_slope_entire_loop",
+        "seam_slope_min_length",
+        "seam_slope_steps",
+        "seam_slope_inner_walls",
+        "support_interface_speed",
+        "overhang_1_4_speed",
+        "overhang_2_4_speed",
+        "overhang_3_4_speed",
+        "overhang_4_4_speed",
+        "bridge_speed",
+        "internal_bridge_speed",
+        "bed_mesh_min",
+        "bed_mesh_max",
+        "adaptive_bed_mesh_margin",
+        "bed_mesh_probe_distance"
+    };
+    return options_gcode.find(opt_key) != options_gcode.end();
+}
+
 bool PrintObject::invalidate_state_by_config_options(
     const ConfigOptionResolver &old_config, const ConfigOptionResolver &new_config, const std::vector<t_config_option_key> &opt_keys)
 {
@@ -1292,38 +1324,7 @@ bool PrintObject::invalidate_state_by_config_options(
             || opt_key == "min_length_factor"
             || opt_key == "min_bead_width") {
             steps.emplace_back(posSlice);
-        } else if (
-               opt_key == "seam_position"
-            || opt_key == "seam_slope_type"
-            || opt_key == "seam_slope_conditional"
-            || opt_key == "scarf_angle_threshold"
-            || opt_key == "scarf_overhang_threshold"
-            || opt_key == "scarf_joint_speed"
-            || opt_key == "scarf_joint_flow_ratio"
-            || opt_key == "seam_slope_start_height"
-            || opt_key == "seam_slope_entire_loop"
-            || opt_key == "seam_slope_min_length"
-            || opt_key == "seam_slope_steps"
-            || opt_key == "seam_slope_inner_walls"
-            || opt_key == "support_speed"
-            || opt_key == "support_interface_speed"
-            || opt_key == "overhang_1_4_speed"
-            || opt_key == "overhang_2_4_speed"
-            || opt_key == "overhang_3_4_speed"
-            || opt_key == "overhang_4_4_speed"
-            || opt_key == "bridge_speed"
-            || opt_key == "internal_bridge_speed"
-            || opt_key == "outer_wall_speed"
-            || opt_key == "small_perimeter_speed"
-            || opt_key == "small_perimeter_threshold"
-            || opt_key == "sparse_infill_speed"
-            || opt_key == "inner_wall_speed"
-            || opt_key == "internal_solid_infill_speed"
-            || opt_key == "top_surface_speed"
-            || opt_key == "bed_mesh_min"
-            || opt_key == "bed_mesh_max"
-            || opt_key == "adaptive_bed_mesh_margin"
-            || opt_key == "bed_mesh_probe_distance") {
+        } else if (is_gcode_only_option(opt_key)) {
             invalidated |= m_print->invalidate_step(psGCodeExport);
         } else if (
                opt_key == "flush_into_infill"
@@ -1,8 +1,12 @@
 #include "QuadricEdgeCollapse.hpp"
+#include <numeric>
+#include <mutex>
 #include <tuple>
 #include <optional>
 #include "MutablePriorityQueue.hpp"
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/task_arena.h>
 
 using namespace Slic3r;
 
@@ -115,8 +119,10 @@ namespace QuadricEdgeCollapse {
     // calculate error for vertex and quadrics, triangle quadrics and triangle vertex give zero, only pozitive number
     double vertex_error(const SymMat &q, const Vec3d &vertex);
     SymMat create_quadric(const Triangle &t, const Vec3d& n, const Vertices &vertices);
+    using SymMats = std::vector<SymMat>;
+    // vertex_quadrics (optional) replace the quadrics summed from the triangles around the vertices.
     std::tuple<TriangleInfos, VertexInfos, EdgeInfos, Errors> 
-    init(const indexed_triangle_set &its, ThrowOnCancel& throw_on_cancel, StatusFn& status_fn);
+    init(const indexed_triangle_set &its, ThrowOnCancel& throw_on_cancel, StatusFn& status_fn, const SymMats *vertex_quadrics = nullptr);
     std::optional<uint32_t> find_triangle_index1(uint32_t vi, const VertexInfo& v_info,
         uint32_t ti, const EdgeInfos& e_infos, const Indices& indices);
     void reorder_edges(EdgeInfos &e_infos, const VertexInfo &v_info, uint32_t ti0, uint32_t ti1);
@@ -133,7 +139,23 @@ namespace QuadricEdgeCollapse {
     void change_neighbors(EdgeInfos &e_infos, VertexInfos &v_infos, uint32_t ti0, uint32_t ti1,
                           uint32_t vi0, uint32_t vi1, uint32_t vi_top0,
                           const Triangle &t1, CopyEdgeInfos& infos, EdgeInfos &e_infos1);
-    void compact(const VertexInfos &v_infos, const TriangleInfos &t_infos, const EdgeInfos &e_infos, indexed_triangle_set &its);
+    // vertex_map (optional) receives the new index of each vertex, -1 for the removed vertices.
+    void compact(const VertexInfos &v_infos, const TriangleInfos &t_infos, const EdgeInfos &e_infos, indexed_triangle_set &its,
+                 std::vector<uint32_t> *vertex_map = nullptr);
+    // Collapse the edges in the order of their errors until triangle_count or maximal_error is reached.
+    // Edges touching a vertex marked in locked (optional) are never collapsed, thus the locked vertices keep their position.
+    // vertex_quadrics (optional) are the initial quadrics of the vertices on input, the final quadrics of the vertices
+    // indexed before compaction on output. Returns the error of the last collapsed edge.
+    float collapse(indexed_triangle_set &its, uint32_t triangle_count, float maximal_error, const std::vector<bool> *locked,
+                   ThrowOnCancel &throw_on_cancel, StatusFn &status_fn, std::vector<uint32_t> *vertex_map, SymMats *vertex_quadrics);
+    // Sort the triangles into num_clusters spatially compact clusters of about the same size by recursive median bisection
+    // of their centroids. Cluster i is formed by the triangles order[cluster_begin[i] .. cluster_begin[i + 1]).
+    void partition(const indexed_triangle_set &its, size_t num_clusters, std::vector<uint32_t> &order, std::vector<size_t> &cluster_begin);
+    // Simplify the clusters concurrently with their shared vertices locked, then simplify the merged mesh serially
+    // to collapse the edges along the cluster borders. The quadrics accumulated by the clusters are passed to the serial
+    // simplification, thus it measures the errors against the input mesh. Returns the error of the last collapsed edge.
+    float collapse_partitioned(indexed_triangle_set &its, uint32_t triangle_count, float maximal_error, size_t num_clusters,
+                               ThrowOnCancel &throw_on_cancel, StatusFn &status_fn);
 
 #ifdef EXPENSIVE_DEBUG_CHECKS
     void store_surround(const char *obj_filename, size_t triangle_index, int depth, const indexed_triangle_set &its,
@@ -153,6 +175,10 @@ namespace QuadricEdgeCollapse {
     const int status_set_offsets = 10;
     const int status_calc_errors = 30;
     const int status_create_refs = 10;
+    // Minimal number of triangles of a cluster of the partitioned mode.
+    const size_t min_cluster_size = 50000;
+    // Part of the progress of the partitioned mode spent on simplifying the clusters, the rest is spent on the borders.
+    const int status_clusters_size = 70;
     } // namespace QuadricEdgeCollapse
 
 using namespace QuadricEdgeCollapse;
@@ -162,7 +188,8 @@ void Slic3r::its_quadric_edge_collapse(
     uint32_t                  triangle_count,
     float *                   max_error,
     std::function<void(void)> throw_on_cancel,
-    std::function<void(int)>  status_fn)
+    std::function<void(int)>  status_fn,
+    QuadricEdgeCollapseMode   mode)
 {
     // check input
     if (triangle_count >= its.indices.size()) return;
@@ -171,6 +198,17 @@ void Slic3r::its_quadric_edge_collapse(
     if (throw_on_cancel == nullptr) throw_on_cancel = []() {};
     if (status_fn == nullptr) status_fn = [](int) {};
 
+    const size_t num_clusters = mode == QuadricEdgeCollapseMode::Partitioned ?
+        std::min(its.indices.size() / min_cluster_size, 4 * size_t(tbb::this_task_arena::max_concurrency())) : 1;
+    float last_collapsed_error = num_clusters > 1 ?
+        collapse_partitioned(its, triangle_count, maximal_error, num_clusters, throw_on_cancel, status_fn) :
+        collapse(its, triangle_count, maximal_error, nullptr, throw_on_cancel, status_fn, nullptr, nullptr);
+    if (max_error != nullptr) *max_error = last_collapsed_error;
+}
+
+float QuadricEdgeCollapse::collapse(indexed_triangle_set &its, uint32_t triangle_count, float maximal_error, const std::vector<bool> *locked,
+                                    ThrowOnCancel &throw_on_cancel, StatusFn &status_fn, std::vector<uint32_t> *vertex_map, SymMats *vertex_quadrics)
+{
     StatusFn init_status_fn = [&](int percent) {
         float n_percent = percent * status_init_size / 100.f;
         status_fn(static_cast<int>(std::round(n_percent)));
@@ -180,7 +218,8 @@ void Slic3r::its_quadric_edge_collapse(
     VertexInfos   v_infos;
     EdgeInfos     e_infos;
     Errors        errors;
-    std::tie(t_infos, v_infos, e_infos, errors) = init(its, throw_on_cancel, init_status_fn);
+    std::tie(t_infos, v_infos, e_infos, errors) = init(its, throw_on_cancel, init_status_fn,
+        (vertex_quadrics != nullptr && ! vertex_quadrics->empty()) ? vertex_quadrics : nullptr);
     throw_on_cancel();
     status_fn(status_init_size);
 
@@ -255,7 +294,8 @@ void Slic3r::its_quadric_edge_collapse(
             reorder_edges(e_infos, v_info0, ti0, ti1);
             reorder_edges(e_infos, v_info1, ti0, ti1);
         }
-        if (!ti1_opt.has_value() || // edge has only one triangle
+        if ((locked != nullptr && ((*locked)[vi0] || (*locked)[vi1])) ||
+            !ti1_opt.has_value() || // edge has only one triangle
             degenerate(vi0, ti0, ti1, v_info1, e_infos, its.indices) ||
             degenerate(vi1, ti0, ti1, v_info0, e_infos, its.indices) ||
             create_no_volume(vi0, vi1, ti0, ti1, v_info0, v_info1, e_infos, its.indices) ||
@@ -341,9 +381,180 @@ void Slic3r::its_quadric_edge_collapse(
 #endif // EXPENSIVE_DEBUG_CHECKS
     }
 
+    if (vertex_quadrics != nullptr) {
+        vertex_quadrics->clear();
+        vertex_quadrics->reserve(v_infos.size());
+        for (const VertexInfo &v_info : v_infos)
+            vertex_quadrics->emplace_back(v_info.q);
+    }
     // compact triangle
-    compact(v_infos, t_infos, e_infos, its);
-    if (max_error != nullptr) *max_error = last_collapsed_error;
+    compact(v_infos, t_infos, e_infos, its, vertex_map);
+    return last_collapsed_error;
+}
+
+void QuadricEdgeCollapse::partition(const indexed_triangle_set &its, size_t num_clusters, std::vector<uint32_t> &order, std::vector<size_t> &cluster_begin)
+{
+    std::vector<Vec3f> centroids(its.indices.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, its.indices.size()), [&its, &centroids](const tbb::blocked_range<size_t> &range) {
+        for (size_t ti = range.begin(); ti < range.end(); ++ ti) {
+            const Triangle &t = its.indices[ti];
+            centroids[ti] = (its.vertices[t[0]] + its.vertices[t[1]] + its.vertices[t[2]]) / 3.f;
+        }
+    });
+    order.resize(its.indices.size());
+    std::iota(order.begin(), order.end(), 0);
+    cluster_begin.assign(num_clusters + 1, its.indices.size());
+    cluster_begin.front() = 0;
+    // Split order[begin, end) into the clusters [first_cluster, first_cluster + cnt_clusters) along the longest axis of their centroids.
+    std::function<void(size_t, size_t, size_t, size_t)> split = [&](size_t begin, size_t end, size_t first_cluster, size_t cnt_clusters) {
+        if (cnt_clusters == 1) {
+            cluster_begin[first_cluster] = begin;
+            return;
+        }
+        Vec3f bmin = centroids[order[begin]];
+        Vec3f bmax = bmin;
+        for (size_t i = begin; i < end; ++ i) {
+            bmin = bmin.cwiseMin(centroids[order[i]]);
+            bmax = bmax.cwiseMax(centroids[order[i]]);
+        }
+        Eigen::Index axis;
+        (bmax - bmin).maxCoeff(&axis);
+        const size_t cnt_left = cnt_clusters / 2;
+        const size_t mid      = begin + (end - begin) * cnt_left / cnt_clusters;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+            [&centroids, axis](uint32_t ti1, uint32_t ti2) { return centroids[ti1][axis] < centroids[ti2][axis]; });
+        tbb::parallel_invoke(
+            [&]() { split(begin, mid, first_cluster, cnt_left); },
+            [&]() { split(mid, end, first_cluster + cnt_left, cnt_clusters - cnt_left); });
+    };
+    split(0, order.size(), 0, num_clusters);
+}
+
+float QuadricEdgeCollapse::collapse_partitioned(indexed_triangle_set &its, uint32_t triangle_count, float maximal_error, size_t num_clusters,
+                                                ThrowOnCancel &throw_on_cancel, StatusFn &status_fn)
+{
+    std::vector<uint32_t> order;
+    std::vector<size_t>   cluster_begin;
+    partition(its, num_clusters, order, cluster_begin);
+    throw_on_cancel();
+
+    // Cluster owning each vertex, border_vertex if the vertex is shared by triangles of more than one cluster.
+    static constexpr const uint32_t no_cluster    = std::numeric_limits<uint32_t>::max();
+    static constexpr const uint32_t border_vertex = no_cluster - 1;
+    std::vector<uint32_t> vertex_cluster(its.vertices.size(), no_cluster);
+    for (uint32_t cluster_idx = 0; cluster_idx < num_clusters; ++ cluster_idx)
+        for (size_t i = cluster_begin[cluster_idx]; i < cluster_begin[cluster_idx + 1]; ++ i)
+            for (int j = 0; j < 3; ++ j) {
+                uint32_t &vc = vertex_cluster[its.indices[order[i]][j]];
+                vc = (vc == no_cluster || vc == cluster_idx) ? cluster_idx : border_vertex;
+            }
+
+    struct Cluster {
+        indexed_triangle_set  its;
+        // Index of each vertex of the cluster in the input mesh.
+        std::vector<uint32_t> vertices;
+        std::vector<bool>     locked;
+        // Index of each vertex of the cluster in the simplified cluster, -1 if removed.
+        std::vector<uint32_t> vertex_map;
+        // Quadrics of the vertices of the simplified cluster, indexed by the vertices of the cluster.
+        SymMats               vertex_quadrics;
+        float                 last_collapsed_error { 0.f };
+    };
+    std::vector<Cluster> clusters(num_clusters);
+    const size_t num_triangles = its.indices.size();
+
+    // Progress of the clusters weighted by their triangle counts. The status is reported by the thread which advanced
+    // the overall progress, serialized by a mutex so that the reported status does not decrease.
+    std::mutex          status_mutex;
+    std::vector<int>    cluster_percent(num_clusters, 0);
+    size_t              clusters_progress = 0;
+    int                 clusters_status   = 0;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_clusters, 1), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t cluster_idx = range.begin(); cluster_idx < range.end(); ++ cluster_idx) {
+            Cluster     &cluster = clusters[cluster_idx];
+            const size_t begin   = cluster_begin[cluster_idx];
+            const size_t end     = cluster_begin[cluster_idx + 1];
+            cluster.vertices.reserve(3 * (end - begin));
+            for (size_t i = begin; i < end; ++ i)
+                for (int j = 0; j < 3; ++ j)
+                    cluster.vertices.emplace_back(its.indices[order[i]][j]);
+            sort_remove_duplicates(cluster.vertices);
+            cluster.its.vertices.reserve(cluster.vertices.size());
+            cluster.locked.reserve(cluster.vertices.size());
+            for (uint32_t vi : cluster.vertices) {
+                cluster.its.vertices.emplace_back(its.vertices[vi]);
+                cluster.locked.push_back(vertex_cluster[vi] == border_vertex);
+            }
+            cluster.its.indices.reserve(end - begin);
+            for (size_t i = begin; i < end; ++ i) {
+                Triangle t = its.indices[order[i]];
+                for (int j = 0; j < 3; ++ j)
+                    t[j] = int(lower_bound_by_predicate(cluster.vertices.begin(), cluster.vertices.end(),
+                        [vi = uint32_t(t[j])](uint32_t v) { return v < vi; }) - cluster.vertices.begin());
+                cluster.its.indices.emplace_back(t);
+            }
+            // Triangle budget of the cluster proportional to its size plus the triangles kept around the locked vertices,
+            // otherwise the interior of the cluster would be collapsed well below the density of the serial simplification.
+            const auto cluster_triangle_count = uint32_t(uint64_t(triangle_count) * (end - begin) / num_triangles +
+                2 * std::count(cluster.locked.begin(), cluster.locked.end(), true));
+            StatusFn   cluster_status_fn = [&, cluster_idx, cluster_size = end - begin](int percent) {
+                std::lock_guard<std::mutex> lk(status_mutex);
+                if (percent <= cluster_percent[cluster_idx])
+                    return;
+                clusters_progress += size_t(percent - cluster_percent[cluster_idx]) * cluster_size;
+                cluster_percent[cluster_idx] = percent;
+                if (int status = int(clusters_progress * status_clusters_size / (100 * num_triangles)); status > clusters_status) {
+                    clusters_status = status;
+                    status_fn(status);
+                }
+            };
+            cluster.last_collapsed_error = collapse(cluster.its, cluster_triangle_count, maximal_error, &cluster.locked, throw_on_cancel, cluster_status_fn,
+                &cluster.vertex_map, &cluster.vertex_quadrics);
+        }
+    });
+    throw_on_cancel();
+    status_fn(status_clusters_size);
+
+    // Merge the clusters, the locked vertices are shared. The quadric of a locked vertex is the sum of its quadrics in the clusters.
+    indexed_triangle_set  out;
+    SymMats               out_quadrics;
+    std::vector<uint32_t> border_vertex_map(its.vertices.size(), no_cluster);
+    float                 last_collapsed_error = 0.f;
+    for (Cluster &cluster : clusters) {
+        std::vector<uint32_t> new_vertex_idx(cluster.its.vertices.size(), no_cluster);
+        for (size_t vi = 0; vi < cluster.vertex_map.size(); ++ vi)
+            if (uint32_t vi_new = cluster.vertex_map[vi]; vi_new != no_cluster) {
+                if (cluster.locked[vi]) {
+                    uint32_t &vi_out = border_vertex_map[cluster.vertices[vi]];
+                    if (vi_out == no_cluster) {
+                        vi_out = uint32_t(out.vertices.size());
+                        out.vertices.emplace_back(cluster.its.vertices[vi_new]);
+                        out_quadrics.emplace_back(cluster.vertex_quadrics[vi]);
+                    } else
+                        out_quadrics[vi_out] += cluster.vertex_quadrics[vi];
+                    new_vertex_idx[vi_new] = vi_out;
+                } else {
+                    new_vertex_idx[vi_new] = uint32_t(out.vertices.size());
+                    out.vertices.emplace_back(cluster.its.vertices[vi_new]);
+                    out_quadrics.emplace_back(cluster.vertex_quadrics[vi]);
+                }
+            }
+        for (const Triangle &t : cluster.its.indices)
+            out.indices.emplace_back(int(new_vertex_idx[t[0]]), int(new_vertex_idx[t[1]]), int(new_vertex_idx[t[2]]));
+        last_collapsed_error = std::max(last_collapsed_error, cluster.last_collapsed_error);
+        cluster = Cluster();
+    }
+    its = std::move(out);
+
+    // Collapse the edges along the cluster borders, which were locked so far.
+    if (triangle_count < its.indices.size()) {
+        StatusFn border_status_fn = [&status_fn](int percent) {
+            status_fn(status_clusters_size + percent * (100 - status_clusters_size) / 100);
+        };
+        last_collapsed_error = std::max(last_collapsed_error,
+            collapse(its, triangle_count, maximal_error, nullptr, throw_on_cancel, border_status_fn, nullptr, &out_quadrics));
+    }
+    return last_collapsed_error;
 }
 
 Vec3d QuadricEdgeCollapse::create_normal(const Triangle &triangle,
@@ -438,7 +649,7 @@ SymMat QuadricEdgeCollapse::create_quadric(const Triangle &t,
 }
 
 std::tuple<TriangleInfos, VertexInfos, EdgeInfos, Errors> 
-QuadricEdgeCollapse::init(const indexed_triangle_set &its, ThrowOnCancel& throw_on_cancel, StatusFn& status_fn)
+QuadricEdgeCollapse::init(const indexed_triangle_set &its, ThrowOnCancel& throw_on_cancel, StatusFn& status_fn, const SymMats *vertex_quadrics)
 {
     int status_offset = 0;
     TriangleInfos t_infos(its.indices.size());
@@ -479,6 +690,12 @@ QuadricEdgeCollapse::init(const indexed_triangle_set &its, ThrowOnCancel& throw_
         status_offset += status_sum_quadric;
     } // remove triangle quadrics
 
+    if (vertex_quadrics != nullptr) {
+        assert(vertex_quadrics->size() == v_infos.size());
+        for (size_t i = 0; i < v_infos.size(); ++ i)
+            v_infos[i].q = (*vertex_quadrics)[i];
+    }
+
     // set offseted starts
     uint32_t triangle_start = 0;
     for (VertexInfo &v_info : v_infos) {
@@ -828,12 +1045,17 @@ void QuadricEdgeCollapse::change_neighbors(EdgeInfos &     e_infos,
 void QuadricEdgeCollapse::compact(const VertexInfos &   v_infos,
                                   const TriangleInfos & t_infos,
                                   const EdgeInfos &     e_infos,
-                                  indexed_triangle_set &its)
+                                  indexed_triangle_set &its,
+                                  std::vector<uint32_t> *vertex_map)
 {
+    if (vertex_map != nullptr)
+        vertex_map->assign(v_infos.size(), uint32_t(-1));
     uint32_t vi_new = 0;
     for (uint32_t vi = 0; vi < v_infos.size(); ++vi) {
         const VertexInfo &v_info = v_infos[vi];
         if (v_info.is_deleted()) continue; // deleted
+        if (vertex_map != nullptr)
+            (*vertex_map)[vi] = vi_new;
         uint32_t e_info_end = v_info.start + v_info.count;
         for (uint32_t ei = v_info.start; ei < e_info_end; ++ei) { 
             const EdgeInfo &e_info = e_infos[ei];
@@ -8,6 +8,15 @@
 
 namespace Slic3r {
 
+enum class QuadricEdgeCollapseMode {
+    // Collapse the edges one by one in the order of their errors over the whole mesh.
+    Serial,
+    // Split the mesh into spatial clusters, simplify the clusters concurrently with the vertices shared
+    // between the clusters locked, then simplify the merged mesh serially to collapse the cluster borders.
+    // Much faster on meshes with millions of triangles, falls back to Serial on small meshes.
+    Partitioned
+};
+
 /// <summary>
 /// Simplify mesh by Quadric metric
 /// </summary>
@@ -18,11 +27,14 @@ namespace Slic3r {
 /// Output: Last used ErrorValue to collapse edge</param>
 /// <param name="throw_on_cancel">Could stop process of calculation.</param>
 /// <param name="statusfn">Give a feed back to user about progress. Values 1 - 100</param>
+/// <param name="mode">Serial or partitioned parallel simplification.
+/// In both modes throw_on_cancel and statusfn may be called concurrently from the TBB worker threads, thus they have to be thread safe.</param>
 void its_quadric_edge_collapse(
     indexed_triangle_set &    its,
     uint32_t                  triangle_count  = 0,
     float *                   max_error       = nullptr,
     std::function<void(void)> throw_on_cancel = nullptr,
-    std::function<void(int)>  statusfn        = nullptr);
+    std::function<void(int)>  statusfn        = nullptr,
+    QuadricEdgeCollapseMode   mode            = QuadricEdgeCollapseMode::Serial);
 
 } // namespace Slic3r
@@ -108,6 +108,56 @@ static InteriorPtr generate_interior_verbose(const TriangleMesh & mesh,
     return interior;
 }
 
+// Estimate of the memory needed to voxelize a surface of the given area in a narrow band
+// of band_width voxels: the voxels of the band including the partially filled leaf nodes
+// of 8x8x8 voxels, two grids are alive while the level set is being rebuilt.
+//FIXME not calibrated against the memory OpenVDB actually allocates.
+static double estimate_voxelization_memory(double area, double voxel_scale, double band_width)
+{
+    return 2. * sizeof(float) * area * sqr(voxel_scale) * (band_width + 8.);
+}
+
+// The finest voxel scale up to voxel_scale, for which the voxelization of the mesh
+// is estimated to fit into max_memory_mb. The narrow band used by
+// generate_interior_verbose() is 1.2 * min_thickness + 1.1 * closing_dist wide,
+// both scaled by the voxel scale.
+static double fit_voxel_scale_to_memory(const indexed_triangle_set &its,
+                                        const HollowingConfig &     hc,
+                                        double                      voxel_scale,
+                                        double                      min_voxel_scale)
+{
+    double area = 0.;
+    for (const Vec3i32 &face : its.indices) {
+        const Vec3d p0 = its.vertices[face(0)].cast<double>();
+        area += 0.5 * (its.vertices[face(1)].cast<double>() - p0).cross(its.vertices[face(2)].cast<double>() - p0).norm();
+    }
+
+    const double budget = hc.max_memory_mb * 1024. * 1024.;
+    const double band   = 1.2 * hc.min_thickness + 1.1 * hc.closing_distance;
+    auto memory = [&](double scale) { return estimate_voxelization_memory(area, scale, band * scale); };
+
+    if (memory(voxel_scale) <= budget)
+        return voxel_scale;
+
+    if (memory(min_voxel_scale) > budget) {
+        BOOST_LOG_TRIVIAL(warning) << "Hollowing needs an estimated " << memory(min_voxel_scale) / (1024. * 1024.)
+                                   << " MB even at the lowest quality, more than the budget of "
+                                   << hc.max_memory_mb << " MB";
+        return min_voxel_scale;
+    }
+
+    // The estimate grows monotonically with the voxel scale.
+    double lo = min_voxel_scale, hi = voxel_scale;
+    for (int i = 0; i < 32; ++ i) {
+        double mid = 0.5 * (lo + hi);
+        (memory(mid) <= budget ? lo : hi) = mid;
+    }
+
+    BOOST_LOG_TRIVIAL(info) << "Hollowing voxel scale reduced from " << voxel_scale << " to " << lo
+                            << " to fit into " << hc.max_memory_mb << " MB";
+    return lo;
+}
+
 InteriorPtr generate_interior(const TriangleMesh &   mesh,
                               const HollowingConfig &hc,
                               const JobController &  ctl)
@@ -124,6 +174,11 @@ InteriorPtr generate_interior(const TriangleMesh &   mesh,
     // max 8x upscale, min is native voxel size
     auto voxel_scale = MIN_OVERSAMPL + (MAX_OVERSAMPL - MIN_OVERSAMPL) * hc.quality;
 
+    // Lower the quality down to the coarsest voxels hollowing_quality allows,
+    // if the voxelization would not fit into the memory budget otherwise.
+    if (hc.max_memory_mb > 0.)
+        voxel_scale = fit_voxel_scale_to_memory(mesh.its, hc, voxel_scale, MIN_OVERSAMPL);
+
     InteriorPtr interior =
         generate_interior_verbose(mesh, ctl, hc.min_thickness, voxel_scale,
                                   hc.closing_distance);
@@ -15,6 +15,9 @@ struct HollowingConfig
     double quality          = 0.5;
     double closing_distance = 0.5;
     bool enabled = true;
+    // Memory budget of the voxelization in MB. If the voxelized mesh is estimated to exceed it,
+    // the quality is lowered down to quality = 0 to fit. Zero means unlimited.
+    double max_memory_mb = 0.;
 };
 
 enum HollowingFlags { hfRemoveInsideTriangles = 0x1 };
@@ -920,6 +920,7 @@ bool SLAPrintObject::invalidate_state_by_config_options(const std::vector<t_conf
             || opt_key == "hollowing_min_thickness"
             || opt_key == "hollowing_quality"
             || opt_key == "hollowing_closing_distance"
+            || opt_key == "hollowing_max_memory"
             ) {
             steps.emplace_back(slaposHollowing);
         } else if (
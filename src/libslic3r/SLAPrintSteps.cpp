@@ -132,6 +132,7 @@ void SLAPrint::Steps::hollow_model(SLAPrintObject &po)
     double quality  = po.m_config.hollowing_quality.getFloat();
     double closing_d = po.m_config.hollowing_closing_distance.getFloat();
     sla::HollowingConfig hlwcfg{thickness, quality, closing_d};
+    hlwcfg.max_memory_mb = po.m_config.hollowing_max_memory.getFloat();
 
     sla::InteriorPtr interior = generate_interior(po.transformed_mesh(), hlwcfg);
 
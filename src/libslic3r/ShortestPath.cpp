@@ -998,11 +998,240 @@ std::vector<std::pair<size_t, bool>> chain_segments_greedy2(SegmentEndPointFunc
 	return chain_segments_greedy_constrained_reversals2_<PointType, SegmentEndPointFunc, false, decltype(could_reverse_func)>(end_point_func, could_reverse_func, num_segments, start_near);
 }
 
-std::vector<std::pair<size_t, bool>> chain_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near)
+// Uniform grid over the end points of segments for the nearest neighbour chaining.
+// Contrary to the KD tree, end points of segments already chained are removed from the grid, thus the closest point search
+// does not slow down with the number of segments already chained.
+class EndPointGrid
+{
+public:
+	EndPointGrid(const std::vector<Vec2d> &end_points, const std::vector<uint8_t> &valid) : m_end_points(end_points), m_slot(end_points.size(), 0)
+	{
+		BoundingBoxf bbox;
+		for (size_t i = 0; i < end_points.size(); ++ i)
+			if (valid[i]) {
+				bbox.merge(end_points[i]);
+				++ m_size;
+			}
+		m_initial_size = m_size;
+		if (m_size == 0)
+			return;
+		// Aim at about two end points per cell.
+		const Vec2d  size = bbox.size();
+		const double area = std::max(size.x(), 1.) * std::max(size.y(), 1.);
+		m_cell_size = std::max(1., sqrt(2. * area / double(m_size)));
+		m_origin    = bbox.min;
+		// The cells are square, thus a long and thin bounding box would produce many more cells than end points.
+		// Limit the number of cells to a small multiple of the number of end points.
+		const double max_cells = 4. * double(m_size) + 16.;
+		while ((floor(size.x() / m_cell_size) + 1.) * (floor(size.y() / m_cell_size) + 1.) > max_cells)
+			m_cell_size *= 2.;
+		m_cols      = size_t(size.x() / m_cell_size) + 1;
+		m_rows      = size_t(size.y() / m_cell_size) + 1;
+		m_cell_begin.assign(m_cols * m_rows + 1, 0);
+		m_cell_count.assign(m_cols * m_rows, 0);
+		for (size_t i = 0; i < end_points.size(); ++ i)
+			if (valid[i])
+				++ m_cell_count[this->cell_idx(end_points[i])];
+		for (size_t i = 0; i < m_cell_count.size(); ++ i)
+			m_cell_begin[i + 1] = m_cell_begin[i] + m_cell_count[i];
+		m_cell_count.assign(m_cell_count.size(), 0);
+		m_indices.assign(m_size, 0);
+		for (size_t i = 0; i < end_points.size(); ++ i)
+			if (valid[i]) {
+				size_t icell = this->cell_idx(end_points[i]);
+				m_slot[i] = m_cell_begin[icell] + m_cell_count[icell] ++;
+				m_indices[m_slot[i]] = i;
+			}
+	}
+
+	// Number of end points remaining in the grid.
+	size_t size() const { return m_size; }
+	// Number of end points the grid was created with.
+	size_t initial_size() const { return m_initial_size; }
+
+	void remove(size_t idx)
+	{
+		const size_t icell = this->cell_idx(m_end_points[idx]);
+		const size_t last  = m_cell_begin[icell] + (-- m_cell_count[icell]);
+		assert(m_indices[m_slot[idx]] == idx);
+		m_indices[m_slot[idx]] = m_indices[last];
+		m_slot[m_indices[last]] = m_slot[idx];
+		-- m_size;
+	}
+
+	// Index of the remaining end point closest to pt, std::numeric_limits<size_t>::max() if the grid is empty.
+	// The cells are searched in rings of growing radius, until no cell of the next ring could contain a closer point.
+	size_t closest(const Vec2d &pt) const
+	{
+		size_t idx_min = std::numeric_limits<size_t>::max();
+		if (m_size == 0)
+			return idx_min;
+		double       dist_min = std::numeric_limits<double>::max();
+		const long   col      = std::clamp<long>(long(floor((pt.x() - m_origin.x()) / m_cell_size)), 0, long(m_cols) - 1);
+		const long   row      = std::clamp<long>(long(floor((pt.y() - m_origin.y()) / m_cell_size)), 0, long(m_rows) - 1);
+		const long   max_r    = long(std::max(m_cols, m_rows));
+		auto visit_cell = [this, &pt, &idx_min, &dist_min](long c, long r) {
+			const size_t icell = size_t(r) * m_cols + size_t(c);
+			for (size_t i = m_cell_begin[icell], end = i + m_cell_count[icell]; i < end; ++ i) {
+				const size_t idx = m_indices[i];
+				const double d2  = (m_end_points[idx] - pt).squaredNorm();
+				if (d2 < dist_min || (d2 == dist_min && idx < idx_min)) {
+					dist_min = d2;
+					idx_min  = idx;
+				}
+			}
+		};
+		for (long ring = 0; ring <= max_r; ++ ring) {
+			for (long r = std::max(0L, row - ring); r <= std::min(long(m_rows) - 1, row + ring); ++ r)
+				if (std::abs(r - row) == ring) {
+					for (long c = std::max(0L, col - ring); c <= std::min(long(m_cols) - 1, col + ring); ++ c)
+						visit_cell(c, r);
+				} else {
+					if (col - ring >= 0)
+						visit_cell(col - ring, r);
+					if (col + ring < long(m_cols))
+						visit_cell(col + ring, r);
+				}
+			// Any point of the cells of the next ring is at least ring * m_cell_size away from pt.
+			if (idx_min != std::numeric_limits<size_t>::max() && dist_min <= sqr(double(ring) * m_cell_size))
+				break;
+		}
+		return idx_min;
+	}
+
+private:
+	size_t cell_idx(const Vec2d &pt) const
+	{
+		const size_t c = std::min(m_cols - 1, size_t(std::max(0., (pt.x() - m_origin.x()) / m_cell_size)));
+		const size_t r = std::min(m_rows - 1, size_t(std::max(0., (pt.y() - m_origin.y()) / m_cell_size)));
+		return r * m_cols + c;
+	}
+
+	const std::vector<Vec2d> &m_end_points;
+	Vec2d                     m_origin { Vec2d::Zero() };
+	double                    m_cell_size { 1. };
+	size_t                    m_cols { 0 };
+	size_t                    m_rows { 0 };
+	// Compressed rows: end points of a cell are stored at m_indices[m_cell_begin[icell], m_cell_begin[icell] + m_cell_count[icell]).
+	std::vector<size_t>       m_cell_begin;
+	std::vector<size_t>       m_cell_count;
+	std::vector<size_t>       m_indices;
+	// Position of an end point in m_indices.
+	std::vector<size_t>       m_slot;
+	size_t                    m_size { 0 };
+	size_t                    m_initial_size { 0 };
+};
+
+// Nearest neighbour chaining with the end points indexed by a uniform grid. Starting at start_near (or at the first point of the first segment),
+// the closest end point of the segments not yet chained is always taken next. Produces longer travels than the multi-fragment greedy algorithm,
+// but scales linearly with the number of segments, thus it is suited for layers with tens of thousands of short segments.
+template<typename PointType, typename SegmentEndPointFunc, typename CouldReverseFunc>
+std::vector<std::pair<size_t, bool>> chain_segments_nearest_neighbor_grid(SegmentEndPointFunc end_point_func, CouldReverseFunc could_reverse_func, size_t num_segments, const PointType *start_near)
+{
+	if (num_segments < 2)
+		return chain_segments_greedy_constrained_reversals<PointType, SegmentEndPointFunc, CouldReverseFunc>(end_point_func, could_reverse_func, num_segments, start_near);
+
+	std::vector<std::pair<size_t, bool>> out;
+	out.reserve(num_segments);
+	// End point 2 * i is the first point of segment i, 2 * i + 1 is its last point. The last point is only valid for reversible open segments.
+	std::vector<Vec2d>   end_points(num_segments * 2);
+	std::vector<uint8_t> valid(num_segments * 2, 0);
+	for (size_t i = 0; i < num_segments; ++ i) {
+		end_points[i * 2]     = end_point_func(i, true ).template cast<double>();
+		end_points[i * 2 + 1] = end_point_func(i, false).template cast<double>();
+		valid[i * 2]          = true;
+		valid[i * 2 + 1]      = could_reverse_func(i) && end_points[i * 2 + 1] != end_points[i * 2];
+	}
+
+	auto grid = std::make_unique<EndPointGrid>(end_points, valid);
+	auto take = [&](size_t idx) {
+		out.emplace_back(idx / 2, (idx & 1) != 0);
+		for (size_t i = idx & ~size_t(1); i <= (idx | 1); ++ i)
+			if (valid[i]) {
+				grid->remove(i);
+				valid[i] = false;
+			}
+	};
+	take(start_near == nullptr ? 0 : grid->closest(start_near->template cast<double>()));
+	while (grid->size() > 0) {
+		const Vec2d &pos = end_points[(out.back().first * 2) + (out.back().second ? 0 : 1)];
+		// With most of the end points removed, the grid is too fine for the remaining points. Build a coarser one.
+		if (grid->size() > 64 && grid->size() * 4 < grid->initial_size())
+			grid = std::make_unique<EndPointGrid>(end_points, valid);
+		take(grid->closest(pos));
+	}
+	assert(out.size() == num_segments);
+	return out;
+}
+
+// Improve a chain of segments by 2-opt moves: a run of consecutive segments is reversed if it shortens the travels.
+// Only the runs of reversible segments no longer than a fixed window are considered and at most max_passes passes over the chain
+// are made, thus the improvement is bounded even for tens of thousands of segments and its result does not depend on the machine load.
+template<typename PointType, typename SegmentEndPointFunc, typename CouldReverseFunc>
+void improve_chain_by_two_opt(std::vector<std::pair<size_t, bool>> &chain, SegmentEndPointFunc end_point_func, CouldReverseFunc could_reverse_func,
+	const PointType *start_near, size_t max_passes)
+{
+	const size_t num_segments = chain.size();
+	if (num_segments < 2 || max_passes == 0)
+		return;
+
+	static constexpr const size_t window = 64;
+
+	// Entry and exit point of each segment in the order of the chain.
+	std::vector<Vec2d> entries(num_segments), exits(num_segments);
+	for (size_t i = 0; i < num_segments; ++ i) {
+		const std::pair<size_t, bool> &segment = chain[i];
+		entries[i] = end_point_func(segment.first, ! segment.second).template cast<double>();
+		exits[i]  = end_point_func(segment.first,   segment.second).template cast<double>();
+	}
+	// Reversing a run keeps the positions of the irreversible segments in the chain, thus the end of the run of reversible segments
+	// starting at each position is calculated once.
+	std::vector<size_t> run_end(num_segments + 1, num_segments);
+	for (size_t i = num_segments; i > 0; -- i)
+		run_end[i - 1] = could_reverse_func(chain[i - 1].first) ? run_end[i] : i - 1;
+	const Vec2d start_point = start_near ? Vec2d(start_near->template cast<double>()) : Vec2d::Zero();
+
+	for (bool improved = true; improved && max_passes > 0; -- max_passes) {
+		improved = false;
+		for (size_t i = 0; i < num_segments; ++ i) {
+			const bool   has_prev = i > 0 || start_near != nullptr;
+			const Vec2d &prev     = i > 0 ? exits[i - 1] : start_point;
+			for (size_t j = i, j_end = std::min(run_end[i], i + window); j < j_end; ++ j) {
+				// Cost of the travels into the run and out of the run before and after the run is reversed.
+				const bool has_next = j + 1 < num_segments;
+				double     cost_old = 0.;
+				double     cost_new = 0.;
+				if (has_prev) {
+					cost_old += (entries[i] - prev).norm();
+					cost_new += (exits[j] - prev).norm();
+				}
+				if (has_next) {
+					cost_old += (entries[j + 1] - exits[j]).norm();
+					cost_new += (entries[j + 1] - entries[i]).norm();
+				}
+				if (cost_new + EPSILON < cost_old) {
+					std::reverse(chain.begin() + i, chain.begin() + j + 1);
+					std::reverse(entries.begin() + i, entries.begin() + j + 1);
+					std::reverse(exits.begin() + i, exits.begin() + j + 1);
+					for (size_t k = i; k <= j; ++ k) {
+						chain[k].second = ! chain[k].second;
+						std::swap(entries[k], exits[k]);
+					}
+					improved = true;
+				}
+			}
+		}
+	}
+}
+
+std::vector<std::pair<size_t, bool>> chain_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near, const ChainingParams &params)
 {
 	auto segment_end_point = [&entities](size_t idx, bool first_point) -> const Point& { return first_point ? entities[idx]->first_point() : entities[idx]->last_point(); };
 	auto could_reverse = [&entities](size_t idx) { const ExtrusionEntity *ee = entities[idx]; return ee->is_loop() || ee->can_reverse(); };
-	std::vector<std::pair<size_t, bool>> out = chain_segments_greedy_constrained_reversals<Point, decltype(segment_end_point), decltype(could_reverse)>(segment_end_point, could_reverse, entities.size(), start_near);
+	std::vector<std::pair<size_t, bool>> out = params.spatial_grid ?
+		chain_segments_nearest_neighbor_grid<Point, decltype(segment_end_point), decltype(could_reverse)>(segment_end_point, could_reverse, entities.size(), start_near) :
+		chain_segments_greedy_constrained_reversals<Point, decltype(segment_end_point), decltype(could_reverse)>(segment_end_point, could_reverse, entities.size(), start_near);
+	improve_chain_by_two_opt<Point, decltype(segment_end_point), decltype(could_reverse)>(out, segment_end_point, could_reverse, start_near, params.improve_passes);
 	for (std::pair<size_t, bool> &segment : out) {
 		ExtrusionEntity *ee = entities[segment.first];
 		if (ee->is_loop())
@@ -1028,12 +1257,12 @@ void reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const s
     entities.swap(out);
 }
 
-void chain_and_reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near)
+void chain_and_reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near, const ChainingParams &params)
 {
     // this function crashes if there are empty elements in entities
     entities.erase(std::remove_if(entities.begin(), entities.end(), [](ExtrusionEntity *entity) { return static_cast<ExtrusionEntityCollection *>(entity)->empty(); }),
                    entities.end());
-	reorder_extrusion_entities(entities, chain_extrusion_entities(entities, start_near));
+	reorder_extrusion_entities(entities, chain_extrusion_entities(entities, start_near, params));
 }
 
 std::vector<std::pair<size_t, bool>> chain_extrusion_paths(std::vector<ExtrusionPath> &extrusion_paths, const Point *start_near)
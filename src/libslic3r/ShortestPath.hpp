@@ -18,9 +18,19 @@ namespace Slic3r {
 std::vector<size_t> 				 chain_points(const Points &points, Point *start_near = nullptr);
 std::vector<size_t> 				 chain_expolygons(const ExPolygons &input_exploy);
 
-std::vector<std::pair<size_t, bool>> chain_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near = nullptr);
+// Parameters of chaining of extrusion entities, see PrintConfig::path_chaining and PrintConfig::path_chaining_improve_passes.
+struct ChainingParams
+{
+	// Nearest neighbour chaining over a uniform grid of end points instead of the multi-fragment greedy algorithm.
+	// Faster on layers with tens of thousands of short extrusions, at the cost of somewhat longer travels.
+	bool   spatial_grid           { false };
+	// Maximum number of passes of the 2-opt improvement over the chain, zero disables the improvement.
+	size_t improve_passes         { 0 };
+};
+
+std::vector<std::pair<size_t, bool>> chain_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near = nullptr, const ChainingParams &params = ChainingParams());
 void                                 reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const std::vector<std::pair<size_t, bool>> &chain);
-void                                 chain_and_reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near = nullptr);
+void                                 chain_and_reorder_extrusion_entities(std::vector<ExtrusionEntity*> &entities, const Point *start_near = nullptr, const ChainingParams &params = ChainingParams());
 
 std::vector<std::pair<size_t, bool>> chain_extrusion_paths(std::vector<ExtrusionPath> &extrusion_paths, const Point *start_near = nullptr);
 void                                 reorder_extrusion_paths(std::vector<ExtrusionPath> &extrusion_paths, std::vector<std::pair<size_t, bool>> &chain);
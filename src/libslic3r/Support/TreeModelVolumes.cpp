@@ -319,7 +319,7 @@ const Polygons& TreeModelVolumes::getCollisionHolefree(coord_t radius, LayerInde
     assert(radius < m_increase_until_radius + m_current_min_xy_dist_delta);
     if (std::optional<std::reference_wrapper<const Polygons>> result = m_collision_cache_holefree.getArea({ radius, layer_idx }); result)
         return (*result).get();
-    if (m_precalculated) {
+    if (m_precalculated && layer_idx <= m_released_above) {
         BOOST_LOG_TRIVIAL(error_level_not_in_cache) << "Had to calculate collision holefree at radius " << radius << " and layer " << layer_idx << ", but precalculate was called. Performance may suffer!";
         tree_supports_show_error("Not precalculated Holefree Collision requested."sv, false);
     }
@@ -342,7 +342,7 @@ const Polygons& TreeModelVolumes::getAvoidance(const coord_t orig_radius, LayerI
         result)
         return (*result).get();
 
-    if (m_precalculated) {
+    if (m_precalculated && layer_idx <= m_released_above) {
         if (to_model) {
             BOOST_LOG_TRIVIAL(error_level_not_in_cache) << "Had to calculate Avoidance to model at radius " << radius << " and layer " << layer_idx << ", but precalculate was called. Performance may suffer!";
             tree_supports_show_error("Not precalculated Avoidance(to model) requested."sv, false);
@@ -387,7 +387,7 @@ const Polygons& TreeModelVolumes::getWallRestriction(const coord_t orig_radius,
         (min_xy_dist ? m_wall_restrictions_cache_min : m_wall_restrictions_cache).getArea({ radius, layer_idx });
         result)
         return (*result).get();
-    if (m_precalculated) {
+    if (m_precalculated && layer_idx <= m_released_above) {
         BOOST_LOG_TRIVIAL(error_level_not_in_cache) << "Had to calculate Wall restricions at radius " << radius << " and layer " << layer_idx << ", but precalculate was called. Performance may suffer!";
         tree_supports_show_error(
             min_xy_dist ? 
@@ -861,24 +861,151 @@ coord_t TreeModelVolumes::ceilRadius(const coord_t radius) const
     return out;
 }
 
-void TreeModelVolumes::RadiusLayerPolygonCache::allocate_layers(size_t num_layers)
+size_t TreeModelVolumes::cache_memory_size() const
+{
+    size_t memory = 0;
+    for (const RadiusLayerPolygonCache *cache : { &m_collision_cache, &m_collision_cache_holefree, &m_avoidance_cache, &m_avoidance_cache_slow,
+            &m_avoidance_cache_to_model, &m_avoidance_cache_to_model_slow, &m_placeable_areas_cache, &m_avoidance_cache_holefree,
+            &m_avoidance_cache_holefree_to_model, &m_wall_restrictions_cache, &m_wall_restrictions_cache_min })
+        memory += cache->memory_size();
+    return memory;
+}
+
+void TreeModelVolumes::release_caches_above(LayerIndex layer_idx, size_t memory_budget)
+{
+    if (this->cache_memory_size() <= memory_budget)
+        return;
+    size_t memory_before = this->cache_memory_size();
+    // The collisions and placeable areas are kept, they are needed for placing and drawing the branches.
+    for (RadiusLayerPolygonCache *cache : { &m_collision_cache_holefree, &m_avoidance_cache, &m_avoidance_cache_slow,
+            &m_avoidance_cache_to_model, &m_avoidance_cache_to_model_slow, &m_avoidance_cache_holefree,
+            &m_avoidance_cache_holefree_to_model, &m_wall_restrictions_cache, &m_wall_restrictions_cache_min })
+        cache->clear_layers_above(layer_idx);
+    m_released_above = std::min(m_released_above, layer_idx);
+    BOOST_LOG_TRIVIAL(debug) << "Tree support caches over budget, released layers above " << layer_idx << ", " << 
+        memory_before / (1024 * 1024) << " MB -> " << this->cache_memory_size() / (1024 * 1024) << " MB";
+}
+
+TreeModelVolumes::RadiusLayerPolygonCache& TreeModelVolumes::RadiusLayerPolygonCache::operator=(RadiusLayerPolygonCache &&rhs)
 {
-    if (num_layers > m_data.size()) {
-        if (num_layers > m_data.capacity())
-            reserve_power_of_2(m_data, num_layers);
-        m_data.resize(num_layers, {});
+    if (this != &rhs) {
+        this->clear();
+        for (size_t i = 0; i < NumSegments; ++ i)
+            m_segments[i].store(rhs.m_segments[i].exchange(nullptr));
+        m_num_layers.store(rhs.m_num_layers.exchange(0));
+        m_memory_size.store(rhs.m_memory_size.exchange(0));
     }
+    return *this;
+}
+
+TreeModelVolumes::RadiusLayerPolygonCache::LayerData& TreeModelVolumes::RadiusLayerPolygonCache::get_allocate_layer_data(LayerIndex layer_idx)
+{
+    assert(layer_idx >= 0);
+    auto [segment, offset] = segment_and_offset(size_t(layer_idx));
+    assert(segment < NumSegments);
+    LayerData *layers = m_segments[segment].load(std::memory_order_acquire);
+    if (layers == nullptr) {
+        // Allocate the segment. If another thread was faster, use its segment.
+        LayerData *new_layers = new LayerData[segment_size(segment)];
+        for (size_t i = 0; i < segment_size(segment); ++ i)
+            new_layers[i].store(nullptr, std::memory_order_relaxed);
+        if (m_segments[segment].compare_exchange_strong(layers, new_layers, std::memory_order_acq_rel, std::memory_order_acquire))
+            layers = new_layers;
+        else
+            delete[] new_layers;
+    }
+    for (size_t num_layers = m_num_layers.load(std::memory_order_relaxed); 
+         num_layers <= size_t(layer_idx) && ! m_num_layers.compare_exchange_weak(num_layers, size_t(layer_idx) + 1, std::memory_order_release, std::memory_order_relaxed);) ;
+    return layers[offset];
+}
+
+size_t TreeModelVolumes::RadiusLayerPolygonCache::node_memory_size(const Node &node)
+{
+    size_t memory = sizeof(Node);
+    for (const Polygon &polygon : node.polygons)
+        memory += sizeof(Polygon) + polygon.points.capacity() * sizeof(Point);
+    return memory;
+}
+
+size_t TreeModelVolumes::RadiusLayerPolygonCache::insert(LayerData &layer, coord_t radius, Polygons &&polygons)
+{
+    Node *new_node = new Node(radius, std::move(polygons));
+    // Link the new node after the last node with a lower radius. If another node was linked in at the same place
+    // in the meantime, continue searching from there.
+    LayerData *prev = &layer;
+    Node      *next = prev->load(std::memory_order_acquire);
+    for (;;) {
+        for (; next != nullptr && next->radius < radius; next = prev->load(std::memory_order_acquire))
+            prev = &next->next;
+        if (next != nullptr && next->radius == radius) {
+            // Already cached, keep the first area as std::map::emplace() would.
+            delete new_node;
+            return 0;
+        }
+        new_node->next.store(next, std::memory_order_relaxed);
+        if (prev->compare_exchange_weak(next, new_node, std::memory_order_release, std::memory_order_acquire))
+            return node_memory_size(*new_node);
+    }
+}
+
+size_t TreeModelVolumes::RadiusLayerPolygonCache::clear(LayerData &layer, bool keep_first)
+{
+    Node *node = layer.load(std::memory_order_relaxed);
+    if (keep_first && node != nullptr)
+        node = node->next.exchange(nullptr, std::memory_order_relaxed);
+    else
+        layer.store(nullptr, std::memory_order_relaxed);
+    size_t memory = 0;
+    while (node != nullptr) {
+        Node *next = node->next.load(std::memory_order_relaxed);
+        memory += node_memory_size(*node);
+        delete node;
+        node = next;
+    }
+    return memory;
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear()
+{
+    for (size_t segment = 0; segment < NumSegments; ++ segment)
+        if (LayerData *layers = m_segments[segment].exchange(nullptr); layers != nullptr) {
+            for (size_t i = 0; i < segment_size(segment); ++ i)
+                clear(layers[i], false);
+            delete[] layers;
+        }
+    m_num_layers.store(0);
+    m_memory_size.store(0);
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear_all_but_radius0()
+{
+    size_t memory = 0;
+    for (LayerIndex layer_idx = 0; layer_idx < LayerIndex(m_num_layers.load()); ++ layer_idx)
+        if (LayerData *layer = this->layer_data(layer_idx); layer != nullptr)
+            memory += clear(*layer, true);
+    m_memory_size.fetch_sub(memory);
+}
+
+void TreeModelVolumes::RadiusLayerPolygonCache::clear_layers_above(LayerIndex layer_idx)
+{
+    const LayerIndex first_layer = std::max(0, layer_idx + 1);
+    size_t           memory      = 0;
+    for (LayerIndex i = first_layer; i < LayerIndex(m_num_layers.load()); ++ i)
+        if (LayerData *layer = this->layer_data(i); layer != nullptr)
+            memory += clear(*layer, false);
+    if (LayerIndex(m_num_layers.load()) > first_layer)
+        m_num_layers.store(size_t(first_layer));
+    m_memory_size.fetch_sub(memory);
 }
 
 // For debugging purposes, sorted by layer index, then by radius.
 std::vector<std::pair<TreeModelVolumes::RadiusLayerPair, std::reference_wrapper<const Polygons>>> TreeModelVolumes::RadiusLayerPolygonCache::sorted() const
 {
     std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> out;
-    for (auto &layer : m_data) {
-        auto layer_idx = LayerIndex(&layer - m_data.data());
-        for (auto &radius_polygons : layer)
-            out.emplace_back(std::make_pair(radius_polygons.first, layer_idx), radius_polygons.second);
-    }
+    for (LayerIndex layer_idx = 0; layer_idx < LayerIndex(m_num_layers.load()); ++ layer_idx)
+        if (const LayerData *layer = this->layer_data(layer_idx); layer != nullptr)
+            for (const Node *node = layer->load(); node != nullptr; node = node->next.load())
+                out.emplace_back(std::make_pair(node->radius, layer_idx), node->polygons);
     assert(std::is_sorted(out.begin(), out.end(), [](auto &l, auto &r){ return l.first.second < r.first.second || (l.first.second == r.first.second) && l.first.first < r.first.first; }));
     return out;
 }
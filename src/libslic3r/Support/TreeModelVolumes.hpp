@@ -9,8 +9,12 @@
 #ifndef slic3r_TreeModelVolumes_hpp
 #define slic3r_TreeModelVolumes_hpp
 
-#include <mutex>
+#include <atomic>
+#include <limits>
 #include <unordered_map>
+#ifdef SLIC3R_TREESUPPORTS_PROGRESS
+    #include <mutex>
+#endif // SLIC3R_TREESUPPORTS_PROGRESS
 
 #include <boost/functional/hash.hpp>
 
@@ -70,6 +74,19 @@ public:
         m_wall_restrictions_cache_min.clear();
     }
 
+    // Approximate size of the memory allocated by all the caches.
+    size_t cache_memory_size() const;
+    /*!
+     * \brief Release the avoidances and wall restrictions of the layers above layer_idx, if the caches grew over memory_budget bytes.
+     *
+     * Called while the influence areas are propagated top down, as the areas above the current layer are not needed anymore.
+     * The areas released are calculated again if requested, without reporting an error as for areas missing after precalculate().
+     * Must not be called while references to the released areas are held.
+     * The budget is only applied when releasing: precalculate() fills the caches without a limit, as the avoidances of a layer
+     * are calculated from the avoidances of the layer below and not precalculating them would only defer their calculation.
+     */
+    void release_caches_above(LayerIndex layer_idx, size_t memory_budget);
+
     enum class AvoidanceType : int8_t
     {
         Slow,
@@ -197,43 +214,57 @@ private:
      * \brief Convenience typedef for the keys to the caches
      */
     using RadiusLayerPair             = std::pair<coord_t, LayerIndex>;
+    // Cache of collision regions indexed by layer and radius, filled and queried concurrently by the precalculation.
+    // The layers are independent shards, each one a singly linked list of areas sorted by radius. New areas are linked
+    // in with a compare and swap, and the areas are never moved or released while the cache is being filled,
+    // thus the lookups take no locks and the references to Polygons returned stay valid.
     class RadiusLayerPolygonCache {
-        // Map from radius to Polygons. Cache of one layer collision regions.
-        using LayerData = std::map<coord_t, Polygons>;
-        // Vector of layers, at each layer map of radius to Polygons.
-        // Reference to Polygons returned shall be stable to insertion.
-        using Layers = std::vector<LayerData>;
+        struct Node {
+            Node(coord_t radius, Polygons &&polygons) : radius(radius), polygons(std::move(polygons)) {}
+            const coord_t       radius;
+            const Polygons      polygons;
+            std::atomic<Node*>  next { nullptr };
+        };
+        // Head of the list of areas of a single layer.
+        using LayerData = std::atomic<Node*>;
+        // Layers are allocated in segments of exponentially growing size, so that the layers never move.
+        // The first two segments contain 64 layers, each following segment doubles the number of layers.
+        static constexpr const size_t FirstSegmentBits = 6;
+        static constexpr const size_t NumSegments      = 8 * sizeof(LayerIndex) - FirstSegmentBits;
     public:
         RadiusLayerPolygonCache() = default;
-        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) : m_data(std::move(rhs.m_data)) {}
-        RadiusLayerPolygonCache& operator=(RadiusLayerPolygonCache &&rhs) { m_data = std::move(rhs.m_data); return *this; }
+        RadiusLayerPolygonCache(RadiusLayerPolygonCache &&rhs) { *this = std::move(rhs); }
+        RadiusLayerPolygonCache& operator=(RadiusLayerPolygonCache &&rhs);
+        ~RadiusLayerPolygonCache() { this->clear(); }
 
         RadiusLayerPolygonCache(const RadiusLayerPolygonCache&) = delete;
         RadiusLayerPolygonCache& operator=(const RadiusLayerPolygonCache&) = delete;
 
         void insert(std::vector<std::pair<RadiusLayerPair, Polygons>> &&in) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            size_t memory = 0;
             for (auto &d : in)
-                this->get_allocate_layer_data(d.first.second).emplace(d.first.first, std::move(d.second));
+                memory += insert(this->get_allocate_layer_data(d.first.second), d.first.first, std::move(d.second));
+            m_memory_size.fetch_add(memory, std::memory_order_relaxed);
         }
         // by layer
         void insert(std::vector<std::pair<coord_t, Polygons>> &&in, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            size_t memory = 0;
             for (auto &d : in)
-                this->get_allocate_layer_data(d.first).emplace(radius, std::move(d.second));
+                memory += insert(this->get_allocate_layer_data(d.first), radius, std::move(d.second));
+            m_memory_size.fetch_add(memory, std::memory_order_relaxed);
         }
         void insert(std::vector<Polygons> &&in, coord_t first_layer_idx, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            allocate_layers(first_layer_idx + in.size());
+            size_t memory = 0;
             for (auto &d : in)
-                m_data[first_layer_idx ++].emplace(radius, std::move(d));
+                memory += insert(this->get_allocate_layer_data(first_layer_idx ++), radius, std::move(d));
+            m_memory_size.fetch_add(memory, std::memory_order_relaxed);
         }
         void insert(LayerPolygonCache &&in, coord_t radius) {
-            std::lock_guard<std::mutex> guard(m_mutex);
+            size_t memory = 0;
             LayerIndex i = in.begin();
-            allocate_layers(i + LayerIndex(in.size()));
             for (auto &d : in.polygons_mutable())
-                m_data[i ++].emplace(radius, std::move(d));
+                memory += insert(this->get_allocate_layer_data(i ++), radius, std::move(d));
+            m_memory_size.fetch_add(memory, std::memory_order_relaxed);
         }
         /*!
          * \brief Checks a cache for a given RadiusLayerPair and returns it if it is found
@@ -241,29 +272,16 @@ private:
          * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
          */
         std::optional<std::reference_wrapper<const Polygons>> getArea(const TreeModelVolumes::RadiusLayerPair &key) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            if (key.second >= LayerIndex(m_data.size()))
-                return std::optional<std::reference_wrapper<const Polygons>>{};
-            const auto &layer = m_data[key.second];
-            auto it = layer.find(key.first);
-            return it == layer.end() ? 
-                std::optional<std::reference_wrapper<const Polygons>>{} : std::optional<std::reference_wrapper<const Polygons>>{ it->second };
+            const Node *node = this->find_lower_bound(key);
+            return node == nullptr || node->radius != key.first ?
+                std::optional<std::reference_wrapper<const Polygons>>{} : std::optional<std::reference_wrapper<const Polygons>>{ node->polygons };
         }
         // Get a collision area at a given layer for a radius that is a lower or equial to the key radius.
         std::optional<std::pair<coord_t, std::reference_wrapper<const Polygons>>> get_lower_bound_area(const TreeModelVolumes::RadiusLayerPair &key) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            if (key.second >= LayerIndex(m_data.size()))
-                return {};
-            const auto &layer = m_data[key.second];
-            if (layer.empty())
+            const Node *node = this->find_lower_bound(key);
+            if (node == nullptr)
                 return {};
-            auto it = layer.lower_bound(key.first);
-            if (it == layer.end() || it->first != key.first) {
-                if (it == layer.begin())
-                    return {};
-                -- it;
-            }
-            return std::make_pair(it->first, std::reference_wrapper<const Polygons>(it->second));
+            return std::make_pair(node->radius, std::reference_wrapper<const Polygons>(node->polygons));
         }
         /*!
          * \brief Get the highest already calculated layer in the cache.
@@ -273,10 +291,9 @@ private:
          * \return A wrapped optional reference of the requested area (if it was found, an empty optional if nothing was found)
          */
         LayerIndex getMaxCalculatedLayer(coord_t radius) const {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            auto layer_idx = LayerIndex(m_data.size()) - 1;
+            auto layer_idx = LayerIndex(m_num_layers.load(std::memory_order_acquire)) - 1;
             for (; layer_idx > 0; -- layer_idx)
-                if (const auto &layer = m_data[layer_idx]; layer.find(radius) != layer.end())
+                if (this->getArea({ radius, layer_idx }))
                     break;
             // The placeable on model areas do not exist on layer 0, as there can not be model below it. As such it may be possible that layer 1 is available, but layer 0 does not exist.
             return layer_idx == 0 ? -1 : layer_idx;
@@ -285,25 +302,51 @@ private:
         // For debugging purposes, sorted by layer index, then by radius.
         [[nodiscard]] std::vector<std::pair<RadiusLayerPair, std::reference_wrapper<const Polygons>>> sorted() const;
 
-        void clear() { m_data.clear(); }
-        void clear_all_but_radius0() { 
-            for (LayerData &l : m_data) {
-                auto begin = l.begin();
-                auto end = l.end();
-                if (begin != end && ++ begin != end)
-                    l.erase(begin, end);
-            }
-        }
+        // Approximate size of the memory allocated by the cached areas.
+        size_t memory_size() const { return m_memory_size.load(std::memory_order_relaxed); }
+
+        // The following methods release cached areas, they must not be called while the cache is being filled
+        // or while references to the released areas are held.
+        void clear();
+        void clear_all_but_radius0();
+        // Release the areas of the layers above layer_idx. Areas released are calculated again if requested.
+        void clear_layers_above(LayerIndex layer_idx);
 
     private:
-        LayerData&          get_allocate_layer_data(LayerIndex layer_idx) {
-            allocate_layers(layer_idx + 1);
-            return m_data[layer_idx];
+        static std::pair<size_t, size_t> segment_and_offset(size_t layer_idx) {
+            size_t segment = 0;
+            for (size_t i = layer_idx >> FirstSegmentBits; i > 0; i >>= 1)
+                ++ segment;
+            return { segment, segment == 0 ? layer_idx : layer_idx - (size_t(1) << (FirstSegmentBits + segment - 1)) };
         }
-        void                allocate_layers(size_t num_layers);
-
-        Layers              m_data;
-        mutable std::mutex  m_mutex;
+        static size_t segment_size(size_t segment) { return size_t(1) << (segment == 0 ? FirstSegmentBits : FirstSegmentBits + segment - 1); }
+
+        LayerData* layer_data(LayerIndex layer_idx) const {
+            if (layer_idx < 0)
+                return nullptr;
+            auto [segment, offset] = segment_and_offset(size_t(layer_idx));
+            LayerData *layers = segment < NumSegments ? m_segments[segment].load(std::memory_order_acquire) : nullptr;
+            return layers == nullptr ? nullptr : layers + offset;
+        }
+        // Area of the largest radius lower or equal to key.first.
+        const Node* find_lower_bound(const TreeModelVolumes::RadiusLayerPair &key) const {
+            const Node *out = nullptr;
+            if (const LayerData *layer = this->layer_data(key.second); layer != nullptr)
+                for (const Node *node = layer->load(std::memory_order_acquire); node != nullptr && node->radius <= key.first; node = node->next.load(std::memory_order_acquire))
+                    out = node;
+            return out;
+        }
+        LayerData&          get_allocate_layer_data(LayerIndex layer_idx);
+        // Returns the size of the memory allocated, zero if an area of the same radius is already cached.
+        static size_t       insert(LayerData &layer, coord_t radius, Polygons &&polygons);
+        // Returns the size of the memory released.
+        static size_t       clear(LayerData &layer, bool keep_first);
+        static size_t       node_memory_size(const Node &node);
+
+        std::atomic<LayerData*> m_segments[NumSegments] {};
+        // One past the highest layer allocated.
+        std::atomic<size_t>     m_num_layers { 0 };
+        std::atomic<size_t>     m_memory_size { 0 };
     };
 
 
@@ -430,6 +473,8 @@ private:
     coord_t m_min_resolution;
 
     bool m_precalculated = false;
+    // Areas of the layers above were released by release_caches_above(), calculating them again is expected.
+    LayerIndex m_released_above = std::numeric_limits<LayerIndex>::max();
     /*!
      * \brief The index to access the outline corresponding with the currently processing mesh
      */
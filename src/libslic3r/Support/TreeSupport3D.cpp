@@ -23,6 +23,7 @@
 #include "TriangleMeshSlicer.hpp"
 #include "TreeSupport.hpp"
 #include "I18N.hpp"
+#include "Utils.hpp"
 
 #include <cassert>
 #include <chrono>
@@ -2447,7 +2448,7 @@ static void merge_influence_areas(
  *
  * \param move_bounds[in,out] All currently existing influence areas
  */
-static void create_layer_pathing(const TreeModelVolumes &volumes, const TreeSupportSettings &config, std::vector<SupportElements> &move_bounds, std::function<void()> throw_on_cancel)
+static void create_layer_pathing(TreeModelVolumes &volumes, const TreeSupportSettings &config, std::vector<SupportElements> &move_bounds, std::function<void()> throw_on_cancel)
 {
 #ifdef SLIC3R_TREESUPPORTS_PROGRESS
     const double data_size_inverse = 1 / double(move_bounds.size());
@@ -2464,6 +2465,9 @@ static void create_layer_pathing(const TreeModelVolumes &volumes, const TreeSupp
     // Ensures at least one merge operation per 3mm height, 50 layers, 1 mm movement of slow speed or 5mm movement of fast speed (whatever is lowest). Values were guessed.
     size_t max_merge_every_x_layers = std::min(std::min(5000 / (std::max(config.maximum_move_distance, coord_t(100))), 1000 / std::max(config.maximum_move_distance_slow, coord_t(20))), 3000 / config.layer_height);
     size_t merge_every_x_layers = 1;
+    // Above this size, the avoidances of the layers already processed are released from the caches.
+    // This bounds the memory held while propagating, not the peak reached by precalculate().
+    const size_t cache_memory_budget = std::max<size_t>(total_physical_memory() / 8, size_t(1) << 30);
     // Calculate the influence areas for each layer below (Top down)
     // This is done by first increasing the influence area by the allowed movement distance, and merging them with other influence areas if possible
     for (int layer_idx = int(move_bounds.size()) - 1; layer_idx > 0; -- layer_idx)
@@ -2539,6 +2543,8 @@ static void create_layer_pathing(const TreeModelVolumes &volumes, const TreeSupp
             progress_total += data_size_inverse * TREE_PROGRESS_AREA_CALC;
             Progress::messageProgress(Progress::Stage::SUPPORT, progress_total * m_progress_multiplier + m_progress_offset, TREE_PROGRESS_TOTAL);
     #endif
+            // The layers above layer_idx are not queried anymore by the propagation.
+            volumes.release_caches_above(layer_idx, cache_memory_budget);
             throw_on_cancel();
         }
 
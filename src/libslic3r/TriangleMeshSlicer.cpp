@@ -17,6 +17,7 @@
 #include <boost/log/trivial.hpp>
 
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 #ifndef NDEBUG
 //    #define EXPENSIVE_DEBUG_CHECKS
@@ -59,20 +60,20 @@ class IntersectionReference
 {
 public:
     IntersectionReference() = default;
-    IntersectionReference(int point_id, int edge_id) : point_id(point_id), edge_id(edge_id) {}
+    IntersectionReference(int point_id, int64_t edge_id) : point_id(point_id), edge_id(edge_id) {}
     // Where is this intersection point located? On mesh vertex or mesh edge?
     // Only one of the following will be set, the other will remain set to -1.
     // Index of the mesh vertex.
     int point_id { -1 };
-    // Index of the mesh edge.
-    int edge_id { -1 };
+    // Identifier of the mesh edge, either an index of the mesh edge or a FacetVertexEdgeIds key.
+    int64_t edge_id { -1 };
 };
 
 class IntersectionPoint : public Point, public IntersectionReference
 {
 public:
     IntersectionPoint() = default;
-    IntersectionPoint(int point_id, int edge_id, const Point &pt) : IntersectionReference(point_id, edge_id), Point(pt) {}
+    IntersectionPoint(int point_id, int64_t edge_id, const Point &pt) : IntersectionReference(point_id, edge_id), Point(pt) {}
     IntersectionPoint(const IntersectionReference &ir, const Point &pt) : IntersectionReference(ir), Point(pt) {}
     // Inherits coord_t x, y
 };
@@ -96,8 +97,8 @@ public:
     int             a_id { -1 };
     int             b_id { -1 };
     // Source mesh edges of the line end points.
-    int             edge_a_id { -1 };
-    int             edge_b_id { -1 };
+    int64_t         edge_a_id { -1 };
+    int64_t         edge_b_id { -1 };
 
     enum class FacetEdgeType { 
         // A general case, the cutting plane intersect a face at two different edges.
@@ -152,14 +153,30 @@ enum class FacetSliceType {
     Cutting = 2
 };
 
+// Identifies the edges of a facet by the indices of their end vertices, so that the facets sharing an edge
+// get the same edge ID without calculating the edge IDs of the whole mesh with its_face_edge_ids().
+// Edge k of a facet connects its vertices k and (k + 1) % 3.
+struct FacetVertexEdgeIds
+{
+    explicit FacetVertexEdgeIds(const stl_triangle_vertex_indices &indices) : indices(indices) {}
+    int64_t operator()(int k) const {
+        const uint64_t a = uint32_t(indices(k));
+        const uint64_t b = uint32_t(indices(k == 2 ? 0 : k + 1));
+        return int64_t((std::min(a, b) << 32) | std::max(a, b));
+    }
+    const stl_triangle_vertex_indices &indices;
+};
+
+// EdgeIds returns the ID of facet edge k by edge_ids(k), it is either the facet row of its_face_edge_ids() or FacetVertexEdgeIds.
 // Return true, if the facet has been sliced and line_out has been filled.
+template<typename EdgeIds>
 static FacetSliceType slice_facet(
     // Z height of the slice in XY plane. Scaled or unscaled (same as vertices[].z()).
     float                                slice_z,
     // 3 vertices of the triangle, XY scaled. Z scaled or unscaled (same as slice_z).
     const stl_vertex                    *vertices,
     const stl_triangle_vertex_indices   &indices,
-    const Vec3i32                         &edge_ids,
+    const EdgeIds                       &edge_ids,
     const int                            idx_vertex_lowest,
     const bool                           horizontal,
     IntersectionLine                    &line_out)
@@ -172,7 +189,7 @@ static FacetSliceType slice_facet(
     // This is needed to get all intersection lines in a consistent order
     // (external on the right of the line)
     for (int j = 0; j < 3; ++ j) {  // loop through facet edges
-        int               edge_id;
+        int64_t           edge_id;
         const stl_vertex *a, *b, *c;
         int               a_id, b_id;
         {
@@ -472,17 +489,16 @@ static FacetSliceType slice_facet_for_cut_mesh(
     return FacetSliceType::NoSlice;
 }
 
-template<typename TransformVertex>
+// Slice a single facet at all zs it spans, pass the intersection lines to emit_line(slice_id, line).
+template<typename TransformVertex, typename EmitLine>
 void slice_facet_at_zs(
     // Scaled or unscaled vertices. transform_vertex_fn may scale zs.
     const std::vector<Vec3f>                         &mesh_vertices,
     const TransformVertex                            &transform_vertex_fn,
     const stl_triangle_vertex_indices                &indices,
-    const Vec3i32                                      &edge_ids,
     // Scaled or unscaled zs. If vertices have their zs scaled or transform_vertex_fn scales them, then zs have to be scaled as well.
     const std::vector<float>                         &zs,
-    std::vector<IntersectionLines>                   &lines,
-    std::array<std::mutex, 64>                       &lines_mutex)
+    EmitLine                                         &&emit_line)
 {
     stl_vertex vertices[3] { transform_vertex_fn(mesh_vertices[indices(0)]), transform_vertex_fn(mesh_vertices[indices(1)]), transform_vertex_fn(mesh_vertices[indices(2)]) };
 
@@ -498,36 +514,84 @@ void slice_facet_at_zs(
     for (auto it = min_layer; it != max_layer; ++ it) {
         IntersectionLine il;
         // Ignore horizontal triangles. Any valid horizontal triangle must have a vertical triangle connected, otherwise the part has zero volume.
-        if (min_z != max_z && slice_facet(*it, vertices, indices, edge_ids, idx_vertex_lowest, false, il) == FacetSliceType::Slicing) {
+        if (min_z != max_z && slice_facet(*it, vertices, indices, FacetVertexEdgeIds(indices), idx_vertex_lowest, false, il) == FacetSliceType::Slicing) {
             assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
-            size_t slice_id = it - zs.begin();
-            boost::lock_guard<std::mutex> l(lines_mutex[slice_id % lines_mutex.size()]);
-            lines[slice_id].emplace_back(il);
+            emit_line(size_t(it - zs.begin()), il);
         }
     }
 }
 
+// Slice all facets at all zs without locking, in two passes.
+// First the facets are split into chunks, each chunk collects its intersection lines with their slice indices
+// and counts them per slice. Then the lines of each slice are allocated at once and the chunks scatter their lines
+// in parallel, each chunk into its own range of each slice calculated from the counts of the preceding chunks.
+// The lines of a slice are ordered by their facets, thus the result does not depend on the scheduling of the threads.
 template<typename TransformVertex, typename ThrowOnCancel>
 static inline std::vector<IntersectionLines> slice_make_lines(
     const std::vector<stl_vertex>                   &vertices,
     const TransformVertex                           &transform_vertex_fn,
     const std::vector<stl_triangle_vertex_indices>  &indices,
-    const std::vector<Vec3i32>                        &face_edge_ids,
     const std::vector<float>                        &zs,
     const ThrowOnCancel                              throw_on_cancel_fn)
 {
-    std::vector<IntersectionLines>  lines(zs.size(), IntersectionLines());
-    std::array<std::mutex, 64>      lines_mutex;
+    struct Chunk {
+        IntersectionLines       lines;
+        std::vector<uint32_t>   slice_ids;
+        // Number of lines per slice, then the index of the first line of this chunk in each slice.
+        std::vector<uint32_t>   slice_offsets;
+    };
+    // Enough chunks to balance the load, but not too many to keep the per slice counters of all chunks small.
+    const size_t num_chunks = std::clamp<size_t>(indices.size() / 4096, 1, 4 * size_t(tbb::this_task_arena::max_concurrency()));
+    std::vector<Chunk> chunks(num_chunks);
+
     tbb::parallel_for(
-        tbb::blocked_range<int>(0, int(indices.size())),
-        [&vertices, &transform_vertex_fn, &indices, &face_edge_ids, &zs, &lines, &lines_mutex, throw_on_cancel_fn](const tbb::blocked_range<int> &range) {
-            for (int face_idx = range.begin(); face_idx < range.end(); ++ face_idx) {
-                if ((face_idx & 0x0ffff) == 0)
-                    throw_on_cancel_fn();
-                slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx], face_edge_ids[face_idx], zs, lines, lines_mutex);
+        tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [&vertices, &transform_vertex_fn, &indices, &zs, &chunks, num_chunks, throw_on_cancel_fn](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_idx = range.begin(); chunk_idx < range.end(); ++ chunk_idx) {
+                Chunk       &chunk      = chunks[chunk_idx];
+                const size_t face_begin = indices.size() * chunk_idx / num_chunks;
+                const size_t face_end   = indices.size() * (chunk_idx + 1) / num_chunks;
+                chunk.slice_offsets.assign(zs.size(), 0);
+                auto emit_line = [&chunk](size_t slice_id, const IntersectionLine &il) {
+                    chunk.lines.emplace_back(il);
+                    chunk.slice_ids.emplace_back(uint32_t(slice_id));
+                    ++ chunk.slice_offsets[slice_id];
+                };
+                for (size_t face_idx = face_begin; face_idx < face_end; ++ face_idx) {
+                    if ((face_idx & 0x0ffff) == 0)
+                        throw_on_cancel_fn();
+                    slice_facet_at_zs(vertices, transform_vertex_fn, indices[face_idx], zs, emit_line);
+                }
             }
-        }
-    );
+        });
+
+    std::vector<IntersectionLines> lines(zs.size(), IntersectionLines());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, zs.size()),
+        [&chunks, &lines](const tbb::blocked_range<size_t> &range) {
+            for (size_t slice_id = range.begin(); slice_id < range.end(); ++ slice_id) {
+                uint32_t num_lines = 0;
+                for (Chunk &chunk : chunks) {
+                    const uint32_t cnt = chunk.slice_offsets[slice_id];
+                    chunk.slice_offsets[slice_id] = num_lines;
+                    num_lines += cnt;
+                }
+                lines[slice_id].resize(num_lines);
+            }
+        });
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, num_chunks, 1),
+        [&chunks, &lines](const tbb::blocked_range<size_t> &range) {
+            for (size_t chunk_idx = range.begin(); chunk_idx < range.end(); ++ chunk_idx) {
+                Chunk &chunk = chunks[chunk_idx];
+                for (size_t i = 0; i < chunk.lines.size(); ++ i) {
+                    const uint32_t slice_id = chunk.slice_ids[i];
+                    lines[slice_id][chunk.slice_offsets[slice_id] ++] = chunk.lines[i];
+                }
+                chunk = Chunk();
+            }
+        });
     return lines;
 }
 
@@ -536,7 +600,6 @@ static inline IntersectionLines slice_make_lines(
     const std::vector<stl_vertex>                   &mesh_vertices,
     const TransformVertex                           &transform_vertex_fn,
     const std::vector<stl_triangle_vertex_indices>  &mesh_faces,
-    const std::vector<Vec3i32>                        &face_edge_ids,
     const float                                      plane_z, 
     FaceFilter                                       face_filter)
 {
@@ -552,7 +615,7 @@ static inline IntersectionLines slice_make_lines(
             int              idx_vertex_lowest = (vertices[1].z() == min_z) ? 1 : ((vertices[2].z() == min_z) ? 2 : 0);
             IntersectionLine il;
             // Ignore horizontal triangles. Any valid horizontal triangle must have a vertical triangle connected, otherwise the part has zero volume.
-            if (min_z != max_z && slice_facet(plane_z, vertices, indices, face_edge_ids[face_idx], idx_vertex_lowest, false, il) == FacetSliceType::Slicing) {
+            if (min_z != max_z && slice_facet(plane_z, vertices, indices, FacetVertexEdgeIds(indices), idx_vertex_lowest, false, il) == FacetSliceType::Slicing) {
                 assert(il.edge_type != IntersectionLine::FacetEdgeType::Horizontal);
                 lines.emplace_back(il);
             }
@@ -1187,7 +1250,7 @@ static void chain_open_polylines_exact(std::vector<OpenPolyline> &open_polylines
         const IntersectionReference& ipref() const { return start ? polyline->start : polyline->end; }
         // Return a unique ID for the intersection point.
         // Return a positive id for a point, or a negative id for an edge.
-        int id() const { const IntersectionReference &r = ipref(); return (r.point_id >= 0) ? r.point_id : - r.edge_id; }
+        int64_t id() const { const IntersectionReference &r = ipref(); return (r.point_id >= 0) ? r.point_id : - r.edge_id; }
         bool operator==(const OpenPolylineEnd &rhs) const { return this->polyline == rhs.polyline && this->start == rhs.start; }
     };
     auto by_id_lower = [](const OpenPolylineEnd &ope1, const OpenPolylineEnd &ope2) { return ope1.id() < ope2.id(); };
@@ -1873,27 +1936,26 @@ std::vector<Polygons> slice_mesh(
     std::vector<IntersectionLines> lines;
 
     {
-        //FIXME facets_edges is likely not needed and quite costly to calculate.
-        // Instead of edge identifiers, one shall use a sorted pair of edge vertex indices.
-        // However facets_edges assigns a single edge ID to two triangles only, thus when factoring facets_edges out, one will have
-        // to make sure that no code relies on it.
-        std::vector<Vec3i32> face_edge_ids = its_face_edge_ids(mesh);
+        // The facet edges are identified by the sorted pairs of their vertex indices (FacetVertexEdgeIds), thus its_face_edge_ids()
+        // is not calculated for each call. Contrary to its_face_edge_ids(), an edge shared by more than two facets of a non-manifold mesh
+        // gets a single ID. The chaining functions pick any unused line starting at an edge, the same way they do for the lines
+        // starting at a shared vertex.
         if (zs.size() <= 1) {
             // It likely is not worthwile to copy the vertices. Apply the transformation in place.
             if (is_identity(params.trafo)) {
                 lines = slice_make_lines(
                     mesh.vertices, [](const Vec3f &p) { return Vec3f(scaled<float>(p.x()), scaled<float>(p.y()), p.z()); }, 
-                    mesh.indices, face_edge_ids, zs, throw_on_cancel);
+                    mesh.indices, zs, throw_on_cancel);
             } else {
                 // Transform the vertices, scale up in XY, not in Z.
                 Transform3f tf = make_trafo_for_slicing(params.trafo);
-                lines = slice_make_lines(mesh.vertices, [tf](const Vec3f &p) { return tf * p; }, mesh.indices, face_edge_ids, zs, throw_on_cancel);
+                lines = slice_make_lines(mesh.vertices, [tf](const Vec3f &p) { return tf * p; }, mesh.indices, zs, throw_on_cancel);
             }
         } else {
             // Copy and scale vertices in XY, don't scale in Z. Possibly apply the transformation.
             lines = slice_make_lines(
                 transform_mesh_vertices_for_slicing(mesh, params.trafo), 
-                [](const Vec3f &p) { return p; },  mesh.indices, face_edge_ids, zs, throw_on_cancel);
+                [](const Vec3f &p) { return p; },  mesh.indices, zs, throw_on_cancel);
         }
     }
 
@@ -1978,23 +2040,20 @@ Polygons slice_mesh(
             }
         }
 
-        // 3) Calculate face neighbors for just the faces in face_mask.
-        std::vector<Vec3i32> face_edge_ids = its_face_edge_ids(mesh, face_mask);
-
-        // 4) Slice "face_mask" triangles, collect line segments.
+        // 3) Slice "face_mask" triangles, collect line segments.
         // It likely is not worthwile to copy the vertices. Apply the transformation in place.
         if (trafo_identity) {
             lines.emplace_back(slice_make_lines(
                 mesh.vertices, [](const Vec3f &p) { return Vec3f(scaled<float>(p.x()), scaled<float>(p.y()), p.z()); }, 
-                mesh.indices, face_edge_ids, plane_z, [&face_mask](int face_idx) { return face_mask[face_idx]; }));
+                mesh.indices, plane_z, [&face_mask](int face_idx) { return face_mask[face_idx]; }));
         } else {
             // Transform the vertices, scale up in XY, not in Z.
-            lines.emplace_back(slice_make_lines(mesh.vertices, [tf](const Vec3f& p) { return tf * p; }, mesh.indices, face_edge_ids, plane_z,
+            lines.emplace_back(slice_make_lines(mesh.vertices, [tf](const Vec3f& p) { return tf * p; }, mesh.indices, plane_z,
                 [&face_mask](int face_idx) { return face_mask[face_idx]; }));
         }
     }
 
-    // 5) Chain the line segments.
+    // 4) Chain the line segments.
     std::vector<Polygons> layers = make_loops(lines, params, [](){});
     assert(layers.size() == 1);
     return layers.front();
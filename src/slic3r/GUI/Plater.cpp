@@ -14330,9 +14330,11 @@ void Plater::export_stl(bool extended, bool selection_only, bool multi_stls)
         auto csgrange = range(csgmesh);
         if (csg::is_all_positive(csgrange)) {
             mesh = TriangleMesh{csg::csgmesh_merge_positive_parts(csgrange)};
-        } else if (std::get<2>(csg::check_csgmesh_booleans(csgrange)) == csgrange.end()) {
+        } else if (std::vector<MeshBoolean::cgal::CGALMeshPtr> cgalmeshes;
+                   std::get<2>(csg::check_csgmesh_booleans(csgrange, [](auto &) {}, cgalmeshes)) == csgrange.end()) {
             try {
-                auto cgalm = csg::perform_csgmesh_booleans(csgrange);
+                // Reuse the meshes converted by the check.
+                auto cgalm = csg::perform_csgmesh_booleans(csgrange, std::move(cgalmeshes));
                 mesh = MeshBoolean::cgal::cgal_to_triangle_mesh(*cgalm);
             } catch (...) {}
         }
@@ -2689,6 +2689,8 @@ optgroup->append_single_option_line("skirt_loops", "others_settings_skirt#loops"
         optgroup->append_single_option_line("gcode_comments", "others_settings_g_code_output#verbose-g-code");
         optgroup->append_single_option_line("gcode_label_objects", "others_settings_g_code_output#label-objects");
         optgroup->append_single_option_line("exclude_object", "others_settings_g_code_output#exclude-objects");
+        optgroup->append_single_option_line("path_chaining", "others_settings_g_code_output#path-ordering");
+        optgroup->append_single_option_line("path_chaining_improve_passes", "others_settings_g_code_output#path-ordering-improvement-passes");
         option = optgroup->get_option("filename_format");
         // option.opt.full_width = true;
         option.opt.is_code = true;
@@ -7332,6 +7334,7 @@ void TabSLAPrint::build()
 //    optgroup->append_single_option_line("hollowing_min_thickness");
 //    optgroup->append_single_option_line("hollowing_quality");
 //    optgroup->append_single_option_line("hollowing_closing_distance");
+//    optgroup->append_single_option_line("hollowing_max_memory", "sla_settings_hollowing#memory-limit");
 //
 //    page = add_options_page(L("Advanced"), "advanced");
 //    optgroup = page->new_optgroup(L("Slicing"));
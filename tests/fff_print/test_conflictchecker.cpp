@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/libslic3r.h"
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Print.hpp"
+#include "libslic3r/GCode/ConflictChecker.hpp"
+
+using namespace Slic3r;
+
+// The conflict of the lowest layer as found by checking the layers one after another.
+static std::optional<float> lowest_conflict_serial(PrintObjectPtrs objs)
+{
+    LinesBucketQueue queue;
+    for (PrintObject *obj : objs) {
+        ObjectExtrusions layers = getAllLayersExtrusionPathsFromObject(obj);
+        queue.emplace_back_bucket(std::move(layers.perimeters), obj, obj->instances().front().shift);
+        queue.emplace_back_bucket(std::move(layers.support), obj, obj->instances().front().shift);
+    }
+    while (queue.valid()) {
+        LineWithIDs lines    = queue.getCurLines();
+        float       bottom_z = queue.getCurrBottomZ();
+        if (ConflictChecker::find_inter_of_lines(lines))
+            return bottom_z;
+    }
+    return {};
+}
+
+SCENARIO("ConflictChecker reports the lowest layer with a conflict", "[ConflictChecker]") {
+    GIVEN("A 20mm cube and a slab from 10mm to 15mm on a pillar, reaching into the cube") {
+        indexed_triangle_set slab = its_make_cube(40., 20., 5.);
+        its_translate(slab, Vec3f(10.f, 0.f, 10.f));
+        indexed_triangle_set pillar = its_make_cube(5., 5., 15.);
+        its_translate(pillar, Vec3f(40.f, 0.f, 0.f));
+        its_merge(slab, pillar);
+
+        Model model;
+        auto add_object = [&model](const char *name, indexed_triangle_set &&its) {
+            ModelObject *object = model.add_object();
+            object->name = name;
+            object->add_volume(TriangleMesh(std::move(its)));
+            object->add_instance()->set_offset(Vec3d(100., 100., 0.));
+        };
+        add_object("cube", its_make_cube(20., 20., 20.));
+        add_object("slab", std::move(slab));
+
+        DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "layer_height", 0.2 }, { "initial_layer_print_height", 0.2 }, { "sparse_infill_density", 0 } });
+        Print print;
+        for (ModelObject *mo : model.objects)
+            print.auto_assign_extruders(mo);
+        print.apply(model, config);
+        print.set_status_silent();
+        print.process();
+
+        WHEN("The objects are checked for conflicts") {
+            ConflictResultOpt conflict = ConflictChecker::find_inter_of_lines_in_diff_objs(print.objects_mutable(), {});
+            THEN("The conflict is reported at the bottom of the slab, as by checking the layers one by one") {
+                REQUIRE(conflict.has_value());
+                std::optional<float> expected = lowest_conflict_serial(print.objects_mutable());
+                REQUIRE(expected.has_value());
+                REQUIRE(conflict->_height == Approx(*expected));
+                REQUIRE(conflict->_height == Approx(10.).margin(0.4));
+            }
+        }
+    }
+}
@@ -5,8 +5,11 @@
 
 #include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/Fill/Fill.hpp"
+#include "libslic3r/Fill/Lightning/Generator.hpp"
+#include "libslic3r/Fill/Lightning/TreeNode.hpp"
 #include "libslic3r/Flow.hpp"
 #include "libslic3r/Geometry.hpp"
+#include "libslic3r/Layer.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/SVG.hpp"
 #include "libslic3r/libslic3r.h"
@@ -190,6 +193,73 @@ TEST_CASE("Fill: Pattern Path Length", "[Fill]") {
     }
 }
 
+// Branches of the lightning trees of a layer.
+static Lines lightning_branches(const FillLightning::Layer &layer)
+{
+    Lines out;
+    for (const FillLightning::NodeSPtr &root : layer.tree_roots)
+        root->visitBranches([&out](const Point &a, const Point &b) { out.emplace_back(a, b); });
+    return out;
+}
+
+SCENARIO("Lightning infill supports the overhangs of every island", "[Fill]") {
+    GIVEN("An object of two 20mm cubes 20mm apart, thus two islands on each layer") {
+        indexed_triangle_set its = its_make_cube(20., 20., 20.);
+        indexed_triangle_set its2 = its_make_cube(20., 20., 20.);
+        its_translate(its2, Vec3f(40.f, 0.f, 0.f));
+        its_merge(its, its2);
+
+        Print print;
+        Model model;
+        Test::init_print({ TriangleMesh(std::move(its)) }, print, model, {
+            { "sparse_infill_pattern",  "lightning" },
+            { "sparse_infill_density",  "20%" },
+            { "layer_height",           0.2 },
+            { "top_shell_layers",       3 },
+            { "bottom_shell_layers",    3 }
+        });
+        print.process();
+        const PrintObject &object = *print.objects().front();
+
+        WHEN("The lightning trees are generated twice") {
+            FillLightning::Generator generator(object, []{});
+            FillLightning::Generator generator2(object, []{});
+            THEN("The trees are the same, as the islands grown in parallel do not interact") {
+                for (size_t layer_id = 0; layer_id < object.layer_count(); ++ layer_id)
+                    REQUIRE(lightning_branches(generator.getTreesForLayer(layer_id)) == lightning_branches(generator2.getTreesForLayer(layer_id)));
+            }
+            THEN("Every overhang is within the supporting radius of a branch grown on its island") {
+                const double supporting_radius = generator.infilll_extrusion_width() * 100. / 20.;
+                size_t num_supported_layers = 0;
+                for (size_t layer_id = 0; layer_id < object.layer_count(); ++ layer_id) {
+                    const Polygons &overhang = generator.Overhangs()[layer_id];
+                    if (overhang.empty())
+                        continue;
+                    const Lines branches = lightning_branches(generator.getTreesForLayer(layer_id));
+                    REQUIRE(! branches.empty());
+                    // Both islands have their own trees.
+                    const coord_t split_x = get_extents(object.get_layer(int(layer_id))->lslices).center().x();
+                    REQUIRE(std::any_of(branches.begin(), branches.end(), [split_x](const Line &l) { return l.a.x() < split_x; }));
+                    REQUIRE(std::any_of(branches.begin(), branches.end(), [split_x](const Line &l) { return l.a.x() > split_x; }));
+                    // Sample the overhang and check that each sample is supported, allowing for the sampling grid of the distance field.
+                    const BoundingBox bbox = get_extents(overhang);
+                    const coord_t     step = coord_t(supporting_radius / 2.);
+                    for (coord_t y = bbox.min.y(); y <= bbox.max.y(); y += step)
+                        for (coord_t x = bbox.min.x(); x <= bbox.max.x(); x += step)
+                            if (Point pt(x, y); std::any_of(overhang.begin(), overhang.end(), [&pt](const Polygon &p) { return p.contains(pt); })) {
+                                double d2 = std::numeric_limits<double>::max();
+                                for (const Line &branch : branches)
+                                    d2 = std::min(d2, line_alg::distance_to_squared(branch, pt));
+                                REQUIRE(std::sqrt(d2) < 1.5 * supporting_radius);
+                            }
+                    ++ num_supported_layers;
+                }
+                REQUIRE(num_supported_layers > 0);
+            }
+        }
+    }
+}
+
 /*
 {
     my $collection = Slic3r::Polyline::Collection->new(
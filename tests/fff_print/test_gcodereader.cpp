@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include "libslic3r/GCodeReader.hpp"
+
+using namespace Slic3r;
+
+// parse_file() reads the file in blocks of 1MB.
+static constexpr const size_t gcode_reader_block_size = 1024 * 1024;
+
+struct ParsedLine
+{
+    std::string raw;
+    float       x, y, e;
+
+    bool operator==(const ParsedLine &rhs) const { return raw == rhs.raw && x == rhs.x && y == rhs.y && e == rhs.e; }
+};
+
+// G-code of a few MB with lines of varying length, so that the lines are split between the blocks read by parse_file().
+// The line end of the first line starts at the last byte of the first block, thus with "\r\n" line ends the block ends
+// between '\r' and '\n'.
+static std::string make_gcode(const char *eol)
+{
+    std::string gcode = ";" + std::string(gcode_reader_block_size - 2, 'a') + eol;
+    for (size_t i = 0; gcode.size() < 3 * gcode_reader_block_size; ++ i) {
+        gcode += "G1 X" + std::to_string(i % 1000) + ".25 Y" + std::to_string(i % 777) + ".5 E0.0" + std::to_string(i % 10);
+        if (i % 7 == 0)
+            gcode += " ; comment " + std::string(i % 100, 'c');
+        gcode += eol;
+    }
+    // The last line is not terminated.
+    gcode += "G1 X1 Y2";
+    return gcode;
+}
+
+static std::vector<ParsedLine> parse_buffer(const std::string &gcode)
+{
+    std::vector<ParsedLine> out;
+    GCodeReader reader;
+    reader.parse_buffer(gcode, [&out](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+        out.push_back({ line.raw(), reader.x(), reader.y(), reader.e() });
+    });
+    return out;
+}
+
+static boost::filesystem::path write_gcode_file(const std::string &gcode)
+{
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.gcode");
+    FILE *f = boost::nowide::fopen(path.string().c_str(), "wb");
+    REQUIRE(f != nullptr);
+    REQUIRE(fwrite(gcode.data(), 1, gcode.size(), f) == gcode.size());
+    fclose(f);
+    return path;
+}
+
+static std::vector<ParsedLine> parse_file(const std::string &gcode, std::vector<size_t> &lines_ends)
+{
+    boost::filesystem::path path = write_gcode_file(gcode);
+
+    std::vector<ParsedLine> out;
+    GCodeReader reader;
+    bool ok = reader.parse_file(path.string(), [&out](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+        out.push_back({ line.raw(), reader.x(), reader.y(), reader.e() });
+    }, lines_ends);
+    boost::filesystem::remove(path);
+    REQUIRE(ok);
+    return out;
+}
+
+static std::vector<size_t> positions_after_lf(const std::string &gcode)
+{
+    std::vector<size_t> out;
+    for (size_t i = 0; i < gcode.size(); ++ i)
+        if (gcode[i] == '\n')
+            out.emplace_back(i + 1);
+    return out;
+}
+
+TEST_CASE("GCodeReader::parse_file() matches parse_buffer()", "[GCodeReader]") {
+    for (const char *eol : { "\n", "\r\n", "\r" }) {
+        SECTION(eol[0] == '\n' ? "LF" : eol[1] == '\n' ? "CRLF" : "CR") {
+            std::string         gcode     = make_gcode(eol);
+            REQUIRE(gcode[gcode_reader_block_size - 1] == eol[0]);
+            std::vector<size_t> lines_ends;
+            std::vector<ParsedLine> lines = parse_file(gcode, lines_ends);
+            std::vector<ParsedLine> expected = parse_buffer(gcode);
+            REQUIRE(lines.size() == expected.size());
+            REQUIRE(lines.front().raw.size() == gcode_reader_block_size - 1);
+            REQUIRE(lines.back().raw == "G1 X1 Y2");
+            REQUIRE(lines == expected);
+            REQUIRE(lines_ends == positions_after_lf(gcode));
+        }
+    }
+}
+
+TEST_CASE("GCodeReader::parse_file() stops when asked to", "[GCodeReader]") {
+    boost::filesystem::path path = write_gcode_file(make_gcode("\n"));
+
+    size_t num_lines = 0;
+    std::vector<size_t> lines_ends;
+    GCodeReader reader;
+    bool ok = reader.parse_file(path.string(), [&num_lines](GCodeReader &reader, const GCodeReader::GCodeLine &) {
+        if (++ num_lines == 10)
+            reader.quit_parsing();
+    }, lines_ends);
+    boost::filesystem::remove(path);
+    REQUIRE(ok);
+    REQUIRE(num_lines == 10);
+    // The end of the line, at which the parsing was stopped, is not reported.
+    REQUIRE(lines_ends.size() == 9);
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 
+#include <iomanip>
 #include <memory>
+#include <sstream>
 
 #include "libslic3r/GCodeWriter.hpp"
 
@@ -94,3 +96,103 @@ SCENARIO("set_speed emits values with fixed-point output.", "[GCodeWriter]") {
         }
     }
 }
+
+SCENARIO("Commands formatted without iostreams match the stream formatting.", "[GCodeWriter]") {
+
+    GIVEN("GCodeWriter instance") {
+        GCodeWriter writer;
+        WHEN("fan speed is set") {
+            THEN("Output is formatted as an integer PWM value") {
+                REQUIRE_THAT(GCodeWriter::set_fan(gcfMarlinLegacy, 0), Catch::Equals("M106 S0 ; disable fan\n"));
+                REQUIRE_THAT(GCodeWriter::set_fan(gcfMach3, 50), Catch::Equals("M106 P127 ; enable fan\n"));
+            }
+        }
+        WHEN("nozzle temperature is set") {
+            THEN("Output contains the temperature and tool index") {
+                REQUIRE_THAT(GCodeWriter::set_temperature(215, gcfMarlinLegacy, false, 1), Catch::Equals("M104 S215 T1 ; set nozzle temperature\n"));
+                REQUIRE_THAT(GCodeWriter::set_temperature(215, gcfRepRapFirmware, true, 1),
+                    Catch::Equals("G10 S215 P1 ; set nozzle temperature\nM116 ; wait for temperature to be reached\n"));
+            }
+        }
+        WHEN("pressure advance and input shaping are set for Klipper") {
+            writer.config.gcode_flavor.value = gcfKlipper;
+            THEN("Floating point values keep the stream precision") {
+                REQUIRE_THAT(writer.set_pressure_advance(0.043216), Catch::Equals("SET_PRESSURE_ADVANCE ADVANCE=0.04322; Override pressure advance value\n"));
+                REQUIRE_THAT(writer.set_input_shaping('X', 0.1f, 50.f, "mzv"),
+                    Catch::Equals("SET_INPUT_SHAPER SHAPER_TYPE=mzv SHAPER_FREQ_X=50.00 DAMPING_RATIO_X=0.100 ; Override input shaping\n"));
+                REQUIRE_THAT(writer.set_jerk_xy(7.5), Catch::Equals("SET_VELOCITY_LIMIT SQUARE_CORNER_VELOCITY=7.5 ; adjust jerk\n"));
+            }
+        }
+    }
+}
+
+SCENARIO("GCodeFormatter does not overflow its buffer.", "[GCodeWriter]") {
+    GIVEN("A comment longer than the formatter buffer") {
+        const std::string comment(1000, 'c');
+        WHEN("it is appended to a move") {
+            GCodeG1Formatter w;
+            w.emit_xy(Vec2d(1., 2.));
+            w.emit_comment(true, comment);
+            THEN("The whole comment is emitted") {
+                REQUIRE(w.string() == "G1 X1 Y2 ; " + comment + "\n");
+            }
+        }
+        WHEN("it is followed by more parameters") {
+            GCodeFormatter w;
+            for (int i = 0; i < 100; ++ i) {
+                w.emit_string(" P");
+                w.emit_int(i);
+            }
+            w.emit_fixed(1e300, 2);
+            w.emit_comment(true, comment.c_str());
+            THEN("All the text is emitted in order") {
+                std::ostringstream expected;
+                for (int i = 0; i < 100; ++ i)
+                    expected << " P" << i;
+                expected << std::fixed << std::setprecision(2) << 1e300 << " ; " << comment << "\n";
+                REQUIRE(w.string() == expected.str());
+            }
+        }
+    }
+}
+
+// GCodeWriter::set_acceleration_internal() as it was implemented with std::ostringstream, kept for comparison.
+static std::string set_acceleration_ostringstream(unsigned int acceleration)
+{
+    std::ostringstream gcode;
+    gcode << "M204 S" << acceleration;
+    if (GCodeWriter::full_gcode_comment) gcode << " ; adjust acceleration";
+    gcode << "\n";
+    return gcode.str();
+}
+
+TEST_CASE("Benchmark G-code emission of 1M moves", "[GCodeWriter][.benchmark]") {
+    GCodeWriter writer;
+    writer.config.load(std::string(TEST_DATA_DIR) + "/fff_print_tests/test_gcodewriter/config_lift_unlift.ini", ForwardCompatibilitySubstitutionRule::Disable);
+    writer.set_extruders({ 0 });
+    writer.set_extruder(0);
+
+    static constexpr size_t num_moves = 1000000;
+    // Acceleration changes every few moves, as with different accelerations per extrusion role.
+    static constexpr size_t moves_per_feature = 8;
+
+    BENCHMARK("GCodeWriter") {
+        std::string gcode;
+        for (size_t i = 0; i < num_moves; ++ i) {
+            if (i % moves_per_feature == 0)
+                gcode += writer.set_print_acceleration((i / moves_per_feature) % 2 ? 3000 : 5000);
+            gcode += writer.extrude_to_xy(Vec2d(double(i % 1000) * 0.1, double(i % 777) * 0.1), 0.01);
+        }
+        return gcode.size();
+    };
+
+    BENCHMARK("GCodeWriter with std::ostringstream commands") {
+        std::string gcode;
+        for (size_t i = 0; i < num_moves; ++ i) {
+            if (i % moves_per_feature == 0)
+                gcode += set_acceleration_ostringstream((i / moves_per_feature) % 2 ? 3000 : 5000);
+            gcode += writer.extrude_to_xy(Vec2d(double(i % 1000) * 0.1, double(i % 777) * 0.1), 0.01);
+        }
+        return gcode.size();
+    };
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <test_utils.hpp>
+
+#include "libslic3r/ExtrusionEntityCollection.hpp"
+#include "libslic3r/Flow.hpp"
+#include "libslic3r/PerimeterGenerator.hpp"
+#include "libslic3r/PrintConfig.hpp"
+#include "libslic3r/SurfaceCollection.hpp"
+#include "libslic3r/TriangleMeshSlicer.hpp"
+
+using namespace Slic3r;
+
+// Slices of a model of the test data directory, the model is scaled up to get more work per layer.
+static std::vector<ExPolygons> slice_test_model(const std::string &obj_filename, const double scale, const float layer_height)
+{
+    TriangleMesh mesh = load_model(obj_filename);
+    mesh.scale(float(scale));
+    mesh.translate(0.f, 0.f, - mesh.bounding_box().min.z());
+    std::vector<float> zs;
+    for (float z = 0.5f * layer_height; z < float(mesh.bounding_box().max.z()); z += layer_height)
+        zs.emplace_back(z);
+    return slice_mesh_ex(mesh.its, zs);
+}
+
+// Generate perimeters of all the layers, return the number of extrusions generated.
+static size_t generate_perimeters(const std::vector<ExPolygons> &layers, const PrintRegionConfig &region_config, const PrintObjectConfig &object_config,
+    const PrintConfig &print_config, const float layer_height, const bool arachne)
+{
+    const Flow flow(0.45f, layer_height, 0.4f);
+    size_t     num_extrusions = 0;
+    for (size_t layer_id = 0; layer_id < layers.size(); ++ layer_id) {
+        SurfaceCollection         slices;
+        surfaces_append(slices.surfaces, layers[layer_id], stInternal);
+        ExtrusionEntityCollection loops;
+        ExtrusionEntityCollection gap_fill;
+        SurfaceCollection         fill_surfaces;
+        ExPolygons                fill_no_overlap;
+        PerimeterGenerator        perimeter_generator(&slices, nullptr, layer_height, layer_height * (layer_id + 0.5), flow,
+            &region_config, &object_config, &print_config, false, &loops, &gap_fill, &fill_surfaces, &fill_no_overlap);
+        perimeter_generator.layer_id     = int(layer_id);
+        perimeter_generator.lower_slices = layer_id > 0 ? &layers[layer_id - 1] : nullptr;
+        perimeter_generator.upper_slices = layer_id + 1 < layers.size() ? &layers[layer_id + 1] : nullptr;
+        if (arachne)
+            perimeter_generator.process_arachne();
+        else
+            perimeter_generator.process_classic();
+        num_extrusions += loops.entities.size() + gap_fill.entities.size();
+    }
+    return num_extrusions;
+}
+
+TEST_CASE("Benchmark perimeter generation", "[Perimeters][.benchmark]") {
+    const float                   layer_height = 0.2f;
+    const std::vector<ExPolygons> idler        = slice_test_model("extruder_idler.obj", 2., layer_height);
+    const std::vector<ExPolygons> frog_legs    = slice_test_model("frog_legs.obj", 1., layer_height);
+    REQUIRE(! idler.empty());
+    REQUIRE(! frog_legs.empty());
+
+    PrintRegionConfig region_config;
+    region_config.wall_loops.value = 3;
+    PrintObjectConfig object_config;
+    PrintConfig       print_config;
+
+    BENCHMARK("process_classic") {
+        return generate_perimeters(idler, region_config, object_config, print_config, layer_height, false) +
+               generate_perimeters(frog_legs, region_config, object_config, print_config, layer_height, false);
+    };
+    BENCHMARK("process_arachne") {
+        return generate_perimeters(idler, region_config, object_config, print_config, layer_height, true) +
+               generate_perimeters(frog_legs, region_config, object_config, print_config, layer_height, true);
+    };
+}
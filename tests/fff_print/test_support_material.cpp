@@ -2,11 +2,14 @@
 
 #include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Layer.hpp"
+#include "libslic3r/BuildVolume.hpp"
+#include "libslic3r/Support/TreeModelVolumes.hpp"
 
 #include "test_data.hpp" // get access to init_print, etc
 
 using namespace Slic3r::Test;
 using namespace Slic3r;
+using namespace Slic3r::TreeSupport3D;
 
 TEST_CASE("SupportMaterial: Three raft layers created", "[SupportMaterial]")
 {
@@ -119,6 +122,38 @@ SCENARIO("SupportMaterial: support_layers_z and contact_distance", "[SupportMate
     }
 }
 
+TEST_CASE("SupportMaterial: tree support caches are released down to the memory budget", "[SupportMaterial]")
+{
+    Slic3r::Print print;
+    Slic3r::Test::init_and_process_print({ TestMesh::cube_with_hole }, print, {});
+    const PrintObject &object = *print.objects().front();
+    const BuildVolume build_volume{ { { 0., 0. }, { 250., 0. }, { 250., 250. }, { 0., 250. } }, 250., {}, {} };
+    TreeModelVolumes volumes{ object, build_volume, scaled<coord_t>(5.), scaled<coord_t>(1.), 0 };
+    const LayerIndex max_layer = LayerIndex(object.layer_count()) - 1;
+    volumes.precalculate(object, max_layer, [](){});
+
+    // precalculate() fills the caches regardless of the budget, the budget is applied while the layers are released top down.
+    const size_t peak   = volumes.cache_memory_size();
+    REQUIRE(peak > 0);
+    const size_t budget = peak / 2;
+    const Polygons avoidance_top = volumes.getAvoidance(0, max_layer, TreeModelVolumes::AvoidanceType::Fast, false, false);
+    size_t last = peak;
+    for (LayerIndex layer_idx = max_layer; layer_idx >= 0; -- layer_idx) {
+        volumes.release_caches_above(layer_idx, budget);
+        const size_t size = volumes.cache_memory_size();
+        CHECK(size <= last);
+        if (size > budget) {
+            // Over the budget, the caches only hold the layers still needed and the collisions, which are never released.
+            volumes.release_caches_above(layer_idx, 0);
+            CHECK(volumes.cache_memory_size() == size);
+        }
+        last = size;
+    }
+    CHECK(last < peak);
+    // The released areas are calculated again on request.
+    CHECK(volumes.getAvoidance(0, max_layer, TreeModelVolumes::AvoidanceType::Fast, false, false) == avoidance_top);
+}
+
 #if 0
 // Test 8.
 TEST_CASE("SupportMaterial: forced support is generated", "[SupportMaterial]")
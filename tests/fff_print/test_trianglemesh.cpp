@@ -13,6 +13,7 @@
 
 //#include "test_options.hpp"
 #include "test_data.hpp"
+#include <test_utils.hpp>
 
 using namespace Slic3r;
 using namespace std;
@@ -301,6 +302,103 @@ SCENARIO( "TriangleMeshSlicer: Cut behavior.") {
         }
     }
 }
+
+// Model of the test data directory scaled up, with its bounding box starting at the origin.
+static TriangleMesh scaled_test_model(const std::string &obj_filename, const float scale)
+{
+    TriangleMesh mesh = load_model(obj_filename);
+    mesh.scale(scale);
+    mesh.translate(- mesh.bounding_box().min.cast<float>());
+    return mesh;
+}
+
+// Copies of models of the test data directory scaled up and placed next to each other, to get a mesh with many facets.
+static indexed_triangle_set scaled_test_models(const std::vector<std::string> &obj_filenames, const float scale, const int copies)
+{
+    indexed_triangle_set out;
+    float                x = 0.f;
+    for (const std::string &obj_filename : obj_filenames) {
+        TriangleMesh mesh = scaled_test_model(obj_filename, scale);
+        const float size_x = float(mesh.bounding_box().size().x()) + 1.f;
+        mesh.translate(x, 0.f, 0.f);
+        for (int i = 0; i < copies; ++ i) {
+            its_merge(out, mesh.its);
+            mesh.translate(size_x, 0.f, 0.f);
+            x += size_x;
+        }
+    }
+    return out;
+}
+
+static std::vector<float> slicing_zs(const indexed_triangle_set &its, const float layer_height)
+{
+    std::vector<float> zs;
+    const float        max_z = float(bounding_box(its).max.z());
+    for (float z = 0.5f * layer_height; z < max_z; z += layer_height)
+        zs.emplace_back(z);
+    return zs;
+}
+
+TEST_CASE("Slicing is deterministic", "[TriangleMeshSlicer]") {
+    const std::vector<std::string> obj_filenames { "extruder_idler.obj", "frog_legs.obj" };
+    const int                      copies = 4;
+    const indexed_triangle_set its = scaled_test_models(obj_filenames, 1.f, copies);
+    const std::vector<float>   zs  = slicing_zs(its, 0.2f);
+    const std::vector<Polygons> slices1 = slice_mesh(its, zs, MeshSlicingParams());
+    const std::vector<Polygons> slices2 = slice_mesh(its, zs, MeshSlicingParams());
+    REQUIRE(slices1.size() == zs.size());
+    REQUIRE(slices1 == slices2);
+
+    // Reference independent of the order in which the facets are sliced and the loops are chained:
+    // each slice of the copies has the polygons and the area of the slice of a single copy of each model, times the number of copies.
+    std::vector<size_t> num_polygons(zs.size(), 0);
+    std::vector<double> areas(zs.size(), 0.);
+    for (const std::string &obj_filename : obj_filenames) {
+        const std::vector<Polygons> slices = slice_mesh(scaled_test_model(obj_filename, 1.f).its, zs, MeshSlicingParams());
+        for (size_t i = 0; i < zs.size(); ++ i) {
+            num_polygons[i] += copies * slices[i].size();
+            areas[i]        += copies * area(slices[i]);
+        }
+    }
+    size_t num_polygons_total = 0;
+    for (size_t i = 0; i < zs.size(); ++ i) {
+        REQUIRE(slices1[i].size() == num_polygons[i]);
+        REQUIRE(area(slices1[i]) == Approx(areas[i]).epsilon(1e-4));
+        num_polygons_total += slices1[i].size();
+    }
+    REQUIRE(num_polygons_total > 0);
+}
+
+TEST_CASE("Slicing a mesh with an edge shared by four facets", "[TriangleMeshSlicer]") {
+    // Two cubes touching along a vertical edge, the vertices of the edge are merged.
+    indexed_triangle_set its = its_make_cube(20., 20., 20.);
+    indexed_triangle_set cube2 = its_make_cube(20., 20., 20.);
+    its_translate(cube2, Vec3f(20.f, 20.f, 0.f));
+    its_merge(its, cube2);
+    its_merge_vertices(its);
+    const std::vector<ExPolygons> slices = slice_mesh_ex(its, { 5.f, 10.f, 15.f }, MeshSlicingParamsEx());
+    REQUIRE(slices.size() == 3);
+    for (const ExPolygons &slice : slices) {
+        double area = 0.;
+        for (const ExPolygon &expoly : slice)
+            area += expoly.area();
+        REQUIRE(area == Approx(2. * 20. * 20. / sqr(SCALING_FACTOR)));
+    }
+}
+
+TEST_CASE("Benchmark slicing of scaled up test models", "[TriangleMeshSlicer][.benchmark]") {
+    const indexed_triangle_set its = scaled_test_models({ "extruder_idler.obj", "frog_legs.obj", "ipadstand.obj", "bridge.obj" }, 4.f, 8);
+    const std::vector<float>   zs  = slicing_zs(its, 0.05f);
+    REQUIRE(! zs.empty());
+
+    BENCHMARK("slice_mesh") {
+        return slice_mesh(its, zs, MeshSlicingParams()).size();
+    };
+    BENCHMARK("slice_mesh_ex") {
+        return slice_mesh_ex(its, zs, MeshSlicingParamsEx()).size();
+    };
+}
+
 #ifdef TEST_PERFORMANCE
 TEST_CASE("Regression test for issue #4486 - files take forever to slice") {
     TriangleMesh mesh;
@@ -4,6 +4,9 @@
 #include <libslic3r/TriangleMesh.hpp>
 #include <libslic3r/AABBTreeIndirect.hpp>
 
+#include <algorithm>
+#include <random>
+
 using namespace Slic3r;
 
 TEST_CASE("Building a tree over a box, ray caster and closest query", "[AABBIndirect]")
@@ -58,3 +61,72 @@ TEST_CASE("Building a tree over a box, ray caster and closest query", "[AABBIndi
     REQUIRE(closest_point.y() == Approx(0.5));
     REQUIRE(closest_point.z() == Approx(1.));
 }
+
+template<typename VectorType>
+static void check_ray_packets(const indexed_triangle_set &its, size_t num_rays)
+{
+    using Scalar = typename VectorType::Scalar;
+    auto tree = AABBTreeIndirect::build_aabb_tree_over_indexed_triangle_set(its.vertices, its.indices);
+
+    // Random rays from around the mesh, a part of them parallel to the coordinate axes or planes.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<Scalar> coord(-15., 15.);
+    std::vector<VectorType> origins, dirs;
+    for (size_t i = 0; i < num_rays; ++ i) {
+        origins.emplace_back(coord(rng), coord(rng), coord(rng));
+        VectorType dir(coord(rng), coord(rng), coord(rng));
+        if (i % 5 == 0)
+            dir[i % 3] = 0;
+        if (i % 7 == 0)
+            dir[(i + 1) % 3] = 0;
+        dirs.emplace_back(dir.normalized());
+    }
+
+    std::vector<igl::Hit> first_hits;
+    size_t num_first_hits = AABBTreeIndirect::intersect_rays_first_hit(its.vertices, its.indices, tree, origins, dirs, first_hits);
+    std::vector<std::vector<igl::Hit>> all_hits;
+    size_t num_all_hits = AABBTreeIndirect::intersect_rays_all_hits(its.vertices, its.indices, tree, origins, dirs, all_hits);
+    REQUIRE(first_hits.size() == num_rays);
+    REQUIRE(all_hits.size() == num_rays);
+
+    auto hit_less = [](const igl::Hit &l, const igl::Hit &r) { return l.t < r.t || (l.t == r.t && l.id < r.id); };
+    size_t num_hit = 0;
+    for (size_t i = 0; i < num_rays; ++ i) {
+        igl::Hit hit;
+        bool     intersected = AABBTreeIndirect::intersect_ray_first_hit(its.vertices, its.indices, tree, origins[i], dirs[i], hit);
+        REQUIRE(intersected == (first_hits[i].id != -1));
+        if (intersected) {
+            ++ num_hit;
+            // A ray passing through an edge hits two triangles at the same parameter, either one may be returned.
+            REQUIRE(first_hits[i].t == hit.t);
+        }
+
+        std::vector<igl::Hit> hits;
+        AABBTreeIndirect::intersect_ray_all_hits(its.vertices, its.indices, tree, origins[i], dirs[i], hits);
+        std::vector<igl::Hit> packet_hits = all_hits[i];
+        std::sort(hits.begin(), hits.end(), hit_less);
+        std::sort(packet_hits.begin(), packet_hits.end(), hit_less);
+        REQUIRE(packet_hits.size() == hits.size());
+        for (size_t j = 0; j < hits.size(); ++ j) {
+            REQUIRE(packet_hits[j].id == hits[j].id);
+            REQUIRE(packet_hits[j].t == hits[j].t);
+        }
+    }
+    REQUIRE(num_first_hits == num_hit);
+    REQUIRE(num_all_hits == num_hit);
+    // Make sure the test is not trivial.
+    REQUIRE(num_hit > num_rays / 10);
+    REQUIRE(num_hit < num_rays);
+}
+
+TEST_CASE("Ray packets hit the same triangles as single rays", "[AABBIndirect]")
+{
+    // A number of rays not divisible by the packet size, so that the last packet is partially filled.
+    indexed_triangle_set sphere = its_make_sphere(10., 2. * PI / 40.);
+    SECTION("double precision rays") {
+        check_ray_packets<Vec3d>(sphere, 1003);
+    }
+    SECTION("single precision rays") {
+        check_ray_packets<Vec3f>(sphere, 1003);
+    }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/Arachne/WallToolPaths.hpp"
+#include "libslic3r/ClipperUtils.hpp"
+
+using namespace Slic3r;
+
+// A grid of islands: squares with a round hole, bars of varying width and stars, so that the walls
+// have transitions between wall counts, odd walls and gap fills.
+static Polygons make_islands(size_t cols, size_t rows)
+{
+    Polygons out;
+    for (size_t row = 0; row < rows; ++ row)
+        for (size_t col = 0; col < cols; ++ col) {
+            const Point origin = Point::new_scale(12. * double(col), 12. * double(row));
+            Polygons island;
+            switch ((row * cols + col) % 3) {
+            case 0: {
+                Polygon square = Polygon::new_scale({ { 0., 0. }, { 10., 0. }, { 10., 10. }, { 0., 10. } });
+                Polygon hole;
+                for (size_t i = 0; i < 64; ++ i) {
+                    const double angle = 2. * PI * double(i) / 64.;
+                    hole.points.emplace_back(Point::new_scale(5. + (2. + 0.1 * double(col % 5)) * cos(angle), 5. + 2. * sin(angle)));
+                }
+                hole.reverse();
+                island = { std::move(square), std::move(hole) };
+                break;
+            }
+            case 1:
+                // A bar getting thinner towards its end.
+                island = { Polygon::new_scale({ { 0., 0. }, { 10., 0. }, { 10., 0.6 + 0.1 * double(row % 4) }, { 0., 4. } }) };
+                break;
+            default: {
+                Polygon star;
+                for (size_t i = 0; i < 20; ++ i) {
+                    const double angle = 2. * PI * double(i) / 20.;
+                    const double radius = i % 2 ? 2. : 5.;
+                    star.points.emplace_back(Point::new_scale(5. + radius * cos(angle), 5. + radius * sin(angle)));
+                }
+                island = { std::move(star) };
+                break;
+            }
+            }
+            for (Polygon &polygon : island) {
+                polygon.translate(origin);
+                out.emplace_back(std::move(polygon));
+            }
+        }
+    return union_(out);
+}
+
+static std::vector<Arachne::VariableWidthLines> generate_walls(const Polygons &outline, bool split_islands)
+{
+    const double nozzle_diameter = 0.4;
+    Arachne::WallToolPathsParams params;
+    params.min_bead_width                   = float(0.85 * nozzle_diameter);
+    params.min_feature_size                 = float(0.25 * nozzle_diameter);
+    params.min_length_factor                = 0.5f;
+    params.wall_transition_length           = float(1.0 * nozzle_diameter);
+    params.wall_transition_angle            = 10.f;
+    params.wall_transition_filter_deviation = float(0.25 * nozzle_diameter);
+    params.wall_distribution_count          = 1;
+    params.is_top_or_bottom_layer           = false;
+    params.split_islands                    = split_islands;
+    const coord_t bead_width = scaled<coord_t>(0.45);
+    Arachne::WallToolPaths wall_tool_paths(outline, bead_width, bead_width, 3, 0, 0.2, params);
+    return wall_tool_paths.getToolPaths();
+}
+
+struct InsetStats
+{
+    size_t num_lines        { 0 };
+    size_t num_closed       { 0 };
+    size_t num_odd          { 0 };
+    double length           { 0. };
+    // Sum of the segment lengths multiplied by the average width of the segment.
+    double extruded_area    { 0. };
+};
+
+static std::vector<InsetStats> inset_stats(const std::vector<Arachne::VariableWidthLines> &toolpaths)
+{
+    std::vector<InsetStats> out(toolpaths.size());
+    for (size_t inset_idx = 0; inset_idx < toolpaths.size(); ++ inset_idx)
+        for (const Arachne::ExtrusionLine &line : toolpaths[inset_idx]) {
+            InsetStats &stats = out[inset_idx];
+            ++ stats.num_lines;
+            stats.num_closed += line.is_closed;
+            stats.num_odd    += line.is_odd;
+            for (size_t i = 1; i < line.size(); ++ i) {
+                const double length = (line[i].p - line[i - 1].p).cast<double>().norm();
+                stats.length        += length;
+                stats.extruded_area += length * 0.5 * double(line[i].w + line[i - 1].w);
+            }
+        }
+    return out;
+}
+
+TEST_CASE("Arachne walls generated per island match the walls of the whole outline", "[Arachne]") {
+    const Polygons outline = make_islands(6, 6);
+    REQUIRE(outline.size() > 36);
+
+    const std::vector<InsetStats> per_island = inset_stats(generate_walls(outline, true));
+    const std::vector<InsetStats> whole      = inset_stats(generate_walls(outline, false));
+
+    // Each island has its own Voronoi diagram, which is traversed in a different order than the diagram of
+    // the whole outline. A few junctions differ by rounding, the walls are otherwise the same.
+    REQUIRE(per_island.size() == whole.size());
+    for (size_t inset_idx = 0; inset_idx < whole.size(); ++ inset_idx) {
+        REQUIRE(per_island[inset_idx].num_lines == whole[inset_idx].num_lines);
+        REQUIRE(per_island[inset_idx].num_closed == whole[inset_idx].num_closed);
+        REQUIRE(per_island[inset_idx].num_odd == whole[inset_idx].num_odd);
+        REQUIRE(per_island[inset_idx].length == Approx(whole[inset_idx].length).epsilon(1e-4));
+        REQUIRE(per_island[inset_idx].extruded_area == Approx(whole[inset_idx].extruded_area).epsilon(1e-4));
+    }
+}
+
+TEST_CASE("Arachne walls generated per island are deterministic", "[Arachne]") {
+    const Polygons outline = make_islands(6, 6);
+    const std::vector<Arachne::VariableWidthLines> walls  = generate_walls(outline, true);
+    const std::vector<Arachne::VariableWidthLines> walls2 = generate_walls(outline, true);
+    REQUIRE(walls.size() == walls2.size());
+    for (size_t inset_idx = 0; inset_idx < walls.size(); ++ inset_idx) {
+        REQUIRE(walls[inset_idx].size() == walls2[inset_idx].size());
+        for (size_t line_idx = 0; line_idx < walls[inset_idx].size(); ++ line_idx) {
+            const Arachne::ExtrusionLine &line  = walls[inset_idx][line_idx];
+            const Arachne::ExtrusionLine &line2 = walls2[inset_idx][line_idx];
+            REQUIRE(line.size() == line2.size());
+            for (size_t i = 0; i < line.size(); ++ i) {
+                REQUIRE(line[i].p == line2[i].p);
+                REQUIRE(line[i].w == line2[i].w);
+            }
+        }
+    }
+}
+
+TEST_CASE("Benchmark Arachne walls per island", "[Arachne][.benchmark]") {
+    const Polygons outline = make_islands(20, 20);
+    BENCHMARK("whole outline") {
+        return generate_walls(outline, false).size();
+    };
+    BENCHMARK("per island") {
+        return generate_walls(outline, true).size();
+    };
+}
@@ -299,3 +299,86 @@ TEST_CASE("Traversing Clipper PolyTree", "[ClipperUtils]") {
         REQUIRE(count_polys(output) == reference.size());
     }
 }
+
+// A square with two holes, a narrow strip and a comb with narrow teeth, so that the offsets split and merge regions.
+static ExPolygons make_chain_test_expolygons()
+{
+    ExPolygons expolygons;
+    {
+        ExPolygon square_with_holes(Polygon::new_scale({ { 0, 0 }, { 20, 0 }, { 20, 20 }, { 0, 20 } }));
+        Polygon   hole1 = Polygon::new_scale({ { 3, 3 }, { 3, 8 }, { 8, 8 }, { 8, 3 } });
+        Polygon   hole2 = Polygon::new_scale({ { 8.6, 3 }, { 8.6, 8 }, { 15, 8 }, { 15, 3 } });
+        square_with_holes.holes = { hole1, hole2 };
+        expolygons.emplace_back(std::move(square_with_holes));
+        expolygons.emplace_back(Polygon::new_scale({ { 25, 0 }, { 25.75, 0 }, { 25.75, 20 }, { 25, 20 } }));
+        Points comb = Polygon::new_scale({ { 30, 0 }, { 50, 0 } }).points;
+        for (int i = 9; i >= 0; -- i) {
+            comb.emplace_back(scaled<coord_t>(32. + 2. * i), scaled<coord_t>(2.));
+            comb.emplace_back(scaled<coord_t>(32. + 2. * i), scaled<coord_t>(10.));
+            comb.emplace_back(scaled<coord_t>(31.5 + 2. * i), scaled<coord_t>(10.));
+            comb.emplace_back(scaled<coord_t>(31.5 + 2. * i), scaled<coord_t>(2.));
+        }
+        comb.emplace_back(scaled<coord_t>(30.), scaled<coord_t>(2.));
+        expolygons.emplace_back(Polygon(std::move(comb)));
+    }
+    return expolygons;
+}
+
+TEST_CASE("ClipperChain matches the chained free functions", "[ClipperUtils]") {
+    const ExPolygons expolygons = make_chain_test_expolygons();
+    const float d1 = scaled<float>(0.5);
+    const float d2 = scaled<float>(0.35);
+
+    SECTION("offset2") {
+        REQUIRE(ClipperChain::offset(expolygons, - d1).offset_ex(d2) == offset2_ex(expolygons, - d1, d2));
+        REQUIRE(ClipperChain::offset(expolygons, d1).offset_ex(- d2) == offset2_ex(expolygons, d1, - d2));
+    }
+    SECTION("offset to polygons") {
+        REQUIRE(ClipperChain::offset(expolygons, - d1).polygons() == offset(expolygons, - d1));
+        REQUIRE(ClipperChain::offset(expolygons, d1).polygons() == offset(expolygons, d1));
+    }
+    SECTION("difference of openings") {
+        const ExPolygons expected = diff_ex(opening_ex(expolygons, d2), offset2_ex(expolygons, - d1, d1 + ClipperSafetyOffset));
+        const ExPolygons chained  = ClipperChain::offset(expolygons, - d2).offset(d2).diff_ex(ClipperChain::offset(expolygons, - d1).offset(d1 + ClipperSafetyOffset));
+        REQUIRE(! expected.empty());
+        REQUIRE(chained.size() == expected.size());
+        REQUIRE(area(chained) == Approx(area(expected)));
+    }
+    SECTION("boolean operations") {
+        const ClipperChain shrunk = ClipperChain::offset(expolygons, - d1);
+        const ClipperChain grown  = ClipperChain::offset(expolygons, d2);
+        REQUIRE(ClipperChain(expolygons).diff_ex(shrunk) == diff_ex(expolygons, offset(expolygons, - d1)));
+        REQUIRE(grown.intersection_ex(ClipperChain(expolygons)) == intersection_ex(offset(expolygons, d2), expolygons));
+        REQUIRE(area(ClipperChain(shrunk).union_(grown).union_ex()) == Approx(area(union_ex(offset(expolygons, d2)))));
+        REQUIRE(area(ClipperChain(grown).diff(shrunk).intersection(ClipperChain(expolygons)).union_ex()) ==
+                Approx(area(diff_ex(expolygons, offset(expolygons, - d1)))));
+    }
+}
+
+TEST_CASE("Benchmark ClipperChain", "[ClipperUtils][.benchmark]") {
+    // 20x20 copies of the test shapes, the chains of PerimeterGenerator collapsing the gaps and the infill area.
+    ExPolygons expolygons;
+    const ExPolygons shapes = make_chain_test_expolygons();
+    for (int row = 0; row < 20; ++ row)
+        for (int col = 0; col < 20; ++ col)
+            for (ExPolygon expolygon : shapes) {
+                expolygon.translate(scaled<coord_t>(60. * col), scaled<coord_t>(30. * row));
+                expolygons.emplace_back(std::move(expolygon));
+            }
+    const float min = scaled<float>(0.1);
+    const float max = scaled<float>(0.9);
+
+    BENCHMARK("gap collapse, free functions") {
+        return diff_ex(opening_ex(expolygons, min), offset2_ex(expolygons, - max, max + ClipperSafetyOffset)).size();
+    };
+    BENCHMARK("gap collapse, ClipperChain") {
+        return ClipperChain::offset(expolygons, - min).offset(min).diff_ex(ClipperChain::offset(expolygons, - max).offset(max + ClipperSafetyOffset)).size();
+    };
+    BENCHMARK("infill and no overlap infill, free functions") {
+        return offset2_ex(expolygons, - max, min).size() + offset2_ex(expolygons, - max, min - scaled<float>(0.05)).size();
+    };
+    BENCHMARK("infill and no overlap infill, ClipperChain") {
+        const ClipperChain shrunk = ClipperChain::offset(expolygons, - max);
+        return shrunk.offset_ex(min).size() + shrunk.offset_ex(min - scaled<float>(0.05)).size();
+    };
+}
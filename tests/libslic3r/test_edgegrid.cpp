@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/EdgeGrid.hpp"
+
+#include <random>
+
+using namespace Slic3r;
+
+// Star shaped polygons with many short edges and a hole, so that the grid cells hold a few dozens of edges.
+static Polygons make_stars(size_t num_stars, size_t num_points)
+{
+    Polygons out;
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> radius_dist(0.6, 1.);
+    for (size_t istar = 0; istar < num_stars; ++ istar) {
+        const Vec2d center(scaled<double>(30. * double(istar % 8)), scaled<double>(30. * double(istar / 8)));
+        Polygon contour, hole;
+        for (size_t i = 0; i < num_points; ++ i) {
+            const double angle = 2. * PI * double(i) / double(num_points);
+            const Vec2d  dir(cos(angle), sin(angle));
+            contour.points.emplace_back((center + dir * scaled<double>(12.) * radius_dist(rng)).cast<coord_t>());
+            hole.points.emplace_back((center + dir * scaled<double>(3.) * radius_dist(rng)).cast<coord_t>());
+        }
+        hole.reverse();
+        out.emplace_back(std::move(contour));
+        out.emplace_back(std::move(hole));
+    }
+    return out;
+}
+
+static Points random_points(const BoundingBox &bbox, size_t num_points)
+{
+    Points out;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<coord_t> x_dist(bbox.min.x(), bbox.max.x());
+    std::uniform_int_distribution<coord_t> y_dist(bbox.min.y(), bbox.max.y());
+    for (size_t i = 0; i < num_points; ++ i)
+        out.emplace_back(x_dist(rng), y_dist(rng));
+    return out;
+}
+
+TEST_CASE("EdgeGrid batch queries match the single point queries", "[EdgeGrid]") {
+    const Polygons polygons = make_stars(16, 400);
+    const BoundingBox bbox = get_extents(polygons).inflated(scaled<coord_t>(1.));
+    EdgeGrid::Grid grid(bbox);
+    grid.create(polygons, scaled<coord_t>(2.));
+
+    const Points pts = random_points(grid.bbox().inflated(- scaled<coord_t>(0.1)), 20000);
+
+    const coord_t search_radius = scaled<coord_t>(1.5);
+    auto check = [&]() {
+        std::vector<EdgeGrid::Grid::ClosestPointResult> closest_points = grid.closest_points_signed_distance(pts, search_radius);
+        REQUIRE(closest_points.size() == pts.size());
+        size_t num_valid = 0;
+        for (size_t i = 0; i < pts.size(); ++ i) {
+            EdgeGrid::Grid::ClosestPointResult expected = grid.closest_point_signed_distance(pts[i], search_radius);
+            REQUIRE(closest_points[i].contour_idx == expected.contour_idx);
+            REQUIRE(closest_points[i].start_point_idx == expected.start_point_idx);
+            REQUIRE(closest_points[i].distance == expected.distance);
+            REQUIRE(closest_points[i].t == expected.t);
+            num_valid += expected.valid();
+        }
+        REQUIRE(num_valid > 0);
+    };
+
+    SECTION("Without the batch query data") {
+        REQUIRE(! grid.has_batch_query_data());
+        check();
+    }
+    SECTION("With the batch query data") {
+        grid.create_batch_query_data();
+        REQUIRE(grid.has_batch_query_data());
+        check();
+    }
+}
+
+TEST_CASE("Benchmark EdgeGrid batch queries", "[EdgeGrid][.benchmark]") {
+    const Polygons polygons = make_stars(64, 4000);
+    const BoundingBox bbox = get_extents(polygons).inflated(scaled<coord_t>(1.));
+    EdgeGrid::Grid grid(bbox);
+    grid.create(polygons, scaled<coord_t>(2.));
+    const Points pts = random_points(grid.bbox().inflated(- scaled<coord_t>(0.1)), 100000);
+    const coord_t search_radius = scaled<coord_t>(1.5);
+
+    BENCHMARK("closest_point_signed_distance") {
+        size_t num_valid = 0;
+        for (const Point &pt : pts)
+            num_valid += grid.closest_point_signed_distance(pt, search_radius).valid();
+        return num_valid;
+    };
+
+    grid.create_batch_query_data();
+    BENCHMARK("closest_points_signed_distance") {
+        return grid.closest_points_signed_distance(pts, search_radius).size();
+    };
+
+    // As create_boundary_infill_graph() does: snap the end points of the infill lines to the boundary,
+    // which they lie on, with a tiny search radius. The grid is built for each query, thus the time
+    // to build the batch query data is included.
+    const Polygons infill_boundary = make_stars(64, 400);
+    const BoundingBox infill_bbox = get_extents(infill_boundary).inflated(SCALED_EPSILON);
+    Points end_points;
+    for (const Polygon &polygon : infill_boundary)
+        for (size_t i = 0; i < polygon.size(); i += 2)
+            end_points.emplace_back(polygon.points[i]);
+    BENCHMARK("infill end points, single queries") {
+        EdgeGrid::Grid grid;
+        grid.set_bbox(infill_bbox);
+        grid.create(infill_boundary, scaled<coord_t>(10.));
+        size_t num_valid = 0;
+        for (const Point &pt : end_points)
+            num_valid += grid.closest_point_signed_distance(pt, coord_t(SCALED_EPSILON)).valid();
+        return num_valid;
+    };
+    BENCHMARK("infill end points, batch query") {
+        EdgeGrid::Grid grid;
+        grid.set_bbox(infill_bbox);
+        grid.create(infill_boundary, scaled<coord_t>(10.));
+        grid.create_batch_query_data();
+        return grid.closest_points_signed_distance(end_points, coord_t(SCALED_EPSILON)).size();
+    };
+}
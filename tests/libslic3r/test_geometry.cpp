@@ -17,6 +17,7 @@
 
 #include "../libnest2d/printer_parts.hpp"
 
+#include <random>
 #include <unordered_set>
 
 using namespace Slic3r;
@@ -357,6 +358,124 @@ SCENARIO("Path chaining", "[Geometry]") {
 	}
 }
 
+// Short segments of random directions scattered over a square, every seventh segment is not reversible.
+static ExtrusionEntitiesPtr random_extrusion_paths(size_t num_paths, coord_t size)
+{
+    ExtrusionEntitiesPtr out;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<coord_t> pos_dist(0, size);
+    std::uniform_int_distribution<coord_t> dir_dist(- scaled<coord_t>(2.), scaled<coord_t>(2.));
+    for (size_t i = 0; i < num_paths; ++ i) {
+        auto *path = new ExtrusionPath(erInternalInfill, 0.05, 0.45f, 0.2f);
+        const Point pt(pos_dist(rng), pos_dist(rng));
+        path->polyline.points = { pt, pt + Point(dir_dist(rng), dir_dist(rng) + 1) };
+        if (i % 7 == 0)
+            path->set_reverse();
+        out.emplace_back(path);
+    }
+    return out;
+}
+
+static double travel_length(const ExtrusionEntitiesPtr &entities, const std::vector<std::pair<size_t, bool>> &chain, const Point &start_near)
+{
+    double length = 0.;
+    Point  last   = start_near;
+    for (const std::pair<size_t, bool> &segment : chain) {
+        const ExtrusionEntity *ee = entities[segment.first];
+        length += ((segment.second ? ee->last_point() : ee->first_point()) - last).cast<double>().norm();
+        last = segment.second ? ee->first_point() : ee->last_point();
+    }
+    return length;
+}
+
+TEST_CASE("Chaining extrusion entities", "[Geometry]") {
+    ExtrusionEntitiesPtr entities = random_extrusion_paths(5000, scaled<coord_t>(100.));
+    const Point          start_near(0, 0);
+
+    auto check_chain = [&entities](const std::vector<std::pair<size_t, bool>> &chain) {
+        REQUIRE(chain.size() == entities.size());
+        std::vector<bool> visited(entities.size(), false);
+        for (const std::pair<size_t, bool> &segment : chain) {
+            REQUIRE(! visited[segment.first]);
+            visited[segment.first] = true;
+            REQUIRE((entities[segment.first]->can_reverse() || ! segment.second));
+        }
+    };
+
+    ChainingParams params;
+    const std::vector<std::pair<size_t, bool>> greedy = chain_extrusion_entities(entities, &start_near, params);
+    check_chain(greedy);
+    params.spatial_grid = true;
+    const std::vector<std::pair<size_t, bool>> grid = chain_extrusion_entities(entities, &start_near, params);
+    check_chain(grid);
+    // The nearest neighbour starts with the segment closest to start_near.
+    double dist_min = std::numeric_limits<double>::max();
+    for (const ExtrusionEntity *ee : entities) {
+        dist_min = std::min(dist_min, ee->first_point().cast<double>().norm());
+        if (ee->can_reverse())
+            dist_min = std::min(dist_min, ee->last_point().cast<double>().norm());
+    }
+    REQUIRE(travel_length(entities, { grid.front() }, start_near) == Approx(dist_min));
+    // Nearest neighbour travels are longer than the greedy ones, but not by much on uniformly distributed segments.
+    REQUIRE(travel_length(entities, grid, start_near) < 1.5 * travel_length(entities, greedy, start_near));
+
+    params.improve_passes = 100;
+    const std::vector<std::pair<size_t, bool>> grid_improved = chain_extrusion_entities(entities, &start_near, params);
+    check_chain(grid_improved);
+    REQUIRE(travel_length(entities, grid_improved, start_near) < travel_length(entities, grid, start_near));
+    // The improvement is bounded by the number of passes, not by time, thus it is reproducible.
+    REQUIRE(chain_extrusion_entities(entities, &start_near, params) == grid_improved);
+    params.improve_passes = 1;
+    REQUIRE(travel_length(entities, chain_extrusion_entities(entities, &start_near, params), start_near) >= travel_length(entities, grid_improved, start_near));
+
+    SECTION("Segments along a long thin strip") {
+        // The grid over a 1m long strip shall not allocate cells along the whole strip at the spacing of the end points.
+        ExtrusionEntitiesPtr strip;
+        for (size_t i = 0; i < 200; ++ i) {
+            auto *path = new ExtrusionPath(erInternalInfill, 0.05, 0.45f, 0.2f);
+            const coord_t x = scaled<coord_t>(5. * double((i * 7) % 200));
+            path->polyline.points = { Point(x, 0), Point(x + scaled<coord_t>(1.), 0) };
+            strip.emplace_back(path);
+        }
+        const std::vector<std::pair<size_t, bool>> chain = chain_extrusion_entities(strip, &start_near, params);
+        REQUIRE(chain.size() == strip.size());
+        // Walking from the start along the strip.
+        REQUIRE(travel_length(strip, chain, start_near) == Approx(double(scaled<coord_t>(4.)) * 199.));
+        for (ExtrusionEntity *ee : strip)
+            delete ee;
+    }
+    SECTION("Single and no entity") {
+        ExtrusionEntitiesPtr single { entities.front() };
+        REQUIRE(chain_extrusion_entities(single, &start_near, params).size() == 1);
+        ExtrusionEntitiesPtr empty;
+        REQUIRE(chain_extrusion_entities(empty, &start_near, params).empty());
+    }
+
+    for (ExtrusionEntity *ee : entities)
+        delete ee;
+}
+
+TEST_CASE("Benchmark chaining extrusion entities", "[Geometry][.benchmark]") {
+    ExtrusionEntitiesPtr entities = random_extrusion_paths(10000, scaled<coord_t>(100.));
+    const Point          start_near(0, 0);
+
+    ChainingParams params;
+    BENCHMARK("greedy") {
+        return travel_length(entities, chain_extrusion_entities(entities, &start_near, params), start_near);
+    };
+    params.spatial_grid = true;
+    BENCHMARK("spatial grid") {
+        return travel_length(entities, chain_extrusion_entities(entities, &start_near, params), start_near);
+    };
+    params.improve_passes = 3;
+    BENCHMARK("spatial grid, 3 passes of 2-opt") {
+        return travel_length(entities, chain_extrusion_entities(entities, &start_near, params), start_near);
+    };
+
+    for (ExtrusionEntity *ee : entities)
+        delete ee;
+}
+
 SCENARIO("Line distances", "[Geometry]"){
     GIVEN("A line"){
         Line line(Point(0, 0), Point(20, 0));
@@ -19,3 +19,39 @@ TEST_CASE("Hollow two overlapping spheres") {
     sphere1.WriteOBJFile("twospheres.obj");
 }
 
+
+TEST_CASE("Hollowing lowers the quality to fit into the memory budget") {
+    using namespace Slic3r;
+
+    TriangleMesh sphere1 = make_sphere(20., 2 * PI / 40.), sphere2 = sphere1;
+
+    sphere1.translate(-10.f, 0.f, 0.f);
+    sphere2.translate( 10.f, 0.f, 10.f);
+
+    sphere1.merge(sphere2);
+
+    sla::HollowingConfig cfg;
+    cfg.quality = 1.;
+    REQUIRE(cfg.max_memory_mb == 0.);
+    sla::InteriorPtr interior = sla::generate_interior(sphere1, cfg);
+    REQUIRE(interior);
+
+    // A budget too small for the requested quality.
+    cfg.max_memory_mb = 1.;
+    sla::InteriorPtr interior_coarse = sla::generate_interior(sphere1, cfg);
+    REQUIRE(interior_coarse);
+
+    const indexed_triangle_set &its        = sla::get_mesh(*interior);
+    const indexed_triangle_set &its_coarse = sla::get_mesh(*interior_coarse);
+    REQUIRE(! its_coarse.empty());
+    CHECK(its_coarse.indices.size() < its.indices.size());
+    CHECK(its_num_open_edges(its_coarse) == 0);
+    CHECK(std::abs(its_volume(its_coarse)) == Approx(std::abs(its_volume(its))).epsilon(0.05));
+
+    // Not coarser than the lowest quality, even if that does not fit.
+    cfg.quality       = 0.;
+    cfg.max_memory_mb = 0.;
+    sla::InteriorPtr interior_lowest = sla::generate_interior(sphere1, cfg);
+    REQUIRE(interior_lowest);
+    CHECK(its_coarse.indices.size() == sla::get_mesh(*interior_lowest).indices.size());
+}
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <catch2/catch.hpp>
 
 #include "libslic3r/TriangleMesh.hpp"
@@ -291,6 +293,85 @@ bool exist_triangle_with_twice_vertices(const std::vector<stl_triangle_vertex_in
     return false;
 }
 
+// Split each triangle into four by its edge midpoints, num_iterations times, to get a finer mesh of the same shape.
+static indexed_triangle_set its_subdivide(indexed_triangle_set its, int num_iterations)
+{
+    for (int iter = 0; iter < num_iterations; ++ iter) {
+        std::map<std::pair<int, int>, int> midpoints;
+        auto midpoint = [&its, &midpoints](int a, int b) {
+            auto [it, inserted] = midpoints.insert({ { std::min(a, b), std::max(a, b) }, int(its.vertices.size()) });
+            if (inserted)
+                its.vertices.emplace_back(0.5f * (its.vertices[a] + its.vertices[b]));
+            return it->second;
+        };
+        std::vector<stl_triangle_vertex_indices> indices;
+        indices.reserve(its.indices.size() * 4);
+        for (const stl_triangle_vertex_indices &t : its.indices) {
+            const int m01 = midpoint(t[0], t[1]);
+            const int m12 = midpoint(t[1], t[2]);
+            const int m20 = midpoint(t[2], t[0]);
+            indices.emplace_back(t[0], m01, m20);
+            indices.emplace_back(m01, t[1], m12);
+            indices.emplace_back(m20, m12, t[2]);
+            indices.emplace_back(m01, m12, m20);
+        }
+        its.indices = std::move(indices);
+    }
+    return its;
+}
+
+TEST_CASE("Simplify mesh by partitioned Quadric edge collapse", "[its]")
+{
+    TriangleMesh mesh = load_model("frog_legs.obj");
+    REQUIRE_FALSE(mesh.empty());
+    // Enough triangles to be simplified in multiple clusters.
+    const indexed_triangle_set subdivided = its_subdivide(mesh.its, 2);
+    uint32_t wanted_count = mesh.its.indices.size() * 0.05;
+
+    indexed_triangle_set serial = subdivided; // copy
+    its_quadric_edge_collapse(serial, wanted_count);
+    indexed_triangle_set its = subdivided; // copy
+    float max_error = std::numeric_limits<float>::max();
+    std::mutex       status_mutex;
+    std::vector<int> statuses;
+    auto statusfn = [&status_mutex, &statuses](int percent) {
+        std::lock_guard<std::mutex> lk(status_mutex);
+        statuses.emplace_back(percent);
+    };
+    its_quadric_edge_collapse(its, wanted_count, &max_error, nullptr, statusfn, QuadricEdgeCollapseMode::Partitioned);
+    CHECK(its.indices.size() <= wanted_count);
+    // The clusters report the progress up to 70% while they are simplified, not only once they are all done.
+    CHECK(std::count_if(statuses.begin(), statuses.end(), [](int percent) { return percent > 0 && percent < 70; }) > 10);
+    CHECK(*std::max_element(statuses.begin(), statuses.end()) > 90);
+    CHECK(! exist_triangle_with_twice_vertices(its.indices));
+    // Simplified as well as by the serial Quadric edge collapse.
+    double serial_volume = its_volume(serial);
+    CHECK(fabs(serial_volume - its_volume(its)) < 0.01 * serial_volume);
+
+    CompareConfig cfg;
+    cfg.max_average_distance = 0.05f;
+    cfg.max_distance         = 0.5f;
+
+    CHECK(is_similar(mesh.its, its, cfg));
+    CHECK(is_similar(its, mesh.its, cfg));
+}
+
+TEST_CASE("Benchmark Quadric edge collapse", "[its][.benchmark]")
+{
+    for (const auto &[obj_filename, num_subdivisions] : { std::make_pair("simplification.obj", 8), std::make_pair("frog_legs.obj", 3) }) {
+        TriangleMesh mesh = load_model(obj_filename);
+        REQUIRE_FALSE(mesh.empty());
+        const indexed_triangle_set its = its_subdivide(mesh.its, num_subdivisions);
+        const auto wanted_count = uint32_t(its.indices.size() / 50);
+        for (QuadricEdgeCollapseMode mode : { QuadricEdgeCollapseMode::Serial, QuadricEdgeCollapseMode::Partitioned })
+            BENCHMARK(std::string(obj_filename) + (mode == QuadricEdgeCollapseMode::Serial ? ", serial" : ", partitioned")) {
+                indexed_triangle_set simplified = its;
+                its_quadric_edge_collapse(simplified, wanted_count, nullptr, nullptr, nullptr, mode);
+                return simplified.indices.size();
+            };
+    }
+}
+
 TEST_CASE("Simplify trouble case", "[its]")
 {
     TriangleMesh tm = load_model("simplification.obj");
@@ -3,6 +3,7 @@
 
 #include <libslic3r/TriangleMesh.hpp>
 #include <libslic3r/MeshBoolean.hpp>
+#include <libslic3r/CSGMesh/PerformCSGMeshBooleans.hpp>
 
 using namespace Slic3r;
 
@@ -23,3 +24,73 @@ TEST_CASE("CGAL and TriangleMesh conversions", "[MeshBoolean]") {
     
     REQUIRE(! MeshBoolean::cgal::does_self_intersect(M));
 }
+
+TEST_CASE("CSG mesh booleans subtract a batch of negative parts", "[MeshBoolean]") {
+    TriangleMesh cube = make_cube(20., 20., 20.);
+
+    // Overlapping and separate negative parts.
+    std::vector<TriangleMesh> negatives;
+    for (const Vec3d &center : { Vec3d(0., 0., 0.), Vec3d(2., 0., 0.), Vec3d(10., 10., 20.), Vec3d(20., 20., 5.), Vec3d(10., 0., 10.) }) {
+        TriangleMesh sphere = make_sphere(3., 2. * PI / 45.);
+        sphere.translate(center.cast<float>());
+        negatives.emplace_back(std::move(sphere));
+    }
+
+    std::vector<csg::CSGPart> csgmesh;
+    csgmesh.emplace_back(&cube.its, csg::CSGType::Union);
+    for (const TriangleMesh &negative : negatives)
+        csgmesh.emplace_back(&negative.its, csg::CSGType::Difference);
+    auto csgrange = range(csgmesh);
+
+    std::vector<MeshBoolean::cgal::CGALMeshPtr> cgalmeshes;
+    REQUIRE(std::get<2>(csg::check_csgmesh_booleans(csgrange, [](auto &) {}, cgalmeshes)) == csgrange.end());
+    MeshBoolean::cgal::CGALMeshPtr cgalm = csg::perform_csgmesh_booleans(csgrange, std::move(cgalmeshes));
+    REQUIRE(cgalm);
+    TriangleMesh result = MeshBoolean::cgal::cgal_to_triangle_mesh(*cgalm);
+
+    // Subtract the negative parts one by one.
+    TriangleMesh expected = cube;
+    for (const TriangleMesh &negative : negatives)
+        MeshBoolean::cgal::minus(expected, negative);
+
+    REQUIRE(! result.empty());
+    REQUIRE(result.volume() == Approx(expected.volume()));
+    REQUIRE(! MeshBoolean::cgal::does_self_intersect(result));
+}
+
+TEST_CASE("CSG mesh booleans with mcut apply the negative parts one by one", "[MeshBoolean]") {
+    TriangleMesh cube = make_cube(20., 20., 20.);
+
+    // A slab splitting the cube into two, followed by a sphere centered at the outer face of each half,
+    // which are cut from the halves separately.
+    std::vector<TriangleMesh> negatives;
+    negatives.emplace_back(make_cube(30., 30., 2.));
+    negatives.back().translate(-5.f, -5.f, 9.f);
+    for (const Vec3d &center : { Vec3d(10., 10., 0.), Vec3d(10., 10., 20.) }) {
+        TriangleMesh sphere = make_sphere(3., 2. * PI / 45.);
+        sphere.translate(center.cast<float>());
+        negatives.emplace_back(std::move(sphere));
+    }
+
+    std::vector<csg::CSGPart> csgmesh;
+    csgmesh.emplace_back(&cube.its, csg::CSGType::Union);
+    for (const TriangleMesh &negative : negatives)
+        csgmesh.emplace_back(&negative.its, csg::CSGType::Difference);
+    auto csgrange = range(csgmesh);
+
+    MeshBoolean::mcut::McutMeshPtr mcutm;
+    csg::perform_csgmesh_booleans_mcut(mcutm, csgrange);
+    REQUIRE(mcutm);
+    TriangleMesh result = MeshBoolean::mcut::mcut_to_triangle_mesh(*mcutm);
+
+    // Subtract the negative parts one by one.
+    MeshBoolean::mcut::McutMeshPtr expected = MeshBoolean::mcut::triangle_mesh_to_mcut(cube.its);
+    for (const TriangleMesh &negative : negatives)
+        MeshBoolean::mcut::do_boolean(*expected, *MeshBoolean::mcut::triangle_mesh_to_mcut(negative.its), "A_NOT_B");
+
+    REQUIRE(! result.empty());
+    REQUIRE(its_split(result.its).size() == 2);
+    REQUIRE(result.volume() == Approx(MeshBoolean::mcut::mcut_to_triangle_mesh(*expected).volume()));
+    // Half of each sphere was cut out of the halves.
+    REQUIRE(result.volume() == Approx(20. * 20. * 18. - 0.5 * (negatives[1].volume() + negatives[2].volume())).epsilon(1e-3));
+}
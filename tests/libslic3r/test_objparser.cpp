@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/Format/objparser.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
+using namespace ObjParser;
+
+static std::string read_obj_with_line_ends(const char *name, const char *eol)
+{
+    boost::nowide::ifstream ifs(std::string(TEST_DATA_DIR) + "/" + name);
+    REQUIRE(ifs.good());
+    std::string out;
+    for (std::string line; std::getline(ifs, line);) {
+        if (! line.empty() && line.back() == '\r')
+            line.pop_back();
+        out += line + eol;
+    }
+    return out;
+}
+
+TEST_CASE("OBJ file read in blocks matches the OBJ stream", "[objparser]") {
+    for (const char *eol : { "\n", "\r\n", "\r" }) {
+        SECTION(eol[0] == '\n' ? "LF" : eol[1] == '\n' ? "CRLF" : "CR") {
+            // The last line is not terminated and it is ignored by both parsers.
+            std::string obj = read_obj_with_line_ends("extruder_idler_quads.obj", eol) + "v 1 2 3";
+
+            boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.obj");
+            {
+                boost::nowide::ofstream ofs(path.string(), std::ios::out | std::ios::binary);
+                ofs << obj;
+            }
+
+            ObjData expected;
+            std::istringstream stream(obj);
+            REQUIRE(objparse(stream, expected));
+            REQUIRE(! expected.vertices.empty());
+
+            // Block sizes cutting the lines and the line ends everywhere, and the default one holding the whole file.
+            for (size_t chunk_size : { size_t(1), size_t(7), size_t(64), size_t(4096), size_t(4 * 1024 * 1024) }) {
+                ObjData data;
+                REQUIRE(objparse(path.string().c_str(), data, chunk_size));
+                CHECK(objequal(data, expected));
+            }
+            boost::filesystem::remove(path);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 #include "libslic3r/Model.hpp"
 #include "libslic3r/Format/STL.hpp"
 
+#include <boost/filesystem.hpp>
+
 using namespace Slic3r;
 
 static inline std::string stl_path(const char* path)
@@ -55,3 +57,33 @@ SCENARIO("Reading an STL file", "[stl]") {
 		}
 	}
 }
+
+TEST_CASE("Binary STL read back", "[stl]") {
+	indexed_triangle_set sphere = its_make_sphere(10., 2. * PI / 60.);
+	boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-sphere.stl");
+	REQUIRE(its_write_stl_binary(path.string().c_str(), "", sphere));
+
+	Slic3r::Model model;
+	REQUIRE(Slic3r::load_stl(path.string().c_str(), &model));
+	const indexed_triangle_set &its = model.objects.front()->volumes.front()->mesh().its;
+	boost::filesystem::remove(path);
+
+	REQUIRE(its.indices.size() == sphere.indices.size());
+	REQUIRE(its.vertices.size() == sphere.vertices.size());
+	REQUIRE(is_approx(model.objects.front()->volumes.front()->mesh().size(), Vec3d(20, 20, 20), 1e-3));
+}
+
+TEST_CASE("Benchmark loading a binary STL with millions of facets", "[stl][.benchmark]") {
+	// About 5M facets.
+	indexed_triangle_set sphere = its_make_sphere(50., 2. * PI / 2200.);
+	boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-big_sphere.stl");
+	REQUIRE(its_write_stl_binary(path.string().c_str(), "", sphere));
+
+	BENCHMARK("load_stl") {
+		Slic3r::Model model;
+		load_stl(path.string().c_str(), &model);
+		return model.objects.size();
+	};
+
+	boost::filesystem::remove(path);
+}